@@ -0,0 +1,272 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <bw_rand.h>
+
+#define BENCH_MAX_CHANNELS	32
+#define BENCH_MAX_BLOCK		1024
+#define BENCH_N_BUFFERS		4
+
+typedef enum {
+	bench_api_process,
+	bench_api_process_multi,
+	bench_api_cpp
+} bench_api;
+
+typedef enum {
+	bench_params_static,
+	bench_params_modulated
+} bench_params;
+
+// Buffers shared by all benchmarks. Inputs are:
+//  * x[0]: white noise in [-1, 1] (main audio input);
+//  * x[1]: white noise in [-1, 1] (sidechain/carrier/right/wet input);
+//  * x[2]: 440 Hz phase ramp in [0, 1) (oscillator phase input);
+//  * x[3]: 440 Hz phase increment (oscillator phase increment input).
+typedef struct {
+	float		x[BENCH_N_BUFFERS][BENCH_MAX_CHANNELS][BENCH_MAX_BLOCK];
+	float		y[BENCH_N_BUFFERS][BENCH_MAX_CHANNELS][BENCH_MAX_BLOCK];
+	char		gate[BENCH_MAX_CHANNELS];
+	const float *	xp[BENCH_N_BUFFERS][BENCH_MAX_CHANNELS];
+	float *		yp[BENCH_N_BUFFERS][BENCH_MAX_CHANNELS];
+} bench_buffers;
+
+typedef struct {
+	const char *	module;
+	bench_api	api;
+	bench_params	params;
+	size_t		n_channels;
+	size_t		block_size;
+	size_t		n_iterations;
+	double		ns_per_sample;
+} bench_result;
+
+typedef enum {
+	bench_format_csv,
+	bench_format_json
+} bench_format;
+
+typedef struct {
+	float		sample_rate;
+	size_t		target_samples;
+	const char *	module_filter;
+	bench_format	format;
+	FILE *		out;
+	size_t		n_results;
+} bench_opts;
+
+static const size_t bench_block_sizes[] = { 1, 8, 32, 128, 1024 };
+#define BENCH_N_BLOCK_SIZES	(sizeof(bench_block_sizes) / sizeof(bench_block_sizes[0]))
+
+static bench_buffers bench_bufs;
+static bench_opts bench_options;
+
+static inline double bench_now_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return 1e9 * (double)ts.tv_sec + (double)ts.tv_nsec;
+}
+
+static inline const char * bench_api_name(bench_api api) {
+	switch (api) {
+	case bench_api_process:
+		return "process";
+	case bench_api_process_multi:
+		return "process_multi";
+	default:
+		return "cpp";
+	}
+}
+
+static inline const char * bench_params_name(bench_params params) {
+	return params == bench_params_static ? "static" : "modulated";
+}
+
+// Triangle sweep in [0, 1] over 128 iterations, used to drive modulated
+// parameters.
+static inline float bench_mod_value(size_t i) {
+	const size_t k = i & 127;
+	return (float)(k < 64 ? k : 127 - k) * (1.f / 63.f);
+}
+
+static inline void bench_buffers_init(float sample_rate) {
+	uint64_t rand_state = 0xbaddecaf;
+	const float inc = 440.f / sample_rate;
+	for (size_t j = 0; j < BENCH_MAX_CHANNELS; j++) {
+		float phase = 0.f;
+		for (size_t i = 0; i < BENCH_MAX_BLOCK; i++) {
+			bench_bufs.x[0][j][i] = bw_randf(&rand_state);
+			bench_bufs.x[1][j][i] = bw_randf(&rand_state);
+			bench_bufs.x[2][j][i] = phase;
+			bench_bufs.x[3][j][i] = inc;
+			phase += inc;
+			if (phase >= 1.f)
+				phase -= 1.f;
+		}
+		bench_bufs.gate[j] = 1;
+		for (size_t k = 0; k < BENCH_N_BUFFERS; k++) {
+			bench_bufs.xp[k][j] = bench_bufs.x[k][j];
+			bench_bufs.yp[k][j] = bench_bufs.y[k][j];
+		}
+	}
+}
+
+static inline void bench_output_begin() {
+	if (bench_options.format == bench_format_csv)
+		fprintf(bench_options.out, "module,api,params,n_channels,block_size,n_iterations,ns_per_sample\n");
+	else
+		fprintf(bench_options.out, "[\n");
+}
+
+static inline void bench_output_result(const bench_result *r) {
+	if (bench_options.format == bench_format_csv)
+		fprintf(bench_options.out, "%s,%s,%s,%zu,%zu,%zu,%.4f\n",
+			r->module, bench_api_name(r->api), bench_params_name(r->params),
+			r->n_channels, r->block_size, r->n_iterations, r->ns_per_sample);
+	else
+		fprintf(bench_options.out, "%s\t{ \"module\": \"%s\", \"api\": \"%s\", \"params\": \"%s\", \"n_channels\": %zu, \"block_size\": %zu, \"n_iterations\": %zu, \"ns_per_sample\": %.4f }",
+			bench_options.n_results ? ",\n" : "",
+			r->module, bench_api_name(r->api), bench_params_name(r->params),
+			r->n_channels, r->block_size, r->n_iterations, r->ns_per_sample);
+	bench_options.n_results++;
+	fflush(bench_options.out);
+}
+
+static inline void bench_output_end() {
+	if (bench_options.format == bench_format_json)
+		fprintf(bench_options.out, "\n]\n");
+}
+
+// Each benchmark is a class template B<N_CHANNELS> exposing:
+//  * enum { hasParams } - whether it has a continuously modulable parameter;
+//  * void setup(bench_api api, float sampleRate) - init, set sample rate and
+//    reset the instance(s) used by api;
+//  * void modulate(bench_api api, float p) - set the modulated parameter
+//    according to p in [0, 1];
+//  * void process(bench_api api, bench_buffers *b, size_t n) - process n
+//    samples of all channels.
+// Objects are heap-allocated and destroyed after each measurement, so that
+// setup() may allocate memory and the destructor may free it.
+
+template<template<size_t> class B, size_t N_CHANNELS>
+static void bench_run(
+		const char * module,
+		bench_api    api,
+		bench_params params,
+		size_t       block_size) {
+	B<N_CHANNELS> *b = new B<N_CHANNELS>();
+	b->setup(api, bench_options.sample_rate);
+
+	size_t n_iter = bench_options.target_samples / (block_size * N_CHANNELS);
+	if (n_iter == 0)
+		n_iter = 1;
+	const size_t n_warmup = n_iter / 8 + 1;
+
+	if (params == bench_params_static) {
+		b->modulate(api, 0.5f);
+		for (size_t i = 0; i < n_warmup; i++)
+			b->process(api, &bench_bufs, block_size);
+		const double t0 = bench_now_ns();
+		for (size_t i = 0; i < n_iter; i++)
+			b->process(api, &bench_bufs, block_size);
+		const double t1 = bench_now_ns();
+		bench_result r = { module, api, params, N_CHANNELS, block_size, n_iter, (t1 - t0) / ((double)n_iter * block_size * N_CHANNELS) };
+		bench_output_result(&r);
+	} else {
+		for (size_t i = 0; i < n_warmup; i++) {
+			b->modulate(api, bench_mod_value(i));
+			b->process(api, &bench_bufs, block_size);
+		}
+		const double t0 = bench_now_ns();
+		for (size_t i = 0; i < n_iter; i++) {
+			b->modulate(api, bench_mod_value(i));
+			b->process(api, &bench_bufs, block_size);
+		}
+		const double t1 = bench_now_ns();
+		bench_result r = { module, api, params, N_CHANNELS, block_size, n_iter, (t1 - t0) / ((double)n_iter * block_size * N_CHANNELS) };
+		bench_output_result(&r);
+	}
+
+	delete b;
+}
+
+template<template<size_t> class B>
+static void bench_module(
+		const char * module) {
+	if (bench_options.module_filter != NULL && strcmp(bench_options.module_filter, module) != 0)
+		return;
+	fprintf(stderr, "%s\n", module);
+	const int n_params = B<1>::hasParams ? 2 : 1;
+	for (int a = bench_api_process; a <= bench_api_cpp; a++)
+		for (int p = 0; p < n_params; p++)
+			for (size_t k = 0; k < BENCH_N_BLOCK_SIZES; k++) {
+				const bench_api api = (bench_api)a;
+				const bench_params params = (bench_params)p;
+				const size_t block_size = bench_block_sizes[k];
+				bench_run<B, 1>(module, api, params, block_size);
+				bench_run<B, 2>(module, api, params, block_size);
+				bench_run<B, 8>(module, api, params, block_size);
+				bench_run<B, 32>(module, api, params, block_size);
+			}
+}
+
+static inline int bench_parse_args(
+		int     argc,
+		char ** argv) {
+	bench_options.sample_rate = 48e3f;
+	bench_options.target_samples = 1 << 17;
+	bench_options.module_filter = NULL;
+	bench_options.format = bench_format_csv;
+	bench_options.out = stdout;
+	bench_options.n_results = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+			i++;
+			if (strcmp(argv[i], "csv") == 0)
+				bench_options.format = bench_format_csv;
+			else if (strcmp(argv[i], "json") == 0)
+				bench_options.format = bench_format_json;
+			else {
+				fprintf(stderr, "unknown format %s\n", argv[i]);
+				return 0;
+			}
+		} else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+			i++;
+			bench_options.out = fopen(argv[i], "w");
+			if (bench_options.out == NULL) {
+				fprintf(stderr, "could not open %s\n", argv[i]);
+				return 0;
+			}
+		} else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+			i++;
+			bench_options.module_filter = argv[i];
+		} else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+			i++;
+			bench_options.target_samples = (size_t)strtoul(argv[i], NULL, 10);
+			if (bench_options.target_samples == 0) {
+				fprintf(stderr, "invalid target sample count %s\n", argv[i]);
+				return 0;
+			}
+		} else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+			i++;
+			bench_options.sample_rate = strtof(argv[i], NULL);
+			if (!(bench_options.sample_rate > 0.f)) {
+				fprintf(stderr, "invalid sample rate %s\n", argv[i]);
+				return 0;
+			}
+		} else {
+			fprintf(stderr, "usage: %s [-f csv|json] [-o file] [-m module] [-n target_samples] [-r sample_rate]\n", argv[0]);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+#endif
@@ -0,0 +1,966 @@
+#include "bench.h"
+
+#include <bw_ap1.h>
+#include <bw_ap2.h>
+#include <bw_balance.h>
+#include <bw_bd_reduce.h>
+#include <bw_cab.h>
+#include <bw_chorus.h>
+#include <bw_clip.h>
+#include <bw_comb.h>
+#include <bw_comp.h>
+#include <bw_delay.h>
+#include <bw_dist.h>
+#include <bw_drive.h>
+#include <bw_dry_wet.h>
+#include <bw_ensemble.h>
+#include <bw_env_follow.h>
+#include <bw_env_gen.h>
+#include <bw_fuzz.h>
+#include <bw_gain.h>
+#include <bw_hp1.h>
+#include <bw_hs1.h>
+#include <bw_hs2.h>
+#include <bw_lp1.h>
+#include <bw_ls1.h>
+#include <bw_ls2.h>
+#include <bw_mm1.h>
+#include <bw_mm2.h>
+#include <bw_noise_gate.h>
+#include <bw_noise_gen.h>
+#include <bw_notch.h>
+#include <bw_one_pole.h>
+#include <bw_osc_filt.h>
+#include <bw_osc_pulse.h>
+#include <bw_osc_saw.h>
+#include <bw_osc_sin.h>
+#include <bw_osc_tri.h>
+#include <bw_pan.h>
+#include <bw_peak.h>
+#include <bw_phase_gen.h>
+#include <bw_phaser.h>
+#include <bw_pink_filt.h>
+#include <bw_ppm.h>
+#include <bw_reverb.h>
+#include <bw_ring_mod.h>
+#include <bw_satur.h>
+#include <bw_slew_lim.h>
+#include <bw_sr_reduce.h>
+#include <bw_src.h>
+#include <bw_src_int.h>
+#include <bw_svf.h>
+#include <bw_trem.h>
+#include <bw_voice_bank.h>
+#include <bw_wah.h>
+
+// In all of the following, bench_api_process uses one coeffs per channel and
+// calls *_process() on each, bench_api_process_multi uses one shared coeffs
+// and calls *_process_multi(), and bench_api_cpp uses the C++ API.
+//
+// C_MOD/CPP_MOD are statements that set the modulated parameter according to p
+// in [0, 1] on coeffs c and on C++ object o, respectively.
+
+#define BENCH_N_COEFFS(api)	((api) == bench_api_process ? N_CHANNELS : 1)
+#define BENCH_COEFFS(api, i)	(coeffs + ((api) == bench_api_process ? (i) : 0))
+
+// coeffs + state, x -> y
+#define BENCH_CS(id, Cls, HAS_PARAMS, C_MOD, CPP_MOD) \
+template<size_t N_CHANNELS> \
+struct bench_##id { \
+	enum { hasParams = HAS_PARAMS }; \
+	bw_##id##_coeffs		coeffs[N_CHANNELS]; \
+	bw_##id##_state			states[N_CHANNELS]; \
+	bw_##id##_state *		statesP[N_CHANNELS]; \
+	Brickworks::Cls<N_CHANNELS>	cpp; \
+	void setup(bench_api api, float fs) { \
+		if (api == bench_api_cpp) { \
+			cpp.setSampleRate(fs); \
+			cpp.reset(); \
+			return; \
+		} \
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+			bw_##id##_init(coeffs + i); \
+			bw_##id##_set_sample_rate(coeffs + i, fs); \
+			bw_##id##_reset_coeffs(coeffs + i); \
+		} \
+		for (size_t i = 0; i < N_CHANNELS; i++) { \
+			statesP[i] = states + i; \
+			bw_##id##_reset_state(BENCH_COEFFS(api, i), states + i, 0.f); \
+		} \
+	} \
+	void modulate(bench_api api, float p) { \
+		(void)p; \
+		if (api == bench_api_cpp) { \
+			Brickworks::Cls<N_CHANNELS> *o = &cpp; \
+			(void)o; \
+			CPP_MOD; \
+		} else \
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+				bw_##id##_coeffs *c = coeffs + i; \
+				(void)c; \
+				C_MOD; \
+			} \
+	} \
+	void process(bench_api api, bench_buffers *b, size_t n) { \
+		if (api == bench_api_process) \
+			for (size_t i = 0; i < N_CHANNELS; i++) \
+				bw_##id##_process(coeffs + i, states + i, b->xp[0][i], b->yp[0][i], n); \
+		else if (api == bench_api_process_multi) \
+			bw_##id##_process_multi(coeffs, statesP, b->xp[0], b->yp[0], N_CHANNELS, n); \
+		else \
+			cpp.process(b->xp[0], b->yp[0], n); \
+	} \
+};
+
+// coeffs + state + external memory (delay lines), x -> y
+#define BENCH_CS_MEM(id, Cls, C_MOD, CPP_MOD) \
+template<size_t N_CHANNELS> \
+struct bench_##id { \
+	enum { hasParams = 1 }; \
+	bw_##id##_coeffs		coeffs[N_CHANNELS]; \
+	bw_##id##_state			states[N_CHANNELS]; \
+	bw_##id##_state *		statesP[N_CHANNELS]; \
+	void *				mem[N_CHANNELS]; \
+	Brickworks::Cls<N_CHANNELS>	cpp; \
+	bench_##id() { \
+		for (size_t i = 0; i < N_CHANNELS; i++) \
+			mem[i] = NULL; \
+	} \
+	~bench_##id() { \
+		for (size_t i = 0; i < N_CHANNELS; i++) \
+			free(mem[i]); \
+	} \
+	void setup(bench_api api, float fs) { \
+		if (api == bench_api_cpp) { \
+			cpp.setSampleRate(fs); \
+			cpp.reset(); \
+			return; \
+		} \
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+			bw_##id##_init(coeffs + i, 1.f); \
+			bw_##id##_set_sample_rate(coeffs + i, fs); \
+			bw_##id##_reset_coeffs(coeffs + i); \
+		} \
+		for (size_t i = 0; i < N_CHANNELS; i++) { \
+			statesP[i] = states + i; \
+			mem[i] = malloc(bw_##id##_mem_req(BENCH_COEFFS(api, i))); \
+			bw_##id##_mem_set(BENCH_COEFFS(api, i), states + i, mem[i]); \
+			bw_##id##_reset_state(BENCH_COEFFS(api, i), states + i, 0.f); \
+		} \
+	} \
+	void modulate(bench_api api, float p) { \
+		if (api == bench_api_cpp) { \
+			Brickworks::Cls<N_CHANNELS> *o = &cpp; \
+			CPP_MOD; \
+		} else \
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+				bw_##id##_coeffs *c = coeffs + i; \
+				C_MOD; \
+			} \
+	} \
+	void process(bench_api api, bench_buffers *b, size_t n) { \
+		if (api == bench_api_process) \
+			for (size_t i = 0; i < N_CHANNELS; i++) \
+				bw_##id##_process(coeffs + i, states + i, b->xp[0][i], b->yp[0][i], n); \
+		else if (api == bench_api_process_multi) \
+			bw_##id##_process_multi(coeffs, statesP, b->xp[0], b->yp[0], N_CHANNELS, n); \
+		else \
+			cpp.process(b->xp[0], b->yp[0], n); \
+	} \
+};
+
+// coeffs + state, x + sidechain x_sc -> y
+#define BENCH_CS_SC(id, Cls, C_MOD, CPP_MOD) \
+template<size_t N_CHANNELS> \
+struct bench_##id { \
+	enum { hasParams = 1 }; \
+	bw_##id##_coeffs		coeffs[N_CHANNELS]; \
+	bw_##id##_state			states[N_CHANNELS]; \
+	bw_##id##_state *		statesP[N_CHANNELS]; \
+	Brickworks::Cls<N_CHANNELS>	cpp; \
+	void setup(bench_api api, float fs) { \
+		if (api == bench_api_cpp) { \
+			cpp.setSampleRate(fs); \
+			cpp.reset(); \
+			return; \
+		} \
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+			bw_##id##_init(coeffs + i); \
+			bw_##id##_set_sample_rate(coeffs + i, fs); \
+			bw_##id##_reset_coeffs(coeffs + i); \
+		} \
+		for (size_t i = 0; i < N_CHANNELS; i++) { \
+			statesP[i] = states + i; \
+			bw_##id##_reset_state(BENCH_COEFFS(api, i), states + i, 0.f, 0.f); \
+		} \
+	} \
+	void modulate(bench_api api, float p) { \
+		if (api == bench_api_cpp) { \
+			Brickworks::Cls<N_CHANNELS> *o = &cpp; \
+			CPP_MOD; \
+		} else \
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+				bw_##id##_coeffs *c = coeffs + i; \
+				C_MOD; \
+			} \
+	} \
+	void process(bench_api api, bench_buffers *b, size_t n) { \
+		if (api == bench_api_process) \
+			for (size_t i = 0; i < N_CHANNELS; i++) \
+				bw_##id##_process(coeffs + i, states + i, b->xp[0][i], b->xp[1][i], b->yp[0][i], n); \
+		else if (api == bench_api_process_multi) \
+			bw_##id##_process_multi(coeffs, statesP, b->xp[0], b->xp[1], b->yp[0], N_CHANNELS, n); \
+		else \
+			cpp.process(b->xp[0], b->xp[1], b->yp[0], n); \
+	} \
+};
+
+// coeffs only, N_IN inputs (x, x2) -> y
+#define BENCH_C(id, Cls, N_IN, C_MOD, CPP_MOD) \
+template<size_t N_CHANNELS> \
+struct bench_##id { \
+	enum { hasParams = 1 }; \
+	bw_##id##_coeffs		coeffs[N_CHANNELS]; \
+	Brickworks::Cls<N_CHANNELS>	cpp; \
+	void setup(bench_api api, float fs) { \
+		if (api == bench_api_cpp) { \
+			cpp.setSampleRate(fs); \
+			cpp.reset(); \
+			return; \
+		} \
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+			bw_##id##_init(coeffs + i); \
+			bw_##id##_set_sample_rate(coeffs + i, fs); \
+			bw_##id##_reset_coeffs(coeffs + i); \
+		} \
+	} \
+	void modulate(bench_api api, float p) { \
+		if (api == bench_api_cpp) { \
+			Brickworks::Cls<N_CHANNELS> *o = &cpp; \
+			CPP_MOD; \
+		} else \
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+				bw_##id##_coeffs *c = coeffs + i; \
+				C_MOD; \
+			} \
+	} \
+	void process(bench_api api, bench_buffers *b, size_t n) { \
+		if (api == bench_api_process) \
+			for (size_t i = 0; i < N_CHANNELS; i++) \
+				BENCH_C_PROCESS_##N_IN(id, b, i, n); \
+		else if (api == bench_api_process_multi) \
+			BENCH_C_PROCESS_MULTI_##N_IN(id, b, n); \
+		else \
+			BENCH_C_PROCESS_CPP_##N_IN(b, n); \
+	} \
+};
+#define BENCH_C_PROCESS_1(id, b, i, n)	bw_##id##_process(coeffs + i, b->xp[0][i], b->yp[0][i], n)
+#define BENCH_C_PROCESS_2(id, b, i, n)	bw_##id##_process(coeffs + i, b->xp[0][i], b->xp[1][i], b->yp[0][i], n)
+#define BENCH_C_PROCESS_MULTI_1(id, b, n)	bw_##id##_process_multi(coeffs, b->xp[0], b->yp[0], N_CHANNELS, n)
+#define BENCH_C_PROCESS_MULTI_2(id, b, n)	bw_##id##_process_multi(coeffs, b->xp[0], b->xp[1], b->yp[0], N_CHANNELS, n)
+#define BENCH_C_PROCESS_CPP_1(b, n)	cpp.process(b->xp[0], b->yp[0], n)
+#define BENCH_C_PROCESS_CPP_2(b, n)	cpp.process(b->xp[0], b->xp[1], b->yp[0], n)
+
+// coeffs only, phase x + phase increment x_inc -> y (oscillators)
+#define BENCH_OSC(id, Cls, HAS_PARAMS, C_MOD, CPP_MOD) \
+template<size_t N_CHANNELS> \
+struct bench_##id { \
+	enum { hasParams = HAS_PARAMS }; \
+	bw_##id##_coeffs		coeffs[N_CHANNELS]; \
+	Brickworks::Cls<N_CHANNELS>	cpp; \
+	void setup(bench_api api, float fs) { \
+		if (api == bench_api_cpp) { \
+			cpp.setSampleRate(fs); \
+			cpp.setAntialiasing(true); \
+			cpp.reset(); \
+			return; \
+		} \
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+			bw_##id##_init(coeffs + i); \
+			bw_##id##_set_sample_rate(coeffs + i, fs); \
+			bw_##id##_set_antialiasing(coeffs + i, 1); \
+			bw_##id##_reset_coeffs(coeffs + i); \
+		} \
+	} \
+	void modulate(bench_api api, float p) { \
+		(void)p; \
+		if (api == bench_api_cpp) { \
+			Brickworks::Cls<N_CHANNELS> *o = &cpp; \
+			(void)o; \
+			CPP_MOD; \
+		} else \
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) { \
+				bw_##id##_coeffs *c = coeffs + i; \
+				(void)c; \
+				C_MOD; \
+			} \
+	} \
+	void process(bench_api api, bench_buffers *b, size_t n) { \
+		if (api == bench_api_process) \
+			for (size_t i = 0; i < N_CHANNELS; i++) \
+				bw_##id##_process(coeffs + i, b->xp[2][i], b->xp[3][i], b->yp[0][i], n); \
+		else if (api == bench_api_process_multi) \
+			bw_##id##_process_multi(coeffs, b->xp[2], b->xp[3], b->yp[0], N_CHANNELS, n); \
+		else \
+			cpp.process(b->xp[2], b->xp[3], b->yp[0], n); \
+	} \
+};
+
+BENCH_CS(ap1, AP1, 1,
+	bw_ap1_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_CS(ap2, AP2, 1,
+	bw_ap2_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_C(bd_reduce, BDReduce, 1,
+	bw_bd_reduce_set_bit_depth(c, (char)(1.f + 15.f * p)),
+	o->setBitDepth((char)(1.f + 15.f * p)))
+BENCH_CS(cab, Cab, 1,
+	bw_cab_set_tone(c, p),
+	o->setTone(p))
+BENCH_CS_MEM(chorus, Chorus,
+	bw_chorus_set_rate(c, 0.1f + p),
+	o->setRate(0.1f + p))
+BENCH_CS(clip, Clip, 1,
+	bw_clip_set_gain(c, 0.1f + 10.f * p),
+	o->setGain(0.1f + 10.f * p))
+BENCH_CS_MEM(comb, Comb,
+	bw_comb_set_delay_ff(c, 0.001f + 0.01f * p),
+	o->setDelayFF(0.001f + 0.01f * p))
+BENCH_CS_SC(comp, Comp,
+	bw_comp_set_thresh_lin(c, 0.01f + p),
+	o->setTreshLin(0.01f + p))
+BENCH_CS_MEM(delay, Delay,
+	bw_delay_set_delay(c, 0.001f + 0.5f * p),
+	o->setDelay(0.001f + 0.5f * p))
+BENCH_CS(dist, Dist, 1,
+	bw_dist_set_distortion(c, p),
+	o->setDistortion(p))
+BENCH_CS(drive, Drive, 1,
+	bw_drive_set_drive(c, p),
+	o->setDrive(p))
+BENCH_C(dry_wet, DryWet, 2,
+	bw_dry_wet_set_wet(c, p),
+	o->setWet(p))
+BENCH_CS_MEM(ensemble, Ensemble,
+	bw_ensemble_set_rate(c, 0.1f + p),
+	o->setRate(0.1f + p))
+BENCH_CS(env_follow, EnvFollow, 1,
+	bw_env_follow_set_attack_tau(c, 0.001f + 0.1f * p),
+	o->setAttackTau(0.001f + 0.1f * p))
+BENCH_CS(fuzz, Fuzz, 1,
+	bw_fuzz_set_fuzz(c, p),
+	o->setFuzz(p))
+BENCH_C(gain, Gain, 1,
+	bw_gain_set_gain_lin(c, 2.f * p),
+	o->setGainLin(2.f * p))
+BENCH_CS(hp1, HP1, 1,
+	bw_hp1_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_CS(hs1, HS1, 1,
+	bw_hs1_set_high_gain_lin(c, 0.1f + 2.f * p),
+	o->setHighGainLin(0.1f + 2.f * p))
+BENCH_CS(hs2, HS2, 1,
+	bw_hs2_set_high_gain_lin(c, 0.1f + 2.f * p),
+	o->setHighGainLin(0.1f + 2.f * p))
+BENCH_CS(lp1, LP1, 1,
+	bw_lp1_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_CS(ls1, LS1, 1,
+	bw_ls1_set_dc_gain_lin(c, 0.1f + 2.f * p),
+	o->setDcGainLin(0.1f + 2.f * p))
+BENCH_CS(ls2, LS2, 1,
+	bw_ls2_set_dc_gain_lin(c, 0.1f + 2.f * p),
+	o->setDcGainLin(0.1f + 2.f * p))
+BENCH_CS(mm1, MM1, 1,
+	bw_mm1_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_CS(mm2, MM2, 1,
+	bw_mm2_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_CS_SC(noise_gate, NoiseGate,
+	bw_noise_gate_set_thresh_lin(c, 0.01f + p),
+	o->setTreshLin(0.01f + p))
+BENCH_CS(notch, Notch, 1,
+	bw_notch_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_CS(one_pole, OnePole, 1,
+	bw_one_pole_set_cutoff(c, 100.f + 5e3f * p),
+	o->setCutoff(100.f + 5e3f * p))
+BENCH_OSC(osc_pulse, OscPulse, 1,
+	bw_osc_pulse_set_pulse_width(c, 0.1f + 0.8f * p),
+	o->setPulseWidth(0.1f + 0.8f * p))
+BENCH_OSC(osc_saw, OscSaw, 0, (void)0, (void)0)
+BENCH_OSC(osc_tri, OscTri, 1,
+	bw_osc_tri_set_slope(c, 0.1f + 0.8f * p),
+	o->setSlope(0.1f + 0.8f * p))
+BENCH_CS(peak, Peak, 1,
+	bw_peak_set_peak_gain_lin(c, 0.1f + 2.f * p),
+	o->setPeakGainLin(0.1f + 2.f * p))
+BENCH_CS(phaser, Phaser, 1,
+	bw_phaser_set_rate(c, 0.1f + p),
+	o->setRate(0.1f + p))
+BENCH_CS(pink_filt, PinkFilt, 0, (void)0, (void)0)
+BENCH_CS(ppm, PPM, 1,
+	bw_ppm_set_integration_tau(c, 0.001f + 0.1f * p),
+	o->setIntegrationTau(0.001f + 0.1f * p))
+BENCH_C(ring_mod, RingMod, 2,
+	bw_ring_mod_set_amount(c, 2.f * p - 1.f),
+	o->setAmount(2.f * p - 1.f))
+BENCH_CS(satur, Satur, 1,
+	bw_satur_set_gain(c, 0.1f + 10.f * p),
+	o->setGain(0.1f + 10.f * p))
+BENCH_CS(slew_lim, SlewLim, 1,
+	bw_slew_lim_set_max_rate(c, 10.f + 1e4f * p),
+	o->setMaxRate(10.f + 1e4f * p))
+BENCH_CS(sr_reduce, SRReduce, 1,
+	bw_sr_reduce_set_ratio(c, 0.1f + 0.9f * p),
+	o->setRatio(0.1f + 0.9f * p))
+BENCH_CS(trem, Trem, 1,
+	bw_trem_set_rate(c, 0.1f + 10.f * p),
+	o->setRate(0.1f + 10.f * p))
+BENCH_CS(wah, Wah, 1,
+	bw_wah_set_wah(c, p),
+	o->setWah(p))
+
+template<size_t N_CHANNELS>
+struct bench_balance {
+	enum { hasParams = 1 };
+	bw_balance_coeffs		coeffs[N_CHANNELS];
+	Brickworks::Balance<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			bw_balance_init(coeffs + i);
+			bw_balance_set_sample_rate(coeffs + i, fs);
+			bw_balance_reset_coeffs(coeffs + i);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			cpp.setBalance(2.f * p - 1.f);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_balance_set_balance(coeffs + i, 2.f * p - 1.f);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_balance_process(coeffs + i, b->xp[0][i], b->xp[1][i], b->yp[0][i], b->yp[1][i], n);
+		else if (api == bench_api_process_multi)
+			bw_balance_process_multi(coeffs, b->xp[0], b->xp[1], b->yp[0], b->yp[1], N_CHANNELS, n);
+		else
+			cpp.process(b->xp[0], b->xp[1], b->yp[0], b->yp[1], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_env_gen {
+	enum { hasParams = 1 };
+	bw_env_gen_coeffs		coeffs[N_CHANNELS];
+	bw_env_gen_state		states[N_CHANNELS];
+	bw_env_gen_state *		statesP[N_CHANNELS];
+	Brickworks::EnvGen<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			bw_env_gen_init(coeffs + i);
+			bw_env_gen_set_sample_rate(coeffs + i, fs);
+			bw_env_gen_reset_coeffs(coeffs + i);
+		}
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			bw_env_gen_reset_state(BENCH_COEFFS(api, i), states + i, 0);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			cpp.setSustain(p);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_env_gen_set_sustain(coeffs + i, p);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_env_gen_process(coeffs + i, states + i, b->gate[i], b->yp[0][i], n);
+		else if (api == bench_api_process_multi)
+			bw_env_gen_process_multi(coeffs, statesP, b->gate, b->yp[0], N_CHANNELS, n);
+		else
+			cpp.process(b->gate, b->yp[0], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_noise_gen {
+	enum { hasParams = 0 };
+	uint64_t				randState[N_CHANNELS];
+	bw_noise_gen_coeffs			coeffs[N_CHANNELS];
+	uint64_t				cppRandState;
+	Brickworks::NoiseGen<N_CHANNELS>	cpp;
+	bench_noise_gen() : cppRandState(0xbaddecaf), cpp(&cppRandState) {}
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			randState[i] = 0xbaddecaf + i;
+			bw_noise_gen_init(coeffs + i, randState + i);
+			bw_noise_gen_set_sample_rate(coeffs + i, fs);
+			bw_noise_gen_reset_coeffs(coeffs + i);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		(void)api;
+		(void)p;
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_noise_gen_process(coeffs + i, b->yp[0][i], n);
+		else if (api == bench_api_process_multi)
+			bw_noise_gen_process_multi(coeffs, b->yp[0], N_CHANNELS, n);
+		else
+			cpp.process(b->yp[0], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_osc_filt {
+	enum { hasParams = 0 };
+	bw_osc_filt_state		states[N_CHANNELS];
+	bw_osc_filt_state *		statesP[N_CHANNELS];
+	Brickworks::OscFilt<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		(void)fs;
+		if (api == bench_api_cpp) {
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			bw_osc_filt_reset_state(states + i, 0.f);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		(void)api;
+		(void)p;
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_osc_filt_process(states + i, b->xp[0][i], b->yp[0][i], n);
+		else if (api == bench_api_process_multi)
+			bw_osc_filt_process_multi(statesP, b->xp[0], b->yp[0], N_CHANNELS, n);
+		else
+			cpp.process(b->xp[0], b->yp[0], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_osc_sin {
+	enum { hasParams = 0 };
+	void setup(bench_api api, float fs) {
+		(void)api;
+		(void)fs;
+	}
+	void modulate(bench_api api, float p) {
+		(void)api;
+		(void)p;
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_osc_sin_process(b->xp[2][i], b->yp[0][i], n);
+		else if (api == bench_api_process_multi)
+			bw_osc_sin_process_multi(b->xp[2], b->yp[0], N_CHANNELS, n);
+		else
+			Brickworks::oscSinProcess<N_CHANNELS>(b->xp[2], b->yp[0], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_pan {
+	enum { hasParams = 1 };
+	bw_pan_coeffs			coeffs[N_CHANNELS];
+	Brickworks::Pan<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			bw_pan_init(coeffs + i);
+			bw_pan_set_sample_rate(coeffs + i, fs);
+			bw_pan_reset_coeffs(coeffs + i);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			cpp.setPan(2.f * p - 1.f);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_pan_set_pan(coeffs + i, 2.f * p - 1.f);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_pan_process(coeffs + i, b->xp[0][i], b->yp[0][i], b->yp[1][i], n);
+		else if (api == bench_api_process_multi)
+			bw_pan_process_multi(coeffs, b->xp[0], b->yp[0], b->yp[1], N_CHANNELS, n);
+		else
+			cpp.process(b->xp[0], b->yp[0], b->yp[1], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_phase_gen {
+	enum { hasParams = 1 };
+	bw_phase_gen_coeffs			coeffs[N_CHANNELS];
+	bw_phase_gen_state			states[N_CHANNELS];
+	bw_phase_gen_state *			statesP[N_CHANNELS];
+	Brickworks::PhaseGen<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			bw_phase_gen_init(coeffs + i);
+			bw_phase_gen_set_sample_rate(coeffs + i, fs);
+			bw_phase_gen_reset_coeffs(coeffs + i);
+		}
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			float y, y_inc;
+			bw_phase_gen_reset_state(BENCH_COEFFS(api, i), states + i, 0.f, &y, &y_inc);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			cpp.setFrequency(100.f + 1e3f * p);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_phase_gen_set_frequency(coeffs + i, 100.f + 1e3f * p);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_phase_gen_process(coeffs + i, states + i, BW_NULL, b->yp[0][i], b->yp[1][i], n);
+		else if (api == bench_api_process_multi)
+			bw_phase_gen_process_multi(coeffs, statesP, BW_NULL, b->yp[0], b->yp[1], N_CHANNELS, n);
+		else
+			cpp.process(BW_NULL, b->yp[0], b->yp[1], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_reverb {
+	enum { hasParams = 1 };
+	bw_reverb_coeffs		coeffs[N_CHANNELS];
+	bw_reverb_state			states[N_CHANNELS];
+	bw_reverb_state *		statesP[N_CHANNELS];
+	void *				mem[N_CHANNELS];
+	Brickworks::Reverb<N_CHANNELS>	cpp;
+	bench_reverb() {
+		for (size_t i = 0; i < N_CHANNELS; i++)
+			mem[i] = NULL;
+	}
+	~bench_reverb() {
+		for (size_t i = 0; i < N_CHANNELS; i++)
+			free(mem[i]);
+	}
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			bw_reverb_init(coeffs + i);
+			bw_reverb_set_sample_rate(coeffs + i, fs);
+			bw_reverb_reset_coeffs(coeffs + i);
+		}
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			mem[i] = malloc(bw_reverb_mem_req(BENCH_COEFFS(api, i)));
+			bw_reverb_mem_set(BENCH_COEFFS(api, i), states + i, mem[i]);
+			float y_l, y_r;
+			bw_reverb_reset_state(BENCH_COEFFS(api, i), states + i, 0.f, 0.f, &y_l, &y_r);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			cpp.setDecay(0.9f * p);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_reverb_set_decay(coeffs + i, 0.9f * p);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_reverb_process(coeffs + i, states + i, b->xp[0][i], b->xp[1][i], b->yp[0][i], b->yp[1][i], n);
+		else if (api == bench_api_process_multi)
+			bw_reverb_process_multi(coeffs, statesP, b->xp[0], b->xp[1], b->yp[0], b->yp[1], N_CHANNELS, n);
+		else
+			cpp.process(b->xp[0], b->xp[1], b->yp[0], b->yp[1], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_reverb_block : bench_reverb<N_CHANNELS> {
+	void setup(bench_api api, float fs) {
+		bench_reverb<N_CHANNELS>::setup(api, fs);
+		if (api == bench_api_cpp)
+			this->cpp.setBlockProcessing(true);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_reverb_set_block_processing(this->coeffs + i, 1);
+	}
+};
+
+// Downsampling by 2, so that the output never exceeds the input block size.
+template<size_t N_CHANNELS>
+struct bench_src {
+	enum { hasParams = 0 };
+	bw_src_coeffs			coeffs[N_CHANNELS];
+	bw_src_state			states[N_CHANNELS];
+	bw_src_state *			statesP[N_CHANNELS];
+	Brickworks::SRC<N_CHANNELS>	cpp;
+	bench_src() : cpp(0.5f) {}
+	void setup(bench_api api, float fs) {
+		(void)fs;
+		if (api == bench_api_cpp) {
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+			bw_src_init(coeffs + i, 0.5f);
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			bw_src_reset_state(BENCH_COEFFS(api, i), states + i, 0.f);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		(void)api;
+		(void)p;
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		size_t n_in[N_CHANNELS], n_out[N_CHANNELS];
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			n_in[i] = n;
+			n_out[i] = n;
+		}
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_src_process(coeffs + i, states + i, b->xp[0][i], b->yp[0][i], n_in + i, n_out + i);
+		else if (api == bench_api_process_multi)
+			bw_src_process_multi(coeffs, statesP, b->xp[0], b->yp[0], N_CHANNELS, n_in, n_out);
+		else
+			cpp.process(b->xp[0], b->yp[0], n_in, n_out);
+	}
+};
+
+// Downsampling by 2, so that the output never exceeds the input block size.
+template<size_t N_CHANNELS>
+struct bench_src_int {
+	enum { hasParams = 0 };
+	bw_src_int_coeffs			coeffs[N_CHANNELS];
+	bw_src_int_state			states[N_CHANNELS];
+	bw_src_int_state *			statesP[N_CHANNELS];
+	Brickworks::SRCInt<N_CHANNELS>		cpp;
+	bench_src_int() : cpp(-2) {}
+	void setup(bench_api api, float fs) {
+		(void)fs;
+		if (api == bench_api_cpp) {
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+			bw_src_int_init(coeffs + i, -2);
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			bw_src_int_reset_state(BENCH_COEFFS(api, i), states + i, 0.f);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		(void)api;
+		(void)p;
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_src_int_process(coeffs + i, states + i, b->xp[0][i], b->yp[0][i], n);
+		else if (api == bench_api_process_multi)
+			bw_src_int_process_multi(coeffs, statesP, b->xp[0], b->yp[0], N_CHANNELS, n, BW_NULL);
+		else
+			cpp.process(b->xp[0], b->yp[0], n);
+	}
+};
+
+template<size_t N_CHANNELS>
+struct bench_svf {
+	enum { hasParams = 1 };
+	bw_svf_coeffs			coeffs[N_CHANNELS];
+	bw_svf_state			states[N_CHANNELS];
+	bw_svf_state *			statesP[N_CHANNELS];
+	Brickworks::SVF<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			return;
+		}
+		for (size_t i = 0; i < BENCH_N_COEFFS(api); i++) {
+			bw_svf_init(coeffs + i);
+			bw_svf_set_sample_rate(coeffs + i, fs);
+			bw_svf_reset_coeffs(coeffs + i);
+		}
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			statesP[i] = states + i;
+			float y_lp, y_bp, y_hp;
+			bw_svf_reset_state(BENCH_COEFFS(api, i), states + i, 0.f, &y_lp, &y_bp, &y_hp);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			cpp.setCutoff(100.f + 5e3f * p);
+		else
+			for (size_t i = 0; i < BENCH_N_COEFFS(api); i++)
+				bw_svf_set_cutoff(coeffs + i, 100.f + 5e3f * p);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_process)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_svf_process(coeffs + i, states + i, b->xp[0][i], b->yp[0][i], b->yp[1][i], b->yp[2][i], n);
+		else if (api == bench_api_process_multi)
+			bw_svf_process_multi(coeffs, statesP, b->xp[0], b->yp[0], b->yp[1], b->yp[2], N_CHANNELS, n);
+		else
+			cpp.process(b->xp[0], b->yp[0], b->yp[1], b->yp[2], n);
+	}
+};
+
+// Channels are voices here, all summed into the first output buffer, and
+// bench_api_process/bench_api_process_multi both use the single C bank.
+template<size_t N_CHANNELS>
+struct bench_voice_bank {
+	enum { hasParams = 1 };
+	bw_voice_bank_coeffs			coeffs;
+	bw_voice_bank_state			state;
+	bw_voice_bank_lanes			mem[BW_VOICE_BANK_N_LANES(N_CHANNELS)];
+	Brickworks::VoiceBank<N_CHANNELS>	cpp;
+	void setup(bench_api api, float fs) {
+		if (api == bench_api_cpp) {
+			cpp.setSampleRate(fs);
+			cpp.reset();
+			for (size_t i = 0; i < N_CHANNELS; i++) {
+				cpp.setVoiceFrequency(i, 110.f + 55.f * i);
+				cpp.setVoiceGate(i, true);
+			}
+			return;
+		}
+		bw_voice_bank_init(&coeffs, N_CHANNELS);
+		bw_voice_bank_set_sample_rate(&coeffs, fs);
+		bw_voice_bank_mem_set(&coeffs, &state, mem);
+		bw_voice_bank_reset_coeffs(&coeffs);
+		bw_voice_bank_reset_state(&coeffs, &state);
+		for (size_t i = 0; i < N_CHANNELS; i++) {
+			bw_voice_bank_set_voice_frequency(&state, i, 110.f + 55.f * i);
+			bw_voice_bank_set_voice_gate(&state, i, 1);
+		}
+	}
+	void modulate(bench_api api, float p) {
+		if (api == bench_api_cpp)
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				cpp.setVoiceCutoff(i, 100.f + 5e3f * p);
+		else
+			for (size_t i = 0; i < N_CHANNELS; i++)
+				bw_voice_bank_set_voice_cutoff(&state, i, 100.f + 5e3f * p);
+	}
+	void process(bench_api api, bench_buffers *b, size_t n) {
+		if (api == bench_api_cpp)
+			cpp.process(b->yp[0][0], n);
+		else
+			bw_voice_bank_process(&coeffs, &state, b->yp[0][0], n);
+	}
+};
+
+int main(int argc, char **argv) {
+	if (!bench_parse_args(argc, argv))
+		return EXIT_FAILURE;
+
+	bench_buffers_init(bench_options.sample_rate);
+	bench_output_begin();
+
+	bench_module<bench_ap1>("bw_ap1");
+	bench_module<bench_ap2>("bw_ap2");
+	bench_module<bench_balance>("bw_balance");
+	bench_module<bench_bd_reduce>("bw_bd_reduce");
+	bench_module<bench_cab>("bw_cab");
+	bench_module<bench_chorus>("bw_chorus");
+	bench_module<bench_clip>("bw_clip");
+	bench_module<bench_comb>("bw_comb");
+	bench_module<bench_comp>("bw_comp");
+	bench_module<bench_delay>("bw_delay");
+	bench_module<bench_dist>("bw_dist");
+	bench_module<bench_drive>("bw_drive");
+	bench_module<bench_dry_wet>("bw_dry_wet");
+	bench_module<bench_ensemble>("bw_ensemble");
+	bench_module<bench_env_follow>("bw_env_follow");
+	bench_module<bench_env_gen>("bw_env_gen");
+	bench_module<bench_fuzz>("bw_fuzz");
+	bench_module<bench_gain>("bw_gain");
+	bench_module<bench_hp1>("bw_hp1");
+	bench_module<bench_hs1>("bw_hs1");
+	bench_module<bench_hs2>("bw_hs2");
+	bench_module<bench_lp1>("bw_lp1");
+	bench_module<bench_ls1>("bw_ls1");
+	bench_module<bench_ls2>("bw_ls2");
+	bench_module<bench_mm1>("bw_mm1");
+	bench_module<bench_mm2>("bw_mm2");
+	bench_module<bench_noise_gate>("bw_noise_gate");
+	bench_module<bench_noise_gen>("bw_noise_gen");
+	bench_module<bench_notch>("bw_notch");
+	bench_module<bench_one_pole>("bw_one_pole");
+	bench_module<bench_osc_filt>("bw_osc_filt");
+	bench_module<bench_osc_pulse>("bw_osc_pulse");
+	bench_module<bench_osc_saw>("bw_osc_saw");
+	bench_module<bench_osc_sin>("bw_osc_sin");
+	bench_module<bench_osc_tri>("bw_osc_tri");
+	bench_module<bench_pan>("bw_pan");
+	bench_module<bench_peak>("bw_peak");
+	bench_module<bench_phase_gen>("bw_phase_gen");
+	bench_module<bench_phaser>("bw_phaser");
+	bench_module<bench_pink_filt>("bw_pink_filt");
+	bench_module<bench_ppm>("bw_ppm");
+	bench_module<bench_reverb>("bw_reverb");
+	bench_module<bench_reverb_block>("bw_reverb_block");
+	bench_module<bench_ring_mod>("bw_ring_mod");
+	bench_module<bench_satur>("bw_satur");
+	bench_module<bench_slew_lim>("bw_slew_lim");
+	bench_module<bench_sr_reduce>("bw_sr_reduce");
+	bench_module<bench_src>("bw_src");
+	bench_module<bench_src_int>("bw_src_int");
+	bench_module<bench_svf>("bw_svf");
+	bench_module<bench_trem>("bw_trem");
+	bench_module<bench_voice_bank>("bw_voice_bank");
+	bench_module<bench_wah>("bw_wah");
+
+	bench_output_end();
+	if (bench_options.out != stdout)
+		fclose(bench_options.out);
+
+	return EXIT_SUCCESS;
+}
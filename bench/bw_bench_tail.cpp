@@ -0,0 +1,172 @@
+#include "bench.h"
+
+#include <bw_lp1.h>
+#include <bw_one_pole.h>
+#include <bw_reverb.h>
+#include <bw_svf.h>
+
+// Measures the CPU cost of decaying tails: each module is fed with a short
+// white noise burst followed by silence and the time spent processing is
+// reported for each second of audio. Without countermeasures, internal states
+// eventually become denormal and processing slows down.
+//
+// Modes are:
+//  * default: no countermeasures;
+//  * ftz_daz: denormals disabled at runtime via Brickworks::DenormalsGuard;
+//  * flush: built with BW_FLUSH_DENORMALS (build/bw_bench_tail_flush).
+
+#define BENCH_TAIL_BLOCK	64
+#define BENCH_TAIL_BURST_S	0.1f
+#define BENCH_TAIL_LENGTH_S	30
+
+struct bench_tail_lp1 {
+	bw_lp1_coeffs	coeffs;
+	bw_lp1_state	state;
+	void setup(float fs) {
+		bw_lp1_init(&coeffs);
+		bw_lp1_set_sample_rate(&coeffs, fs);
+		bw_lp1_set_cutoff(&coeffs, 10.f);
+		bw_lp1_reset_coeffs(&coeffs);
+		bw_lp1_reset_state(&coeffs, &state, 0.f);
+	}
+	void process(const float *x, size_t n) {
+		bw_lp1_process(&coeffs, &state, x, bench_bufs.y[0][0], n);
+	}
+};
+
+struct bench_tail_one_pole {
+	bw_one_pole_coeffs	coeffs;
+	bw_one_pole_state	state;
+	void setup(float fs) {
+		bw_one_pole_init(&coeffs);
+		bw_one_pole_set_sample_rate(&coeffs, fs);
+		bw_one_pole_set_cutoff(&coeffs, 10.f);
+		bw_one_pole_reset_coeffs(&coeffs);
+		bw_one_pole_reset_state(&coeffs, &state, 0.f);
+	}
+	void process(const float *x, size_t n) {
+		bw_one_pole_process(&coeffs, &state, x, bench_bufs.y[0][0], n);
+	}
+};
+
+struct bench_tail_svf {
+	bw_svf_coeffs	coeffs;
+	bw_svf_state	state;
+	void setup(float fs) {
+		bw_svf_init(&coeffs);
+		bw_svf_set_sample_rate(&coeffs, fs);
+		bw_svf_set_cutoff(&coeffs, 1e3f);
+		bw_svf_set_Q(&coeffs, 10.f);
+		bw_svf_reset_coeffs(&coeffs);
+		float y_lp, y_bp, y_hp;
+		bw_svf_reset_state(&coeffs, &state, 0.f, &y_lp, &y_bp, &y_hp);
+	}
+	void process(const float *x, size_t n) {
+		bw_svf_process(&coeffs, &state, x, bench_bufs.y[0][0], bench_bufs.y[1][0], bench_bufs.y[2][0], n);
+	}
+};
+
+struct bench_tail_reverb {
+	bw_reverb_coeffs	coeffs;
+	bw_reverb_state		state;
+	void *			mem;
+	bench_tail_reverb() : mem(NULL) {}
+	~bench_tail_reverb() {
+		free(mem);
+	}
+	void setup(float fs) {
+		bw_reverb_init(&coeffs);
+		bw_reverb_set_sample_rate(&coeffs, fs);
+		bw_reverb_set_decay(&coeffs, 0.9f);
+		mem = malloc(bw_reverb_mem_req(&coeffs));
+		bw_reverb_mem_set(&coeffs, &state, mem);
+		bw_reverb_reset_coeffs(&coeffs);
+		float y_l, y_r;
+		bw_reverb_reset_state(&coeffs, &state, 0.f, 0.f, &y_l, &y_r);
+	}
+	void process(const float *x, size_t n) {
+		bw_reverb_process(&coeffs, &state, x, x, bench_bufs.y[0][0], bench_bufs.y[1][0], n);
+	}
+};
+
+static void bench_tail_output(
+		const char * module,
+		const char * mode,
+		size_t       t,
+		double       ns_per_sample) {
+	if (bench_options.format == bench_format_csv)
+		fprintf(bench_options.out, "%s,%s,%zu,%.4f\n", module, mode, t, ns_per_sample);
+	else
+		fprintf(bench_options.out, "%s\t{ \"module\": \"%s\", \"mode\": \"%s\", \"t_s\": %zu, \"ns_per_sample\": %.4f }",
+			bench_options.n_results ? ",\n" : "", module, mode, t, ns_per_sample);
+	bench_options.n_results++;
+	fflush(bench_options.out);
+}
+
+template<class B>
+static void bench_tail_run(
+		const char * module,
+		const char * mode) {
+	B *b = new B();
+	b->setup(bench_options.sample_rate);
+
+	static float zeros[BENCH_TAIL_BLOCK];
+	const size_t n_second = (size_t)bench_options.sample_rate;
+	const size_t n_burst = (size_t)(BENCH_TAIL_BURST_S * bench_options.sample_rate);
+	size_t n_done = 0;
+	for (size_t t = 0; t < BENCH_TAIL_LENGTH_S; t++) {
+		const double t0 = bench_now_ns();
+		for (size_t i = 0; i < n_second; i += BENCH_TAIL_BLOCK) {
+			const size_t n = n_second - i < BENCH_TAIL_BLOCK ? n_second - i : BENCH_TAIL_BLOCK;
+			// wrap on block-aligned offsets so that reads stay within the row
+			const size_t off = (n_done % (BENCH_MAX_BLOCK - BENCH_TAIL_BLOCK + 1)) & ~(size_t)(BENCH_TAIL_BLOCK - 1);
+			const float *x = n_done < n_burst ? bench_bufs.x[0][0] + off : zeros;
+			b->process(x, n);
+			n_done += n;
+		}
+		const double t1 = bench_now_ns();
+		bench_tail_output(module, mode, t, (t1 - t0) / (double)n_second);
+	}
+
+	delete b;
+}
+
+template<class B>
+static void bench_tail_module(
+		const char * module) {
+	if (bench_options.module_filter != NULL && strcmp(bench_options.module_filter, module) != 0)
+		return;
+	fprintf(stderr, "%s\n", module);
+#ifdef BW_FLUSH_DENORMALS
+	bench_tail_run<B>(module, "flush");
+#else
+	bench_tail_run<B>(module, "default");
+	{
+		Brickworks::DenormalsGuard guard;
+		bench_tail_run<B>(module, "ftz_daz");
+	}
+#endif
+}
+
+int main(int argc, char **argv) {
+	if (!bench_parse_args(argc, argv))
+		return EXIT_FAILURE;
+	bench_buffers_init(bench_options.sample_rate);
+
+	if (bench_options.format == bench_format_csv)
+		fprintf(bench_options.out, "module,mode,t_s,ns_per_sample\n");
+	else
+		fprintf(bench_options.out, "[\n");
+
+	bench_tail_module<bench_tail_lp1>("bw_lp1");
+	bench_tail_module<bench_tail_one_pole>("bw_one_pole");
+	bench_tail_module<bench_tail_reverb>("bw_reverb");
+	bench_tail_module<bench_tail_svf>("bw_svf");
+
+	if (bench_options.format == bench_format_json)
+		fprintf(bench_options.out, "\n]\n");
+	if (bench_options.out != stdout)
+		fclose(bench_options.out);
+
+	return EXIT_SUCCESS;
+}
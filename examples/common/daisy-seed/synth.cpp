@@ -2,6 +2,8 @@
 #include "config.h"
 #include "config_daisy_seed.h"
 
+#include <bw_spsc_queue.h>
+
 #define BLOCK_SIZE 32
 
 using namespace daisy;
@@ -13,6 +15,9 @@ MidiUsbHandler midi_usb;
 
 P_TYPE instance;
 
+// MIDI is received in the main loop and applied in the audio callback
+bw_spsc_queue midiQueue;
+
 float buf[2][BLOCK_SIZE];
 float *bufs[2] = { buf[0], buf[1] };
 
@@ -21,6 +26,32 @@ static void AudioCallback(
 		AudioHandle::InterleavingOutputBuffer out,
 		size_t size) {
 	loadMeter.OnBlockStart();
+	bw_spsc_queue_msg msg;
+	while (bw_spsc_queue_pop(&midiQueue, &msg)) {
+		switch (msg.type) {
+		case bw_spsc_queue_type_note_on:
+			P_NOTE_ON(&instance, msg.index, msg.value);
+			break;
+		case bw_spsc_queue_type_note_off:
+			P_NOTE_OFF(&instance, msg.index);
+			break;
+#ifdef P_PITCH_BEND
+		case bw_spsc_queue_type_pitch_bend:
+			P_PITCH_BEND(&instance, msg.value);
+			break;
+#endif
+#ifdef P_MOD_WHEEL
+		case bw_spsc_queue_type_mod_wheel:
+			P_MOD_WHEEL(&instance, msg.value);
+			break;
+#endif
+		case bw_spsc_queue_type_parameter:
+			P_SET_PARAMETER(&instance, msg.index, msg.value);
+			break;
+		default:
+			break;
+		}
+	}
 	const size_t n = size >> 1;
 	P_PROCESS(&instance, nullptr, bufs, n);
 	for (size_t i = 0; i < n; i++) {
@@ -35,6 +66,17 @@ static void AudioCallback(
 	loadMeter.OnBlockEnd();
 }
 
+// MIDI messages are never dropped, as a lost note off would leave a stuck
+// note and a lost parameter change a stale value: if the queue is full, wait
+// for the audio callback to drain it, which takes at most one block
+static void PushMessage(
+		bw_spsc_queue_type type,
+		uint32_t           index,
+		float              value) {
+	while (!bw_spsc_queue_push(&midiQueue, type, index, value))
+		;
+}
+
 int main() {
 	hardware.Configure();
 	hardware.Init();
@@ -58,6 +100,7 @@ int main() {
 #endif
 
 	P_RESET(&instance);
+	bw_spsc_queue_reset(&midiQueue);
 
 	MidiUsbHandler::Config midi_usb_cfg;
 	midi_usb_cfg.transport_config.periph = MidiUsbTransport::Config::INTERNAL;
@@ -80,20 +123,20 @@ int main() {
 			case NoteOn:
 			{
 				NoteOnEvent v = ev.AsNoteOn();
-				P_NOTE_ON(&instance, v.note, v.velocity);
+				PushMessage(bw_spsc_queue_type_note_on, v.note, v.velocity);
 			}
 				break;
 			case NoteOff:
 			{
 				NoteOffEvent v = ev.AsNoteOff();
-				P_NOTE_OFF(&instance, v.note);
+				PushMessage(bw_spsc_queue_type_note_off, v.note, v.velocity);
 			}
 				break;
 #ifdef P_PITCH_BEND
 			case PitchBend:
 			{
 				PitchBendEvent v = ev.AsPitchBend();
-				P_PITCH_BEND(&instance, v.value);
+				PushMessage(bw_spsc_queue_type_pitch_bend, 0, v.value);
 			}
 #endif
 				break;
@@ -102,12 +145,12 @@ int main() {
 				ControlChangeEvent v = ev.AsControlChange();
 #ifdef P_MOD_WHEEL
 				if (v.control_number == 1)
-					P_MOD_WHEEL(&instance, v.value);
+					PushMessage(bw_spsc_queue_type_mod_wheel, 0, v.value);
 				else {
 #endif
 					for (int i = 0; i < NUM_CCS; i++)
 						if (v.control_number == config_ccs[i].cc)
-							P_SET_PARAMETER(&instance, config_ccs[i].param_index, (1.f / 127.f) * v.value);
+							PushMessage(bw_spsc_queue_type_parameter, config_ccs[i].param_index, (1.f / 127.f) * v.value);
 #ifdef P_MOD_WHEEL
 				}
 #endif
@@ -34,8 +34,21 @@
 #include <pmmintrin.h>
 #endif
 
+// minimum slice length (samples) for sample-accurate event handling
+#ifndef EVENT_MIN_SLICE
+# define EVENT_MIN_SLICE	16
+#endif
+
 Plugin::Plugin() {
 	setControllerClass(FUID(CTRL_GUID_1, CTRL_GUID_2, CTRL_GUID_3, CTRL_GUID_4));
+	bw_event_queue_reset(&eventQueue);
+#if NUM_PARAMETERS != 0
+	for (int i = 0; i < NUM_PARAMETERS; i++) {
+		stateParameters[i].store(0.f, std::memory_order_relaxed);
+		stateParametersDirty[i].store(false, std::memory_order_relaxed);
+	}
+	stateDirty.store(false, std::memory_order_relaxed);
+#endif
 #ifdef P_MEM_REQ
 	this->mem = NULL;
 #endif
@@ -143,9 +156,57 @@ tresult PLUGIN_API Plugin::setupProcessing(ProcessSetup &setup) {
 	return AudioEffect::setupProcessing(setup);
 }
 
-tresult PLUGIN_API Plugin::process(ProcessData &data) {
-	if (data.numInputs != NUM_BUSES_IN || data.numOutputs != NUM_BUSES_OUT)
-		return kResultFalse;
+void Plugin::applyEvent(const bw_event_queue_event *e) {
+	switch (e->type) {
+#if NUM_PARAMETERS != 0
+	case bw_event_queue_type_parameter:
+		switch (e->index) {
+#ifdef P_PITCH_BEND
+		case TAG_PITCH_BEND:
+			P_PITCH_BEND(&instance, static_cast<int>(16383.f * std::min(std::max(e->value, 0.f), 1.f)));
+			break;
+#endif
+#ifdef P_MOD_WHEEL
+		case TAG_MOD_WHEEL:
+			P_MOD_WHEEL(&instance, static_cast<char>(127.f * std::min(std::max(e->value, 0.f), 1.f)));
+			break;
+#endif
+		default:
+			parameters[e->index] = e->value;
+			P_SET_PARAMETER(&instance, e->index, std::min(std::max(e->value, 0.f), 1.f));
+			break;
+		}
+		break;
+#endif
+#ifdef P_NOTE_ON
+	case bw_event_queue_type_note_on:
+		P_NOTE_ON(&instance, static_cast<char>(e->index), static_cast<char>(e->value));
+		break;
+	case bw_event_queue_type_note_off:
+		P_NOTE_OFF(&instance, static_cast<char>(e->index));
+		break;
+#endif
+	default:
+		break;
+	}
+}
+
+bool Plugin::readEvent(const bw_event_queue_event *e, size_t &k, size_t skip, bool apply) {
+	if (k >= skip) {
+		if (apply)
+			applyEvent(e);
+		else if (!bw_event_queue_add(&eventQueue, e->offset, e->type, e->index, e->value))
+			return false;
+	}
+	k++;
+	return true;
+}
+
+// Goes through host events in order, skipping the first skip ones, and either
+// applies the others or adds them to eventQueue until it is full. Returns the
+// number of events gone through, skipped ones included.
+size_t Plugin::readEvents(ProcessData &data, size_t skip, bool apply) {
+	size_t k = 0;
 
 #if NUM_PARAMETERS != 0
 	if (data.inputParameterChanges) {
@@ -154,26 +215,19 @@ tresult PLUGIN_API Plugin::process(ProcessData &data) {
 			IParamValueQueue *q = data.inputParameterChanges->getParameterData(i);
 			if (!q)
 				continue;
-			ParamValue v;
-			int32 o;
-			if (q->getPoint(q->getPointCount() - 1, o, v) == kResultTrue) {
-				int32 pi = q->getParameterId();
-				switch (pi) {
-#ifdef P_PITCH_BEND
-				case TAG_PITCH_BEND:
-					P_PITCH_BEND(&instance, static_cast<int>(16383.f * std::min(std::max(static_cast<float>(v), 0.f), 1.f)));
-					break;
-#endif
-#ifdef P_MOD_WHEEL
-				case TAG_MOD_WHEEL:
-					P_MOD_WHEEL(&instance, static_cast<char>(127.f * std::min(std::max(static_cast<float>(v), 0.f), 1.f)));
-					break;
-#endif
-				default:
-					parameters[pi] = v;
-					P_SET_PARAMETER(&instance, pi, std::min(std::max(static_cast<float>(v), 0.f), 1.f));
-					break;
-				}
+			bw_event_queue_event e;
+			e.type = bw_event_queue_type_parameter;
+			e.index = q->getParameterId();
+			int32 m = q->getPointCount();
+			for (int32 j = 0; j < m; j++) {
+				ParamValue v;
+				int32 o;
+				if (q->getPoint(j, o, v) != kResultTrue)
+					continue;
+				e.offset = o > 0 ? o : 0;
+				e.value = static_cast<float>(v);
+				if (!readEvent(&e, k, skip, apply))
+					return k;
 			}
 		}
 	}
@@ -183,21 +237,63 @@ tresult PLUGIN_API Plugin::process(ProcessData &data) {
 	if (data.inputEvents) {
 		int32 n = data.inputEvents->getEventCount();
 		for (int i = 0; i < n; i++) {
-			Event e;
-			if (data.inputEvents->getEvent(i, e) != kResultOk)
+			Event ev;
+			if (data.inputEvents->getEvent(i, ev) != kResultOk)
 				continue;
-			switch (e.type) {
+			bw_event_queue_event e;
+			e.offset = ev.sampleOffset > 0 ? ev.sampleOffset : 0;
+			switch (ev.type) {
 				case Event::kNoteOnEvent:
-					P_NOTE_ON(&instance, e.noteOn.pitch, 127.f * e.noteOn.velocity);
+					e.type = bw_event_queue_type_note_on;
+					e.index = ev.noteOn.pitch;
+					e.value = 127.f * ev.noteOn.velocity;
 					break;
 				case Event::kNoteOffEvent:
-					P_NOTE_OFF(&instance, e.noteOff.pitch);
+					e.type = bw_event_queue_type_note_off;
+					e.index = ev.noteOff.pitch;
+					e.value = 0.f;
 					break;
+				default:
+					continue;
 			}
+			if (!readEvent(&e, k, skip, apply))
+				return k;
 		}
 	}
 #endif
 
+#if NUM_PARAMETERS == 0 && !defined(P_NOTE_ON)
+	(void)data;
+	(void)skip;
+	(void)apply;
+#endif
+	return k;
+}
+
+tresult PLUGIN_API Plugin::process(ProcessData &data) {
+	if (data.numInputs != NUM_BUSES_IN || data.numOutputs != NUM_BUSES_OUT)
+		return kResultFalse;
+
+#if NUM_PARAMETERS != 0
+	// latest parameter values from setState(), applied before host events
+	if (stateDirty.exchange(false, std::memory_order_acquire))
+		for (int i = 0; i < NUM_PARAMETERS; i++) {
+			if (!stateParametersDirty[i].exchange(false, std::memory_order_acquire))
+				continue;
+			bw_event_queue_event e;
+			e.offset = 0;
+			e.type = bw_event_queue_type_parameter;
+			e.index = i;
+			e.value = stateParameters[i].load(std::memory_order_relaxed);
+			applyEvent(&e);
+		}
+#endif
+
+	// host events that do not fit in the queue are applied, in order, before
+	// the last slice
+	const size_t nQueued = readEvents(data, 0, false);
+	const bool overflow = eventQueue.n_events == BW_EVENT_QUEUE_MAX_EVENTS;
+
 #if NUM_BUSES_IN != 0
 	int ki = 0;
 	for (int i = 0; i < data.numInputs; i++)
@@ -224,13 +320,36 @@ tresult PLUGIN_API Plugin::process(ProcessData &data) {
 	_MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
 #endif
 
-#if NUM_BUSES_IN == 0
-	const float **inputs = nullptr;
+#if NUM_BUSES_IN != 0
+	const float *x[NUM_CHANNELS_IN];
+#else
+	const float **x = nullptr;
 #endif
-#if NUM_BUSES_OUT == 0
-	float **outputs = nullptr;
+#if NUM_BUSES_OUT != 0
+	float *y[NUM_CHANNELS_OUT];
+#else
+	float **y = nullptr;
 #endif
-	P_PROCESS(&instance, inputs, outputs, data.numSamples);
+	bw_event_queue_slice s;
+	bw_event_queue_slice_reset(&s);
+	while (bw_event_queue_next_slice(&eventQueue, data.numSamples, EVENT_MIN_SLICE, &s)) {
+		for (size_t i = 0; i < s.n_events; i++)
+			applyEvent(s.events + i);
+		if (overflow && s.offset + s.n_samples == static_cast<size_t>(data.numSamples))
+			readEvents(data, nQueued, true);
+		if (s.n_samples == 0)
+			continue;
+#if NUM_BUSES_IN != 0
+		for (int i = 0; i < NUM_CHANNELS_IN; i++)
+			x[i] = inputs[i] + s.offset;
+#endif
+#if NUM_BUSES_OUT != 0
+		for (int i = 0; i < NUM_CHANNELS_OUT; i++)
+			y[i] = outputs[i] + s.offset;
+#endif
+		P_PROCESS(&instance, x, y, s.n_samples);
+	}
+	bw_event_queue_clear(&eventQueue);
 
 #if defined(__aarch64__)
 	__asm__ __volatile__ ("msr fpcr, %0" : : "r"(fpcr));
@@ -293,8 +412,9 @@ tresult PLUGIN_API Plugin::setState(IBStream *state) {
 			continue;
 		if (streamer.readFloat(f) == false)
 			return kResultFalse;
-		parameters[i] = f;
-		P_SET_PARAMETER(&instance, i, f);
+		stateParameters[i].store(f, std::memory_order_relaxed);
+		stateParametersDirty[i].store(true, std::memory_order_release);
+		stateDirty.store(true, std::memory_order_release);
 	}
 #endif
 
@@ -307,7 +427,8 @@ tresult PLUGIN_API Plugin::getState(IBStream *state) {
 
 	for (int i = 0; i < NUM_PARAMETERS; i++)
 		if (!config_parameters[i].out)
-			streamer.writeFloat(parameters[i]);
+			streamer.writeFloat(stateParametersDirty[i].load(std::memory_order_acquire)
+				? stateParameters[i].load(std::memory_order_relaxed) : parameters[i]);
 #endif
 
 	return kResultTrue;
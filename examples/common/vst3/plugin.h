@@ -24,6 +24,10 @@
 #include "config.h"
 #include "config_vst3.h"
 
+#include <bw_event_queue.h>
+
+#include <atomic>
+
 #include "public.sdk/source/vst/vstaudioeffect.h"
 
 using namespace Steinberg;
@@ -49,10 +53,19 @@ public:
 	tresult PLUGIN_API getState(IBStream *state) SMTG_OVERRIDE;
 
 private:
+	void applyEvent(const bw_event_queue_event *e);
+	bool readEvent(const bw_event_queue_event *e, size_t &k, size_t skip, bool apply);
+	size_t readEvents(ProcessData &data, size_t skip, bool apply);
+
 	float sampleRate;
 
 #if NUM_PARAMETERS != 0
 	float parameters[NUM_PARAMETERS];
+
+	// parameter values from setState(), which may run on another thread
+	std::atomic<float> stateParameters[NUM_PARAMETERS];
+	std::atomic<bool> stateParametersDirty[NUM_PARAMETERS];
+	std::atomic<bool> stateDirty;
 #endif
 
 	P_TYPE instance;
@@ -63,6 +76,8 @@ private:
 	float *outputs[NUM_CHANNELS_OUT];
 #endif
 
+	bw_event_queue eventQueue;
+
 #ifdef P_MEM_REQ
 	void *mem;
 #endif
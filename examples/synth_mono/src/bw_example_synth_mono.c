@@ -220,8 +220,7 @@ void bw_example_synth_mono_process(bw_example_synth_mono *instance, const float*
 		const float k = instance->params[p_noise_color] >= 0.5f
 			? 6.f * bw_noise_gen_get_scaling_k(&instance->noise_gen_coeffs) * bw_pink_filt_get_scaling_k(&instance->pink_filt_coeffs)
 			: 0.1f * bw_noise_gen_get_scaling_k(&instance->noise_gen_coeffs);
-		bw_buf_scale(instance->buf[0], k, instance->buf[0], n);
-		bw_buf_mix(out, instance->buf[0], out, n);
+		bw_buf_mac(instance->buf[0], k, out, n);
 		
 		bw_env_gen_process(&instance->vcf_env_gen_coeffs, &instance->vcf_env_gen_state, instance->gate, NULL, n);
 		float v = instance->params[p_vcf_cutoff] + instance->params[p_vcf_contour] * bw_env_gen_get_y_z1(&instance->vcf_env_gen_state) + vcf_mod;
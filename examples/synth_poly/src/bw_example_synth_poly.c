@@ -22,7 +22,6 @@
 
 #include <bw_buf.h>
 #include <bw_math.h>
-#include <bw_voice_alloc.h>
 
 void bw_example_synth_poly_init(bw_example_synth_poly *instance) {
 	bw_osc_saw_init(&instance->vco_saw_coeffs);
@@ -98,6 +97,7 @@ void bw_example_synth_poly_reset(bw_example_synth_poly *instance) {
 		bw_svf_set_cutoff(&instance->voices[i].vcf_coeffs, bw_clipf(cutoff, 20.f, 20e3f));
 	
 	bw_note_queue_reset(&instance->note_queue);
+	bw_voice_alloc_reset_state(&instance->voice_alloc_state, N_VOICES);
 	bw_osc_saw_reset_coeffs(&instance->vco_saw_coeffs);
 	bw_osc_pulse_reset_coeffs(&instance->vco1_pulse_coeffs);
 	bw_osc_tri_reset_coeffs(&instance->vco1_tri_coeffs);
@@ -157,17 +157,6 @@ static void note_off(void *BW_RESTRICT voice, float velocity) {
 	v->gate = 0;
 }
 
-static unsigned char get_note(const void *BW_RESTRICT voice) {
-	bw_example_synth_poly_voice *v = (bw_example_synth_poly_voice *)voice;
-	return v->note;
-}
-
-static char is_free(const void *BW_RESTRICT voice) {
-	bw_example_synth_poly_voice *v = (bw_example_synth_poly_voice *)voice;
-	bw_env_gen_phase phase = bw_env_gen_get_phase(&v->vca_env_gen_state);
-	return !v->gate && phase == bw_env_gen_phase_off;
-}
-
 void bw_example_synth_poly_process(bw_example_synth_poly *instance, const float** x, float** y, int n_samples) {
 	// FIXME: control-rate modulations are asynchronous here...
 	// it's all good as long as hosts gives us buffers whose length is a multiple of 32,
@@ -175,12 +164,16 @@ void bw_example_synth_poly_process(bw_example_synth_poly *instance, const float*
 	
 	(void)x;
 	
-	static bw_voice_alloc_opts alloc_opts = { bw_voice_alloc_priority_low, note_on, note_off, get_note, is_free };
+	static bw_voice_alloc_opts alloc_opts = { bw_voice_alloc_priority_low, note_on, note_off, NULL, NULL };
 	void *voices[N_VOICES];
 	for (int i = 0; i < N_VOICES; i++)
 		voices[i] = (void *)(instance->voices + i);
-	bw_voice_alloc(&alloc_opts, &instance->note_queue, voices, N_VOICES);
+	bw_voice_alloc_process(&alloc_opts, &instance->voice_alloc_state, &instance->note_queue, voices);
 	bw_note_queue_clear(&instance->note_queue);
+
+	// only process voices that are sounding
+	size_t active[N_VOICES];
+	const int n_active = (int)bw_voice_alloc_get_active_voices(&instance->voice_alloc_state, active);
 	
 	const float df1 =
 		6.f * instance->params[p_vco1_coarse] - 3.f
@@ -194,133 +187,136 @@ void bw_example_synth_poly_process(bw_example_synth_poly *instance, const float*
 		6.f * instance->params[p_vco3_coarse] - 3.f
 		+ 2.f * instance->pitch_bend - 1.f
 		+ 8.333333333333333e-2f * (2.f * (instance->params[p_master_tune] + instance->params[p_vco3_fine]) - 71.f);
-	for (int i = 0; i < N_VOICES; i++) {
-		int n3 = instance->params[p_vco3_kbd] >= 0.5f ? instance->voices[i].note : 0;
-		bw_phase_gen_set_frequency(&instance->voices[i].vco1_phase_gen_coeffs, 440.f * bw_pow2f(df1 + 8.333333333333333e-2f * instance->voices[i].note));
-		bw_phase_gen_set_frequency(&instance->voices[i].vco2_phase_gen_coeffs, 440.f * bw_pow2f(df2 + 8.333333333333333e-2f * instance->voices[i].note));
-		bw_phase_gen_set_frequency(&instance->voices[i].vco3_phase_gen_coeffs, 440.f * bw_pow2f(df3 + 8.333333333333333e-2f * n3));
+	for (int i = 0; i < n_active; i++) {
+		bw_example_synth_poly_voice *v = instance->voices + active[i];
+		int n3 = instance->params[p_vco3_kbd] >= 0.5f ? v->note : 0;
+		bw_phase_gen_set_frequency(&v->vco1_phase_gen_coeffs, 440.f * bw_pow2f(df1 + 8.333333333333333e-2f * v->note));
+		bw_phase_gen_set_frequency(&v->vco2_phase_gen_coeffs, 440.f * bw_pow2f(df2 + 8.333333333333333e-2f * v->note));
+		bw_phase_gen_set_frequency(&v->vco3_phase_gen_coeffs, 440.f * bw_pow2f(df3 + 8.333333333333333e-2f * n3));
 	}
 	
 	const float vcf_mod_k = 0.3f * instance->params[p_vcf_mod];
 	
+	// from here on j-th elements refer to the j-th active voice
+	bw_example_synth_poly_voice *v[N_VOICES];
 	float *b0[N_VOICES], *b1[N_VOICES], *b2[N_VOICES], *b3[N_VOICES], *b4[N_VOICES];
 	char gates[N_VOICES];
 	bw_osc_filt_state *osc_filt_states[N_VOICES];
 	bw_pink_filt_state *pink_filt_states[N_VOICES];
 	bw_env_gen_state *vcf_env_gen_states[N_VOICES], *vca_env_gen_states[N_VOICES];
-	for (int j = 0; j < N_VOICES; j++) {
-		b0[j] = instance->voices[j].buf[0];
-		b1[j] = instance->voices[j].buf[1];
-		b2[j] = instance->voices[j].buf[2];
-		b3[j] = instance->voices[j].buf[3];
-		b4[j] = instance->voices[j].buf[4];
-		gates[j] = instance->voices[j].gate;
-		osc_filt_states[j] = &instance->voices[j].osc_filt_state;
-		pink_filt_states[j] = &instance->voices[j].pink_filt_state;
-		vcf_env_gen_states[j] = &instance->voices[j].vcf_env_gen_state;
-		vca_env_gen_states[j] = &instance->voices[j].vca_env_gen_state;
+	for (int j = 0; j < n_active; j++) {
+		v[j] = instance->voices + active[j];
+		b0[j] = v[j]->buf[0];
+		b1[j] = v[j]->buf[1];
+		b2[j] = v[j]->buf[2];
+		b3[j] = v[j]->buf[3];
+		b4[j] = v[j]->buf[4];
+		gates[j] = v[j]->gate;
+		osc_filt_states[j] = &v[j]->osc_filt_state;
+		pink_filt_states[j] = &v[j]->pink_filt_state;
+		vcf_env_gen_states[j] = &v[j]->vcf_env_gen_state;
+		vca_env_gen_states[j] = &v[j]->vca_env_gen_state;
 	}
 
 	for (int i = 0; i < n_samples; i += BUFFER_SIZE) {
 		float *out = y[0] + i;
 		int n = bw_minf(n_samples - i, BUFFER_SIZE);
 		
-		for (int j = 0; j < N_VOICES; j++)
-			bw_phase_gen_process(&instance->voices[j].vco3_phase_gen_coeffs, &instance->voices[j].vco3_phase_gen_state, NULL, b0[j], b1[j], n);
+		for (int j = 0; j < n_active; j++)
+			bw_phase_gen_process(&v[j]->vco3_phase_gen_coeffs, &v[j]->vco3_phase_gen_state, NULL, b0[j], b1[j], n);
 		if (instance->params[p_vco3_waveform] >= (1.f / 4.f + 1.f / 2.f)) {
-			bw_osc_tri_process_multi(&instance->vco3_tri_coeffs, (const float **)b0, (const float **)b1, b0, N_VOICES, n);
+			bw_osc_tri_process_multi(&instance->vco3_tri_coeffs, (const float **)b0, (const float **)b1, b0, n_active, n);
 			bw_osc_pulse_reset_coeffs(&instance->vco3_pulse_coeffs);
 		} else if (instance->params[p_vco3_waveform] >= (1.f / 4.f)) {
-			bw_osc_pulse_process_multi(&instance->vco3_pulse_coeffs, (const float **)b0, (const float **)b1, b0, N_VOICES, n);
+			bw_osc_pulse_process_multi(&instance->vco3_pulse_coeffs, (const float **)b0, (const float **)b1, b0, n_active, n);
 			bw_osc_tri_reset_coeffs(&instance->vco3_tri_coeffs);
 		} else {
-			bw_osc_saw_process_multi(&instance->vco_saw_coeffs, (const float **)b0, (const float **)b1, b0, N_VOICES, n);
+			bw_osc_saw_process_multi(&instance->vco_saw_coeffs, (const float **)b0, (const float **)b1, b0, n_active, n);
 			bw_osc_pulse_reset_coeffs(&instance->vco3_pulse_coeffs);
 			bw_osc_tri_reset_coeffs(&instance->vco3_tri_coeffs);
 		}
 		
-		bw_noise_gen_process_multi(&instance->noise_gen_coeffs, b1, N_VOICES, n);
+		bw_noise_gen_process_multi(&instance->noise_gen_coeffs, b1, n_active, n);
 		if (instance->params[p_noise_color] >= 0.5f)
-			bw_pink_filt_process_multi(&instance->pink_filt_coeffs, pink_filt_states, (const float **)b1, b1, N_VOICES, n);
+			bw_pink_filt_process_multi(&instance->pink_filt_coeffs, pink_filt_states, (const float **)b1, b1, n_active, n);
 		else
-			for (int j = 0; j < N_VOICES; j++)
+			for (int j = 0; j < n_active; j++)
 				bw_pink_filt_reset_state(&instance->pink_filt_coeffs, pink_filt_states[j], 0.f); // FIXME: calling this here is sloppy coding
-		bw_buf_scale_multi((const float * const *)b1, 5.f, b1, N_VOICES, n);
+		bw_buf_scale_multi((const float * const *)b1, 5.f, b1, n_active, n);
 		
 		float vcf_mod[N_VOICES];
-		for (int j = 0; j < N_VOICES; j++) {
+		for (int j = 0; j < n_active; j++) {
 			for (int k = 0; k < n; k++)
 				b2[j][k] = instance->mod_wheel * (b0[j][k] + instance->params[p_mod_mix] * (b1[j][k] - b0[j][k]));
 			vcf_mod[j] = vcf_mod_k * b2[j][0];
 		}
 		
-		for (int j = 0; j < N_VOICES; j++) {
+		for (int j = 0; j < n_active; j++) {
 			bw_buf_scale(b2[j], instance->params[p_vco1_mod], b3[j], n);
-			bw_phase_gen_process(&instance->voices[j].vco1_phase_gen_coeffs, &instance->voices[j].vco1_phase_gen_state, b3[j], b3[j], b4[j], n);
+			bw_phase_gen_process(&v[j]->vco1_phase_gen_coeffs, &v[j]->vco1_phase_gen_state, b3[j], b3[j], b4[j], n);
 		}
 		if (instance->params[p_vco1_waveform] >= (1.f / 4.f + 1.f / 2.f)) {
-			bw_osc_tri_process_multi(&instance->vco1_tri_coeffs, (const float **)b3, (const float **)b4, b3, N_VOICES, n);
+			bw_osc_tri_process_multi(&instance->vco1_tri_coeffs, (const float **)b3, (const float **)b4, b3, n_active, n);
 			bw_osc_pulse_reset_coeffs(&instance->vco1_pulse_coeffs);
 		} else if (instance->params[p_vco1_waveform] >= (1.f / 4.f)) {
-			bw_osc_pulse_process_multi(&instance->vco1_pulse_coeffs, (const float **)b3, (const float **)b4, b3, N_VOICES, n);
+			bw_osc_pulse_process_multi(&instance->vco1_pulse_coeffs, (const float **)b3, (const float **)b4, b3, n_active, n);
 			bw_osc_tri_reset_coeffs(&instance->vco1_tri_coeffs);
 		} else {
-			bw_osc_saw_process_multi(&instance->vco_saw_coeffs, (const float **)b3, (const float **)b4, b3, N_VOICES, n);
+			bw_osc_saw_process_multi(&instance->vco_saw_coeffs, (const float **)b3, (const float **)b4, b3, n_active, n);
 			bw_osc_pulse_reset_coeffs(&instance->vco1_pulse_coeffs);
 			bw_osc_tri_reset_coeffs(&instance->vco1_tri_coeffs);
 		}
 		
-		for (int j = 0; j < N_VOICES; j++) {
+		for (int j = 0; j < n_active; j++) {
 			bw_buf_scale(b2[j], instance->params[p_vco2_mod], b2[j], n);
-			bw_phase_gen_process(&instance->voices[j].vco2_phase_gen_coeffs, &instance->voices[j].vco2_phase_gen_state, b2[j], b2[j], b4[j], n);
+			bw_phase_gen_process(&v[j]->vco2_phase_gen_coeffs, &v[j]->vco2_phase_gen_state, b2[j], b2[j], b4[j], n);
 		}
 		if (instance->params[p_vco2_waveform] >= (1.f / 4.f + 1.f / 2.f)) {
-			bw_osc_tri_process_multi(&instance->vco2_tri_coeffs, (const float **)b2, (const float **)b4, b2, N_VOICES, n);
+			bw_osc_tri_process_multi(&instance->vco2_tri_coeffs, (const float **)b2, (const float **)b4, b2, n_active, n);
 			bw_osc_pulse_reset_coeffs(&instance->vco2_pulse_coeffs);
 		} else if (instance->params[p_vco2_waveform] >= (1.f / 4.f)) {
-			bw_osc_pulse_process_multi(&instance->vco2_pulse_coeffs, (const float **)b2, (const float **)b4, b2, N_VOICES, n);
+			bw_osc_pulse_process_multi(&instance->vco2_pulse_coeffs, (const float **)b2, (const float **)b4, b2, n_active, n);
 			bw_osc_tri_reset_coeffs(&instance->vco2_tri_coeffs);
 		} else {
-			bw_osc_saw_process_multi(&instance->vco_saw_coeffs, (const float **)b2, (const float **)b4, b2, N_VOICES, n);
+			bw_osc_saw_process_multi(&instance->vco_saw_coeffs, (const float **)b2, (const float **)b4, b2, n_active, n);
 			bw_osc_pulse_reset_coeffs(&instance->vco2_pulse_coeffs);
 			bw_osc_tri_reset_coeffs(&instance->vco2_tri_coeffs);
 		}
 		
-		bw_gain_process_multi(&instance->vco1_gain_coeffs, (const float **)b3, b3, N_VOICES, n);
-		bw_gain_process_multi(&instance->vco2_gain_coeffs, (const float **)b2, b2, N_VOICES, n);
-		bw_gain_process_multi(&instance->vco3_gain_coeffs, (const float **)b0, b0, N_VOICES, n);
-		bw_gain_process_multi(&instance->noise_gain_coeffs, (const float **)b1, b1, N_VOICES, n);
-		bw_buf_mix_multi((const float * const *)b0, (const float * const *)b2, b0, N_VOICES, n);
-		bw_buf_mix_multi((const float * const *)b0, (const float * const *)b3, b0, N_VOICES, n);
+		bw_gain_process_multi(&instance->vco1_gain_coeffs, (const float **)b3, b3, n_active, n);
+		bw_gain_process_multi(&instance->vco2_gain_coeffs, (const float **)b2, b2, n_active, n);
+		bw_gain_process_multi(&instance->vco3_gain_coeffs, (const float **)b0, b0, n_active, n);
+		bw_gain_process_multi(&instance->noise_gain_coeffs, (const float **)b1, b1, n_active, n);
+		bw_buf_mix_multi((const float * const *)b0, (const float * const *)b2, b0, n_active, n);
+		bw_buf_mix_multi((const float * const *)b0, (const float * const *)b3, b0, n_active, n);
 		
-		bw_osc_filt_process_multi(osc_filt_states, (const float **)b0, b0, N_VOICES, n);
+		bw_osc_filt_process_multi(osc_filt_states, (const float **)b0, b0, n_active, n);
 		
 		const float k = instance->params[p_noise_color] >= 0.5f
 			? 6.f * bw_noise_gen_get_scaling_k(&instance->noise_gen_coeffs) * bw_pink_filt_get_scaling_k(&instance->pink_filt_coeffs)
 			: 0.1f * bw_noise_gen_get_scaling_k(&instance->noise_gen_coeffs);
-		bw_buf_scale_multi((const float * const *)b1, k, b1, N_VOICES, n);
-		bw_buf_mix_multi((const float * const *)b0, (const float * const *)b1, b0, N_VOICES, n);
+		bw_buf_mac_multi((const float * const *)b1, k, b0, n_active, n);
 		
-		bw_env_gen_process_multi(&instance->vcf_env_gen_coeffs, vcf_env_gen_states, gates, NULL, N_VOICES, n);
-		for (int j = 0; j < N_VOICES; j++) {
-			float v = instance->params[p_vcf_cutoff] + instance->params[p_vcf_contour] * bw_env_gen_get_y_z1(vcf_env_gen_states[j]) + vcf_mod[j];
-			float cutoff = 20.f + (20e3f - 20.f) * v * v * v;
+		bw_env_gen_process_multi(&instance->vcf_env_gen_coeffs, vcf_env_gen_states, gates, NULL, n_active, n);
+		for (int j = 0; j < n_active; j++) {
+			float c = instance->params[p_vcf_cutoff] + instance->params[p_vcf_contour] * bw_env_gen_get_y_z1(vcf_env_gen_states[j]) + vcf_mod[j];
+			float cutoff = 20.f + (20e3f - 20.f) * c * c * c;
 			if (instance->params[p_vcf_kbd_ctrl] >= (1.f / 6.f + 2.f / 3.f))
-				cutoff *= bw_pow2f(8.333333333333333e-2f * (instance->voices[j].note - 60));
+				cutoff *= bw_pow2f(8.333333333333333e-2f * (v[j]->note - 60));
 			else if (instance->params[p_vcf_kbd_ctrl] >= (1.f / 6.f + 1.f / 3.f))
-				cutoff *= bw_pow2f((0.793700525984100f * 8.333333333333333e-2f) * (instance->voices[j].note - 60));
+				cutoff *= bw_pow2f((0.793700525984100f * 8.333333333333333e-2f) * (v[j]->note - 60));
 			else if (instance->params[p_vcf_kbd_ctrl] >= (1.f / 6.f + 2.f / 3.f))
-				cutoff *= bw_pow2f((0.629960524947437f * 8.333333333333333e-2f) * (instance->voices[j].note - 60));
+				cutoff *= bw_pow2f((0.629960524947437f * 8.333333333333333e-2f) * (v[j]->note - 60));
 			// otherwise no kbd control
-			bw_svf_set_cutoff(&instance->voices[j].vcf_coeffs, bw_clipf(cutoff, 20.f, 20e3f));
-			bw_svf_process(&instance->voices[j].vcf_coeffs, &instance->voices[j].vcf_state, b0[j], b0[j], NULL, NULL, n);
+			bw_svf_set_cutoff(&v[j]->vcf_coeffs, bw_clipf(cutoff, 20.f, 20e3f));
+			bw_svf_process(&v[j]->vcf_coeffs, &v[j]->vcf_state, b0[j], b0[j], NULL, NULL, n);
 		}
 		
-		bw_env_gen_process_multi(&instance->vca_env_gen_coeffs, vca_env_gen_states, gates, b1, N_VOICES, n);
-		bw_buf_mul_multi((const float * const *)b0, (const float * const *)b1, b0, N_VOICES, n);
+		bw_env_gen_process_multi(&instance->vca_env_gen_coeffs, vca_env_gen_states, gates, b1, n_active, n);
+		bw_buf_mul_multi((const float * const *)b0, (const float * const *)b1, b0, n_active, n);
 		
 		bw_buf_fill(0.f, out, n);
-		for (int j = 0; j < N_VOICES; j++)
+		for (int j = 0; j < n_active; j++)
 			bw_buf_mix(out, b0[j], out, n);
 		
 		bw_phase_gen_process(&instance->a440_phase_gen_coeffs, &instance->a440_phase_gen_state, NULL, instance->buf, NULL, n);
@@ -331,6 +327,10 @@ void bw_example_synth_poly_process(bw_example_synth_poly *instance, const float*
 		bw_gain_process(&instance->gain_coeffs, out, out, n);
 		bw_ppm_process(&instance->ppm_coeffs, &instance->ppm_state, out, NULL, n);
 	}
+
+	for (int j = 0; j < n_active; j++)
+		if (!v[j]->gate && bw_env_gen_get_phase(vca_env_gen_states[j]) == bw_env_gen_phase_off)
+			bw_voice_alloc_set_voice_free(&instance->voice_alloc_state, active[j]);
 }
 
 void bw_example_synth_poly_set_parameter(bw_example_synth_poly *instance, int index, float value) {
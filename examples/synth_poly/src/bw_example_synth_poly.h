@@ -24,6 +24,7 @@
 #include "platform.h"
 
 #include <bw_note_queue.h>
+#include <bw_voice_alloc.h>
 #include <bw_phase_gen.h>
 #include <bw_osc_saw.h>
 #include <bw_osc_pulse.h>
@@ -111,6 +112,7 @@ typedef struct _bw_example_synth_poly_voice bw_example_synth_poly_voice;
 struct _bw_example_synth_poly {
 	// Sub-components
 	bw_note_queue			note_queue;
+	bw_voice_alloc_state		voice_alloc_state;
 	bw_osc_saw_coeffs		vco_saw_coeffs;
 	bw_osc_pulse_coeffs		vco1_pulse_coeffs;
 	bw_osc_tri_coeffs		vco1_tri_coeffs;
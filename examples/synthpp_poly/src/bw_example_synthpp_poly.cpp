@@ -22,7 +22,6 @@
 
 #include <bw_math.h>
 #include <bw_buf.h>
-#include <bw_voice_alloc.h>
 
 void bw_example_synthpp_poly_init(bw_example_synthpp_poly *instance) {
 	instance->vco1OscSaw.setAntialiasing(true);
@@ -37,11 +36,6 @@ void bw_example_synthpp_poly_init(bw_example_synthpp_poly *instance) {
 	instance->a440PhaseGen.setFrequency(440.f);
 
 	instance->rand_state = 0xbaddecaf600dfeed;
-	
-	for (int i = 0; i < N_VOICES; i++) {
-		instance->voices[i].instance = instance;
-		instance->voices[i].index = i;
-	}
 }
 
 void bw_example_synthpp_poly_set_sample_rate(bw_example_synthpp_poly *instance, float sample_rate) {
@@ -81,6 +75,7 @@ void bw_example_synthpp_poly_reset(bw_example_synthpp_poly *instance) {
 		instance->voices[i].vcf.setCutoff(bw_clipf(cutoff, 20.f, 20e3f));
 
 	instance->noteQueue = NoteQueue();
+	instance->voiceAlloc.reset();
 	instance->vco1OscSaw.reset();
 	instance->vco1OscPulse.reset();
 	instance->vco1OscTri.reset();
@@ -116,28 +111,15 @@ void bw_example_synthpp_poly_reset(bw_example_synthpp_poly *instance) {
 	instance->mod_wheel = 0.f;
 }
 
-static void note_on(void *BW_RESTRICT voice, unsigned char note, float velocity) {
+void bw_example_synthpp_poly_voice::noteOn(unsigned char note, float velocity) {
 	(void)velocity;
-	bw_example_synthpp_poly_voice *v = (bw_example_synthpp_poly_voice *)voice;
-	v->note = note;
-	v->gate = 1;
+	this->note = note;
+	gate = 1;
 }
 
-static void note_off(void *BW_RESTRICT voice, float velocity) {
+void bw_example_synthpp_poly_voice::noteOff(float velocity) {
 	(void)velocity;
-	bw_example_synthpp_poly_voice *v = (bw_example_synthpp_poly_voice *)voice;
-	v->gate = 0;
-}
-
-static unsigned char get_note(const void *BW_RESTRICT voice) {
-	bw_example_synthpp_poly_voice *v = (bw_example_synthpp_poly_voice *)voice;
-	return v->note;
-}
-
-static char is_free(const void *BW_RESTRICT voice) {
-	bw_example_synthpp_poly_voice *v = (bw_example_synthpp_poly_voice *)voice;
-	bw_env_gen_phase phase = v->instance->vcaEnvGen.getPhase(v->index);
-	return !v->gate && phase == bw_env_gen_phase_off;
+	gate = 0;
 }
 
 void bw_example_synthpp_poly_process(bw_example_synthpp_poly *instance, const float** x, float** y, int n_samples) {
@@ -147,11 +129,7 @@ void bw_example_synthpp_poly_process(bw_example_synthpp_poly *instance, const fl
 	
 	(void)x;
 
-	static bw_voice_alloc_opts alloc_opts = { bw_voice_alloc_priority_low, note_on, note_off, get_note, is_free };
-	void *voices[N_VOICES];
-	for (int i = 0; i < N_VOICES; i++)
-		voices[i] = (void *)(instance->voices + i);
-	bw_voice_alloc(&alloc_opts, &instance->noteQueue.queue, voices, N_VOICES);
+	instance->voiceAlloc.process(instance->noteQueue, instance->voices);
 	instance->noteQueue.clear();
 	
 	const float df1 =
@@ -295,6 +273,10 @@ void bw_example_synthpp_poly_process(bw_example_synthpp_poly *instance, const fl
 		instance->gain.process({out}, {out}, n);
 		instance->ppm.process({out}, {nullptr}, n);
 	}
+
+	for (int j = 0; j < N_VOICES; j++)
+		if (!instance->voices[j].gate && instance->vcaEnvGen.getPhase(j) == bw_env_gen_phase_off)
+			instance->voiceAlloc.setVoiceFree(j);
 }
 
 void bw_example_synthpp_poly_set_parameter(bw_example_synthpp_poly *instance, int index, float value) {
@@ -24,6 +24,7 @@
 #include "platform.h"
 
 #include <bw_note_queue.h>
+#include <bw_voice_alloc.h>
 #include <bw_phase_gen.h>
 #include <bw_osc_saw.h>
 #include <bw_osc_pulse.h>
@@ -100,14 +101,15 @@ struct _bw_example_synthpp_poly_voice {
 
 	float			 buf[5][BUFFER_SIZE];
 
-	bw_example_synthpp_poly	*instance;
-	int			 index;
+	void noteOn(unsigned char note, float velocity);
+	void noteOff(float velocity);
 };
 typedef struct _bw_example_synthpp_poly_voice bw_example_synthpp_poly_voice;
 
 struct _bw_example_synthpp_poly {
 	// Sub-components
 	NoteQueue			noteQueue;
+	VoiceAlloc<N_VOICES>		voiceAlloc;
 	OscSaw<N_VOICES>		vco1OscSaw;
 	OscPulse<N_VOICES>		vco1OscPulse;
 	OscTri<N_VOICES>		vco1OscTri;
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_lp1 bw_math bw_one_pole }}}
  *  description {{{
  *    First-order allpass filter (90° shift at cutoff, approaching 180° shift
@@ -28,8 +28,13 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_ap1_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_ap1_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -208,6 +213,22 @@ static inline void bw_ap1_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_ap1_process_interleaved()
+ *  ```>>> */
+static inline void bw_ap1_process_interleaved(
+	bw_ap1_coeffs * BW_RESTRICT                    coeffs,
+	bw_ap1_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_ap1_set_cutoff()
  *  ```>>> */
 static inline void bw_ap1_set_cutoff(
@@ -246,6 +267,19 @@ static inline void bw_ap1_set_prewarp_freq(
  *
  *    Default value: `1e3f`.
  *
+ *    #### bw_ap1_set_profile_stats()
+ *  ```>>> */
+static inline void bw_ap1_set_profile_stats(
+	bw_ap1_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_ap1_process()`,
+ *    `bw_ap1_process_multi()`, and `bw_ap1_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_ap1_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_ap1_coeffs_is_valid(
@@ -305,6 +339,9 @@ struct bw_ap1_coeffs {
 	enum bw_ap1_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_lp1_coeffs			lp1_coeffs;
@@ -326,6 +363,9 @@ static inline void bw_ap1_init(
 
 	bw_lp1_init(&coeffs->lp1_coeffs);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_ap1_coeffs");
 	coeffs->state = bw_ap1_coeffs_state_init;
@@ -483,11 +523,13 @@ static inline void bw_ap1_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_ap1_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_ap1_update_coeffs_audio(coeffs);
 		y[i] = bw_ap1_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_ap1_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_reset_coeffs);
@@ -519,17 +561,53 @@ static inline void bw_ap1_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_ap1_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_ap1_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_ap1_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_ap1_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_ap1_process_interleaved(
+		bw_ap1_coeffs * BW_RESTRICT                    coeffs,
+		bw_ap1_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ap1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_ap1_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_ap1_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_ap1_process1(coeffs, state[j], x[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_ap1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
+}
+
 static inline void bw_ap1_set_cutoff(
 		bw_ap1_coeffs * BW_RESTRICT coeffs,
 		float                       value) {
@@ -573,6 +651,24 @@ static inline void bw_ap1_set_prewarp_freq(
 	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_init);
 }
 
+static inline void bw_ap1_set_profile_stats(
+		bw_ap1_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ap1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_ap1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ap1_coeffs_state_init);
+}
+
 static inline char bw_ap1_coeffs_is_valid(
 		const bw_ap1_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -649,6 +745,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -657,6 +758,9 @@ public:
 
 	void setPrewarpFreq(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -737,6 +841,14 @@ inline void AP1<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void AP1<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_ap1_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void AP1<N_CHANNELS>::setCutoff(
 		float value) {
@@ -755,6 +867,12 @@ inline void AP1<N_CHANNELS>::setPrewarpFreq(
 	bw_ap1_set_prewarp_freq(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void AP1<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_ap1_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
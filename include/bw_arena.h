@@ -0,0 +1,426 @@
+/*
+ * Brickworks
+ *
+ * Copyright (C) 2024 Orastron Srl unipersonale
+ *
+ * Brickworks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Brickworks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Brickworks.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File author: agent
+ */
+
+/*!
+ *  module_type {{{ utility }}}
+ *  version {{{ 1.1.0 }}}
+ *  requires {{{ bw_common }}}
+ *  description {{{
+ *    Linear memory arena that lays out the memory blocks needed by many
+ *    module instances (see `bw_*_mem_req()` and `bw_*_mem_set()`) into a
+ *    single contiguous memory region.
+ *
+ *    It is used in two phases: first the memory requirements of all instances
+ *    are collected (planning), then the region is associated and sliced in the
+ *    same order. For example:
+ *
+ *    ```
+ *    bw_arena arena;
+ *    bw_arena_init(&arena);
+ *    bw_arena_plan(&arena, bw_delay_mem_req(&delay_coeffs));
+ *    bw_arena_plan(&arena, bw_reverb_mem_req(&reverb_coeffs));
+ *
+ *    void *mem = malloc(bw_arena_get_mem_req(&arena));
+ *    bw_arena_mem_set(&arena, mem);
+ *
+ *    bw_delay_mem_set(&delay_coeffs, &delay_state,
+ *      bw_arena_alloc(&arena, bw_delay_mem_req(&delay_coeffs)));
+ *    bw_reverb_mem_set(&reverb_coeffs, &reverb_state,
+ *      bw_arena_alloc(&arena, bw_reverb_mem_req(&reverb_coeffs)));
+ *    ```
+ *
+ *    Each slice starts at an address that is a multiple of `BW_ARENA_ALIGN`,
+ *    whatever the alignment of the associated region. This module does not
+ *    allocate memory by itself, hence statically-allocated buffers can be
+ *    used just as well.
+ *  }}}
+ *  changelog {{{
+ *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>First release.</li>
+ *        </ul>
+ *      </li>
+ *    </ul>
+ *  }}}
+ */
+
+#ifndef BW_ARENA_H
+#define BW_ARENA_H
+
+#include <bw_common.h>
+
+/*! ...
+ *
+ *    #### BW_ARENA_ALIGN
+ *
+ *    `BW_ARENA_ALIGN` is the alignment of memory slices in bytes.
+ *
+ *    If it is not defined already, then it gets defined as `64`, which matches
+ *    the typical cache line size. Its value must be a power of `2`.
+ *
+ *  >>> */
+#ifndef BW_ARENA_ALIGN
+# define BW_ARENA_ALIGN 64
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*** Public API ***/
+
+/*! api {{{
+ *    #### bw_arena
+ *  ```>>> */
+typedef struct {
+	size_t	size;
+	size_t	used;
+	char *	mem;
+} bw_arena;
+/*! <<<```
+ *    Memory arena:
+ *     * `size`: total size of all planned slices in bytes, including padding;
+ *     * `used`: number of bytes handed out since the memory region was
+ *       associated or the arena was last rewound;
+ *     * `mem`: aligned start of the associated memory region, or `BW_NULL`
+ *       if none.
+ *
+ *    #### bw_arena_init()
+ *  ```>>> */
+static inline void bw_arena_init(
+	bw_arena * BW_RESTRICT arena);
+/*! <<<```
+ *    Initializes `arena` as empty (no planned slices) and with no associated
+ *    memory region.
+ *
+ *    #### bw_arena_plan()
+ *  ```>>> */
+static inline void bw_arena_plan(
+	bw_arena * BW_RESTRICT arena,
+	size_t                 size);
+/*! <<<```
+ *    Adds a slice of `size` bytes to the planned layout of `arena`.
+ *
+ *    It must not be called after `bw_arena_mem_set()` unless `bw_arena_init()`
+ *    is called again.
+ *
+ *    #### bw_arena_get_mem_req()
+ *  ```>>> */
+static inline size_t bw_arena_get_mem_req(
+	const bw_arena * BW_RESTRICT arena);
+/*! <<<```
+ *    Returns the size, in bytes, of the memory region required to hold all
+ *    slices planned in `arena`, including the slack needed to align a region
+ *    with arbitrary alignment.
+ *
+ *    #### bw_arena_mem_set()
+ *  ```>>> */
+static inline void bw_arena_mem_set(
+	bw_arena * BW_RESTRICT arena,
+	void * BW_RESTRICT     mem);
+/*! <<<```
+ *    Associates the memory region `mem` to `arena` and rewinds it.
+ *
+ *    `mem` must point to a memory region of at least
+ *    `bw_arena_get_mem_req(arena)` bytes, which must remain valid as long as
+ *    any slice obtained from `arena` is in use.
+ *
+ *    #### bw_arena_alloc()
+ *  ```>>> */
+static inline void * bw_arena_alloc(
+	bw_arena * BW_RESTRICT arena,
+	size_t                 size);
+/*! <<<```
+ *    Returns the next slice of `size` bytes from `arena`, aligned to
+ *    `BW_ARENA_ALIGN` bytes.
+ *
+ *    Slices must be requested in the same order and with the same sizes as
+ *    they were planned via `bw_arena_plan()`, or in any case so that their
+ *    total padded size does not exceed what was planned.
+ *
+ *    #### bw_arena_rewind()
+ *  ```>>> */
+static inline void bw_arena_rewind(
+	bw_arena * BW_RESTRICT arena);
+/*! <<<```
+ *    Makes the whole memory region associated to `arena` available again, so
+ *    that the same layout can be handed out once more (e.g., when memory
+ *    blocks need to be reassociated after changing the sample rate).
+ *
+ *    Slices previously obtained from `arena` must not be used anymore.
+ *
+ *    #### bw_arena_get_size()
+ *  ```>>> */
+static inline size_t bw_arena_get_size(
+	const bw_arena * BW_RESTRICT arena);
+/*! <<<```
+ *    Returns the total footprint, in bytes, of all slices planned in `arena`,
+ *    including padding between slices but excluding alignment slack.
+ *
+ *    #### bw_arena_get_used()
+ *  ```>>> */
+static inline size_t bw_arena_get_used(
+	const bw_arena * BW_RESTRICT arena);
+/*! <<<```
+ *    Returns the number of bytes, including padding, handed out by `arena`
+ *    since the memory region was associated or the arena was last rewound.
+ *
+ *    #### bw_arena_is_valid()
+ *  ```>>> */
+static inline char bw_arena_is_valid(
+	const bw_arena * BW_RESTRICT arena);
+/*! <<<```
+ *    Tries to determine whether `arena` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    `arena` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_arena`.
+ *  }}} */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline size_t bw_arena_do_pad(
+		size_t size) {
+	return (size + (BW_ARENA_ALIGN - 1)) & ~((size_t)BW_ARENA_ALIGN - 1);
+}
+
+static inline void bw_arena_init(
+		bw_arena * BW_RESTRICT arena) {
+	BW_ASSERT(arena != BW_NULL);
+	arena->size = 0;
+	arena->used = 0;
+	arena->mem = BW_NULL;
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+}
+
+static inline void bw_arena_plan(
+		bw_arena * BW_RESTRICT arena,
+		size_t                 size) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+	BW_ASSERT(arena->mem == BW_NULL);
+	BW_ASSERT(bw_arena_do_pad(size) >= size);
+
+	arena->size += bw_arena_do_pad(size);
+
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+}
+
+static inline size_t bw_arena_get_mem_req(
+		const bw_arena * BW_RESTRICT arena) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+
+	return arena->size + (BW_ARENA_ALIGN - 1);
+}
+
+static inline void bw_arena_mem_set(
+		bw_arena * BW_RESTRICT arena,
+		void * BW_RESTRICT     mem) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+	BW_ASSERT(mem != BW_NULL);
+
+	const size_t off = (size_t)((uintptr_t)mem & (BW_ARENA_ALIGN - 1));
+	arena->mem = (char *)mem + (off != 0 ? BW_ARENA_ALIGN - off : 0);
+	arena->used = 0;
+
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+}
+
+static inline void * bw_arena_alloc(
+		bw_arena * BW_RESTRICT arena,
+		size_t                 size) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+	BW_ASSERT(arena->mem != BW_NULL);
+	BW_ASSERT(bw_arena_do_pad(size) <= arena->size - arena->used);
+
+	void *ret = arena->mem + arena->used;
+	arena->used += bw_arena_do_pad(size);
+
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+
+	return ret;
+}
+
+static inline void bw_arena_rewind(
+		bw_arena * BW_RESTRICT arena) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+	BW_ASSERT(arena->mem != BW_NULL);
+
+	arena->used = 0;
+
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+}
+
+static inline size_t bw_arena_get_size(
+		const bw_arena * BW_RESTRICT arena) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+
+	return arena->size;
+}
+
+static inline size_t bw_arena_get_used(
+		const bw_arena * BW_RESTRICT arena) {
+	BW_ASSERT(arena != BW_NULL);
+	BW_ASSERT_DEEP(bw_arena_is_valid(arena));
+
+	return arena->used;
+}
+
+static inline char bw_arena_is_valid(
+		const bw_arena * BW_RESTRICT arena) {
+	BW_ASSERT(arena != BW_NULL);
+
+	if ((BW_ARENA_ALIGN & (BW_ARENA_ALIGN - 1)) != 0)
+		return 0;
+	if (arena->size & (BW_ARENA_ALIGN - 1) || arena->used & (BW_ARENA_ALIGN - 1))
+		return 0;
+	if (arena->used > arena->size)
+		return 0;
+	if (arena->mem == BW_NULL)
+		return arena->used == 0;
+	return ((uintptr_t)arena->mem & (BW_ARENA_ALIGN - 1)) == 0;
+}
+
+#ifdef __cplusplus
+}
+
+namespace Brickworks {
+
+/*** Public C++ API ***/
+
+/*! api_cpp {{{
+ *    ##### Brickworks::Arena
+ *  ```>>> */
+class Arena {
+public:
+	Arena();
+
+	~Arena();
+
+	Arena(const Arena &) = delete;
+	Arena & operator=(const Arena &) = delete;
+
+	void plan(
+		size_t size);
+
+	size_t getMemReq();
+
+	void setMemory(
+		void * BW_RESTRICT memory);
+
+	void allocateMemory();
+
+	void * alloc(
+		size_t size);
+
+	void rewind();
+
+	size_t getSize();
+
+	size_t getUsed();
+/*! <<<...
+ *  }
+ *  ```
+ *
+ *    `setMemory()` associates a caller-owned memory region (e.g., a static
+ *    buffer), while `allocateMemory()` allocates a memory region of the
+ *    required size which is owned and later released by the object.
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+private:
+	bw_arena		arena;
+	void * BW_RESTRICT	mem;
+};
+
+inline Arena::Arena() {
+	bw_arena_init(&arena);
+	mem = nullptr;
+}
+
+inline Arena::~Arena() {
+	if (mem != nullptr)
+		operator delete(mem);
+}
+
+inline void Arena::plan(
+		size_t size) {
+	bw_arena_plan(&arena, size);
+}
+
+inline size_t Arena::getMemReq() {
+	return bw_arena_get_mem_req(&arena);
+}
+
+inline void Arena::setMemory(
+		void * BW_RESTRICT memory) {
+	bw_arena_mem_set(&arena, memory);
+}
+
+inline void Arena::allocateMemory() {
+	if (mem != nullptr)
+		operator delete(mem);
+	mem = operator new(bw_arena_get_mem_req(&arena));
+	bw_arena_mem_set(&arena, mem);
+}
+
+inline void * Arena::alloc(
+		size_t size) {
+	return bw_arena_alloc(&arena, size);
+}
+
+inline void Arena::rewind() {
+	bw_arena_rewind(&arena);
+}
+
+inline size_t Arena::getSize() {
+	return bw_arena_get_size(&arena);
+}
+
+inline size_t Arena::getUsed() {
+	return bw_arena_get_used(&arena);
+}
+
+}
+#endif
+
+#endif
@@ -20,15 +20,23 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_one_pole }}}
  *  description {{{
  *    Stereo balance.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_balance_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_balance_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li><code>bw_balance_process()</code> and
+ *              <code>bw_balance_process_multi()</code> now use a faster code
+ *              path when gain smoothing has settled.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -166,6 +174,23 @@ static inline void bw_balance_process_multi(
  *    `n_channels` output buffers `y_l` (left) and `y_r` (right), while using
  *    and updating the common `coeffs` (control and audio rate).
  *
+ *    #### bw_balance_process_interleaved()
+ *  ```>>> */
+static inline void bw_balance_process_interleaved(
+	bw_balance_coeffs * BW_RESTRICT coeffs,
+	const float *                   x_l,
+	const float *                   x_r,
+	float *                         y_l,
+	float *                         y_r,
+	size_t                          n_channels,
+	size_t                          n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffers
+ *    `x_l` (left) and `x_r` (right) and fills the first `n_frames` frames of
+ *    the interleaved output buffers `y_l` (left) and `y_r` (right), all made of
+ *    `n_channels` channels, while using and updating the common `coeffs`
+ *    (control and audio rate).
+ *
  *    #### bw_balance_set_balance()
  *  ```>>> */
 static inline void bw_balance_set_balance(
@@ -179,6 +204,20 @@ static inline void bw_balance_set_balance(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_balance_set_profile_stats()
+ *  ```>>> */
+static inline void bw_balance_set_profile_stats(
+	bw_balance_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *              stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_balance_process()`,
+ *    `bw_balance_process_multi()`, and `bw_balance_process_interleaved()`
+ *    update when using `coeffs` if `BW_PROFILE` is defined (see
+ *    [bw_common](bw_common)). If `stats` is `BW_NULL`, no profiling takes
+ *    place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_balance_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_balance_coeffs_is_valid(
@@ -222,11 +261,17 @@ struct bw_balance_coeffs {
 	uint32_t			hash;
 	enum bw_balance_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_gain_coeffs			l_coeffs;
 	bw_gain_coeffs			r_coeffs;
 
+	// Coefficients
+	char				settled;
+
 	// Parameters
 	float				balance;
 	float				balance_prev;
@@ -240,6 +285,9 @@ static inline void bw_balance_init(
 	bw_gain_init(&coeffs->r_coeffs);
 	coeffs->balance = 0.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_balance_coeffs");
 	coeffs->state = bw_balance_coeffs_state_init;
@@ -285,6 +333,7 @@ static inline void bw_balance_reset_coeffs(
 	bw_balance_do_update_coeffs(coeffs, 1);
 	bw_gain_reset_coeffs(&coeffs->l_coeffs);
 	bw_gain_reset_coeffs(&coeffs->r_coeffs);
+	coeffs->settled = 1;
 
 #ifdef BW_DEBUG_DEEP
 	coeffs->state = bw_balance_coeffs_state_reset_coeffs;
@@ -302,6 +351,10 @@ static inline void bw_balance_update_coeffs_ctrl(
 	bw_balance_do_update_coeffs(coeffs, 0);
 	bw_gain_update_coeffs_ctrl(&coeffs->l_coeffs);
 	bw_gain_update_coeffs_ctrl(&coeffs->r_coeffs);
+	// once both gains have reached their targets, update_coeffs_audio() is a
+	// no-op until the balance is changed again
+	coeffs->settled = bw_gain_get_gain_cur(&coeffs->l_coeffs) == bw_gain_get_gain_lin(&coeffs->l_coeffs)
+		&& bw_gain_get_gain_cur(&coeffs->r_coeffs) == bw_gain_get_gain_lin(&coeffs->r_coeffs);
 
 	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_reset_coeffs);
@@ -360,11 +413,23 @@ static inline void bw_balance_process(
 	BW_ASSERT(y_r != BW_NULL);
 	BW_ASSERT(y_l != y_r);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_balance_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_balance_update_coeffs_audio(coeffs);
-		bw_balance_process1(coeffs, x_l[i], x_r[i], y_l + i, y_r + i);
-	}
+	if (coeffs->settled) {
+		const float g_l = bw_gain_get_gain_cur(&coeffs->l_coeffs);
+		const float g_r = bw_gain_get_gain_cur(&coeffs->r_coeffs);
+		for (size_t i = 0; i < n_samples; i++) {
+			const float v_l = x_l[i];
+			const float v_r = x_r[i];
+			y_l[i] = g_l * v_l;
+			y_r[i] = g_r * v_r;
+		}
+	} else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_balance_update_coeffs_audio(coeffs);
+			bw_balance_process1(coeffs, x_l[i], x_r[i], y_l + i, y_r + i);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_reset_coeffs);
@@ -399,17 +464,75 @@ static inline void bw_balance_process_multi(
 			BW_ASSERT(y_l[i] != y_r[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_balance_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_balance_update_coeffs_audio(coeffs);
+	if (coeffs->settled) {
+		const float g_l = bw_gain_get_gain_cur(&coeffs->l_coeffs);
+		const float g_r = bw_gain_get_gain_cur(&coeffs->r_coeffs);
 		for (size_t j = 0; j < n_channels; j++)
-			bw_balance_process1(coeffs, x_l[j][i], x_r[j][i], y_l[j] + i, y_r[j] + i);
-	}
+			for (size_t i = 0; i < n_samples; i++) {
+				const float v_l = x_l[j][i];
+				const float v_r = x_r[j][i];
+				y_l[j][i] = g_l * v_l;
+				y_r[j][i] = g_r * v_r;
+			}
+	} else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_balance_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++)
+				bw_balance_process1(coeffs, x_l[j][i], x_r[j][i], y_l[j] + i, y_r[j] + i);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_balance_process_interleaved(
+		bw_balance_coeffs * BW_RESTRICT coeffs,
+		const float *                   x_l,
+		const float *                   x_r,
+		float *                         y_l,
+		float *                         y_r,
+		size_t                          n_channels,
+		size_t                          n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_reset_coeffs);
+	BW_ASSERT(x_l != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x_l, n_channels * n_frames));
+	BW_ASSERT(x_r != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x_r, n_channels * n_frames));
+	BW_ASSERT(y_l != BW_NULL);
+	BW_ASSERT(y_r != BW_NULL);
+	BW_ASSERT(y_l != y_r);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_balance_update_coeffs_ctrl(coeffs);
+	if (coeffs->settled) {
+		const float g_l = bw_gain_get_gain_cur(&coeffs->l_coeffs);
+		const float g_r = bw_gain_get_gain_cur(&coeffs->r_coeffs);
+		const size_t n = n_channels * n_frames;
+		for (size_t i = 0; i < n; i++) {
+			const float v_l = x_l[i];
+			const float v_r = x_r[i];
+			y_l[i] = g_l * v_l;
+			y_r[i] = g_r * v_r;
+		}
+	} else
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_balance_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				bw_balance_process1(coeffs, x_l[k], x_r[k], y_l + k, y_r + k);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y_l, n_channels * n_frames));
+	BW_ASSERT_DEEP(bw_has_only_finite(y_r, n_channels * n_frames));
+}
+
 static inline void bw_balance_set_balance(
 		bw_balance_coeffs * BW_RESTRICT coeffs,
 		float                           value) {
@@ -425,6 +548,24 @@ static inline void bw_balance_set_balance(
 	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_init);
 }
 
+static inline void bw_balance_set_profile_stats(
+		bw_balance_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *              stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_balance_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_balance_coeffs_state_init);
+}
+
 static inline char bw_balance_coeffs_is_valid(
 		const bw_balance_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -485,8 +626,18 @@ public:
 		std::array<float *, N_CHANNELS>       yR,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * xL,
+		const float * xR,
+		float *       yL,
+		float *       yR,
+		size_t        nFrames);
+
 	void setBalance(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -537,12 +688,28 @@ inline void Balance<N_CHANNELS>::process(
 	process(xL.data(), xR.data(), yL.data(), yR.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void Balance<N_CHANNELS>::processInterleaved(
+		const float * xL,
+		const float * xR,
+		float *       yL,
+		float *       yR,
+		size_t        nFrames) {
+	bw_balance_process_interleaved(&coeffs, xL, xR, yL, yR, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void Balance<N_CHANNELS>::setBalance(
 		float value) {
 	bw_balance_set_balance(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Balance<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_balance_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
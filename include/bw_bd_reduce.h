@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    Bit depth reducer.
@@ -31,8 +31,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_bd_reduce_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -175,6 +178,19 @@ static inline void bw_bd_reduce_set_bit_depth(
  *
  *    Default value: `16`.
  *
+ *    #### bw_bd_reduce_set_profile_stats()
+ *  ```>>> */
+static inline void bw_bd_reduce_set_profile_stats(
+	bw_bd_reduce_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_bd_reduce_process()` and
+ *    `bw_bd_reduce_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_bd_reduce_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_bd_reduce_coeffs_is_valid(
@@ -217,6 +233,9 @@ struct bw_bd_reduce_coeffs {
 	uint32_t			hash;
 	enum bw_bd_reduce_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	float				ki;
@@ -234,6 +253,9 @@ static inline void bw_bd_reduce_init(
 
 	coeffs->bit_depth = 16;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_bd_reduce_coeffs");
 	coeffs->state = bw_bd_reduce_coeffs_state_init;
@@ -336,9 +358,11 @@ static inline void bw_bd_reduce_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_bd_reduce_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++)
 		y[i] = bw_bd_reduce_process1(coeffs, x[i]);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_bd_reduce_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_bd_reduce_coeffs_state_reset_coeffs);
@@ -362,10 +386,12 @@ static inline void bw_bd_reduce_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_bd_reduce_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++)
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_bd_reduce_process1(coeffs, x[j][i]);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_bd_reduce_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_bd_reduce_coeffs_state_reset_coeffs);
@@ -385,6 +411,24 @@ static inline void bw_bd_reduce_set_bit_depth(
 	BW_ASSERT_DEEP(coeffs->state >= bw_bd_reduce_coeffs_state_init);
 }
 
+static inline void bw_bd_reduce_set_profile_stats(
+		bw_bd_reduce_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_bd_reduce_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_bd_reduce_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_bd_reduce_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_bd_reduce_coeffs_state_init);
+}
+
 static inline char bw_bd_reduce_coeffs_is_valid(
 		const bw_bd_reduce_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -449,6 +493,9 @@ public:
 
 	void setBitDepth(
 		char value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -501,6 +548,12 @@ inline void BDReduce<N_CHANNELS>::setBitDepth(
 	bw_bd_reduce_set_bit_depth(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void BDReduce<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_bd_reduce_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,15 +20,22 @@
 
 /*!
  *  module_type {{{ utility }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common }}}
  *  description {{{
  *    Common operations on buffers.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_buf_copy()</code>, <code>bw_buf_mac()</code>,
+ *              <code>bw_buf_scale_ramp()</code>,
+ *              <code>bw_buf_interleave()</code>,
+ *              <code>bw_buf_deinterleave()</code>,
+ *              <code>bw_buf_peak()</code>, <code>bw_buf_sum_sq()</code>,
+ *              <code>bw_buf_flush_denormals()</code>, their
+ *              <code>_multi</code> counterparts, and related C++ API.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -151,6 +158,109 @@ static inline void bw_buf_mul(
  *    Multiplies the first `n_elems` of `src1` and `src2` and stores the results
  *    in the first `n_elems` of `dest`.
  *
+ *    #### bw_buf_copy()
+ *  ```>>> */
+static inline void bw_buf_copy(
+	const float * BW_RESTRICT src,
+	float * BW_RESTRICT       dest,
+	size_t                    n_elems);
+/*! <<<```
+ *    Copies the first `n_elems` in `src` into the first `n_elems` of `dest`.
+ *
+ *    `src` and `dest` must not overlap.
+ *
+ *    #### bw_buf_mac()
+ *  ```>>> */
+static inline void bw_buf_mac(
+	const float * src,
+	float         k,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Multiplies the first `n_elems` in `src` by `k` and adds the results to the
+ *    first `n_elems` of `dest` (i.e., `dest[i] += k * src[i]`).
+ *
+ *    #### bw_buf_scale_ramp()
+ *  ```>>> */
+static inline void bw_buf_scale_ramp(
+	const float * src,
+	float         k_start,
+	float         k_end,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Multiplies the first `n_elems` in `src` by a gain that linearly goes from
+ *    `k_start` towards `k_end` and stores the results in the first `n_elems` of
+ *    `dest`.
+ *
+ *    The first element is multiplied by `k_start`, while `k_end` is the gain
+ *    that would be applied to the element right after the last one, so that a
+ *    following call starting from `k_end` continues the ramp seamlessly.
+ *
+ *    #### bw_buf_interleave()
+ *  ```>>> */
+static inline void bw_buf_interleave(
+	const float * const * src,
+	float * BW_RESTRICT   dest,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Interleaves the first `n_elems` in each of the `n_channels` buffers `src`
+ *    into the first `n_channels * n_elems` of `dest` (i.e.,
+ *    `dest[n_channels * i + j] = src[j][i]`).
+ *
+ *    The cases where `n_channels` is `2`, `4`, or `8` are especially
+ *    optimized.
+ *
+ *    `dest` must not overlap with any of the `src` buffers.
+ *
+ *    #### bw_buf_deinterleave()
+ *  ```>>> */
+static inline void bw_buf_deinterleave(
+	const float * BW_RESTRICT src,
+	float * const *           dest,
+	size_t                    n_channels,
+	size_t                    n_elems);
+/*! <<<```
+ *    Deinterleaves the first `n_channels * n_elems` in `src` into the first
+ *    `n_elems` in each of the `n_channels` buffers `dest` (i.e.,
+ *    `dest[j][i] = src[n_channels * i + j]`).
+ *
+ *    The cases where `n_channels` is `2`, `4`, or `8` are especially
+ *    optimized.
+ *
+ *    `src` must not overlap with any of the `dest` buffers.
+ *
+ *    #### bw_buf_peak()
+ *  ```>>> */
+static inline float bw_buf_peak(
+	const float * src,
+	size_t        n_elems);
+/*! <<<```
+ *    Returns the maximum absolute value among the first `n_elems` in `src`, or
+ *    `0.f` if `n_elems` is `0`.
+ *
+ *    #### bw_buf_sum_sq()
+ *  ```>>> */
+static inline float bw_buf_sum_sq(
+	const float * src,
+	size_t        n_elems);
+/*! <<<```
+ *    Returns the sum of the squares of the first `n_elems` in `src`.
+ *
+ *    Partial sums are accumulated in a different order than a plain loop would,
+ *    hence the result may differ slightly from that of naive summation.
+ *
+ *    #### bw_buf_flush_denormals()
+ *  ```>>> */
+static inline void bw_buf_flush_denormals(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Replaces denormals (and negative zeros) in the first `n_elems` in `src`
+ *    with `0.f` and stores the results in the first `n_elems` of `dest`.
+ *
  *    #### bw_buf_fill_multi()
  *  ```>>> */
 static inline void bw_buf_fill_multi(
@@ -225,6 +335,83 @@ static inline void bw_buf_mul_multi(
  *    Multiplies the first `n_elems` in each of the `n_channels` buffers `src1`
  *    and `src2` and stores the results in the first `n_elems` in each of the
  *    `n_channels` buffers `dest`.
+ *
+ *    #### bw_buf_copy_multi()
+ *  ```>>> */
+static inline void bw_buf_copy_multi(
+	const float * const * src,
+	float * const *       dest,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Copies the first `n_elems` in each of the `n_channels` buffers `src` into
+ *    the first `n_elems` in each of the `n_channels` buffers `dest`.
+ *
+ *    No `dest` buffer must overlap with any `src` buffer.
+ *
+ *    #### bw_buf_mac_multi()
+ *  ```>>> */
+static inline void bw_buf_mac_multi(
+	const float * const * src,
+	float                 k,
+	float * const *       dest,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Multiplies the first `n_elems` in each of the `n_channels` buffers `src`
+ *    by `k` and adds the results to the first `n_elems` in each of the
+ *    `n_channels` buffers `dest`.
+ *
+ *    #### bw_buf_scale_ramp_multi()
+ *  ```>>> */
+static inline void bw_buf_scale_ramp_multi(
+	const float * const * src,
+	float                 k_start,
+	float                 k_end,
+	float * const *       dest,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Multiplies the first `n_elems` in each of the `n_channels` buffers `src`
+ *    by a gain that linearly goes from `k_start` towards `k_end` (as in
+ *    `bw_buf_scale_ramp()`) and stores the results in the first `n_elems` in
+ *    each of the `n_channels` buffers `dest`.
+ *
+ *    #### bw_buf_peak_multi()
+ *  ```>>> */
+static inline void bw_buf_peak_multi(
+	const float * const * src,
+	float *               peak,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Computes the maximum absolute value among the first `n_elems` in each of
+ *    the `n_channels` buffers `src` and stores the results in the first
+ *    `n_channels` of `peak`.
+ *
+ *    #### bw_buf_sum_sq_multi()
+ *  ```>>> */
+static inline void bw_buf_sum_sq_multi(
+	const float * const * src,
+	float *               sum_sq,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Computes the sum of the squares of the first `n_elems` in each of the
+ *    `n_channels` buffers `src` and stores the results in the first
+ *    `n_channels` of `sum_sq`.
+ *
+ *    #### bw_buf_flush_denormals_multi()
+ *  ```>>> */
+static inline void bw_buf_flush_denormals_multi(
+	const float * const * src,
+	float * const *       dest,
+	size_t                n_channels,
+	size_t                n_elems);
+/*! <<<```
+ *    Replaces denormals (and negative zeros) in the first `n_elems` in each of
+ *    the `n_channels` buffers `src` with `0.f` and stores the results in the
+ *    first `n_elems` in each of the `n_channels` buffers `dest`.
  *  }}} */
 
 #ifdef __cplusplus
@@ -333,6 +520,211 @@ static inline void bw_buf_mul(
 	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
 }
 
+static inline void bw_buf_copy(
+		const float * BW_RESTRICT src,
+		float * BW_RESTRICT       dest,
+		size_t                    n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_elems));
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++)
+		dest[i] = src[i];
+
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
+}
+
+static inline void bw_buf_mac(
+		const float * src,
+		float         k,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_elems));
+	BW_ASSERT(!bw_is_nan(k));
+	BW_ASSERT(dest != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
+
+	for (size_t i = 0; i < n_elems; i++)
+		dest[i] += k * src[i];
+
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
+}
+
+static inline void bw_buf_scale_ramp(
+		const float * src,
+		float         k_start,
+		float         k_end,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_elems));
+	BW_ASSERT(bw_is_finite(k_start));
+	BW_ASSERT(bw_is_finite(k_end));
+	BW_ASSERT(dest != BW_NULL);
+
+	if (n_elems == 0)
+		return;
+	// computing each gain from scratch avoids accumulating rounding errors
+	// and makes the loop vectorizable
+	const float k_inc = (k_end - k_start) / (float)n_elems;
+	for (size_t i = 0; i < n_elems; i++)
+		dest[i] = (k_start + k_inc * (float)i) * src[i];
+
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
+}
+
+static inline void bw_buf_do_interleave(
+		const float * const * src,
+		float * BW_RESTRICT   dest,
+		size_t                n_channels,
+		size_t                n_elems) {
+	for (size_t i = 0; i < n_elems; i++)
+		for (size_t j = 0; j < n_channels; j++)
+			dest[n_channels * i + j] = src[j][i];
+}
+
+static inline void bw_buf_interleave(
+		const float * const * src,
+		float * BW_RESTRICT   dest,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++) {
+		BW_ASSERT(src[i] != BW_NULL);
+		BW_ASSERT_DEEP(!bw_has_nan(src[i], n_elems));
+	}
+#endif
+	BW_ASSERT(dest != BW_NULL);
+
+	// constant channel counts let the compiler unroll and vectorize
+	switch (n_channels) {
+	case 2:
+		bw_buf_do_interleave(src, dest, 2, n_elems);
+		break;
+	case 4:
+		bw_buf_do_interleave(src, dest, 4, n_elems);
+		break;
+	case 8:
+		bw_buf_do_interleave(src, dest, 8, n_elems);
+		break;
+	default:
+		bw_buf_do_interleave(src, dest, n_channels, n_elems);
+		break;
+	}
+
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_channels * n_elems));
+}
+
+static inline void bw_buf_do_deinterleave(
+		const float * BW_RESTRICT src,
+		float * const *           dest,
+		size_t                    n_channels,
+		size_t                    n_elems) {
+	for (size_t i = 0; i < n_elems; i++)
+		for (size_t j = 0; j < n_channels; j++)
+			dest[j][i] = src[n_channels * i + j];
+}
+
+static inline void bw_buf_deinterleave(
+		const float * BW_RESTRICT src,
+		float * const *           dest,
+		size_t                    n_channels,
+		size_t                    n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_channels * n_elems));
+	BW_ASSERT(dest != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++) {
+		BW_ASSERT(dest[i] != BW_NULL);
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(dest[i] != dest[j]);
+	}
+#endif
+
+	switch (n_channels) {
+	case 2:
+		bw_buf_do_deinterleave(src, dest, 2, n_elems);
+		break;
+	case 4:
+		bw_buf_do_deinterleave(src, dest, 4, n_elems);
+		break;
+	case 8:
+		bw_buf_do_deinterleave(src, dest, 8, n_elems);
+		break;
+	default:
+		bw_buf_do_deinterleave(src, dest, n_channels, n_elems);
+		break;
+	}
+
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		BW_ASSERT_DEEP(!bw_has_nan(dest[i], n_elems));
+#endif
+}
+
+static inline float bw_buf_peak(
+		const float * src,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_elems));
+
+	// the bit patterns of non-negative floats are ordered like their values,
+	// hence an integer max reduction does the job and vectorizes easily
+	uint32_t m = 0;
+	for (size_t i = 0; i < n_elems; i++) {
+		union { float f; uint32_t u; } v;
+		v.f = src[i];
+		const uint32_t a = v.u & 0x7fffffffu;
+		m = a > m ? a : m;
+	}
+	union { float f; uint32_t u; } r;
+	r.u = m;
+
+	BW_ASSERT(!bw_is_nan(r.f));
+	return r.f;
+}
+
+static inline float bw_buf_sum_sq(
+		const float * src,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_elems));
+
+	// 8 independent partial sums, which the compiler can map to vector lanes
+	float acc[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+	size_t i = 0;
+	for (; i + 8 <= n_elems; i += 8)
+		for (size_t j = 0; j < 8; j++)
+			acc[j] += src[i + j] * src[i + j];
+	for (; i < n_elems; i++)
+		acc[0] += src[i] * src[i];
+	const float y = ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7]));
+
+	BW_ASSERT(!bw_is_nan(y));
+	return y;
+}
+
+static inline void bw_buf_flush_denormals(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT_DEEP(!bw_has_nan(src, n_elems));
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		union { float f; uint32_t u; } v;
+		v.f = src[i];
+		// all ones if the exponent is not zero, zero otherwise
+		v.u &= 0u - ((0u - (v.u & 0x7f800000u)) >> 31);
+		dest[i] = v.f;
+	}
+
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
+}
+
 static inline void bw_buf_fill_multi(
 		float                                   k,
 		float * BW_RESTRICT const * BW_RESTRICT dest,
@@ -443,6 +835,104 @@ static inline void bw_buf_mul_multi(
 		bw_buf_mul(src1[i], src2[i], dest[i], n_elems);
 }
 
+static inline void bw_buf_copy_multi(
+		const float * const * src,
+		float * const *       dest,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(dest[i] != dest[j]);
+#endif
+
+	for (size_t i = 0; i < n_channels; i++)
+		bw_buf_copy(src[i], dest[i], n_elems);
+}
+
+static inline void bw_buf_mac_multi(
+		const float * const * src,
+		float                 k,
+		float * const *       dest,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(!bw_is_nan(k));
+	BW_ASSERT(dest != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(dest[i] != dest[j]);
+#endif
+
+	for (size_t i = 0; i < n_channels; i++)
+		bw_buf_mac(src[i], k, dest[i], n_elems);
+}
+
+static inline void bw_buf_scale_ramp_multi(
+		const float * const * src,
+		float                 k_start,
+		float                 k_end,
+		float * const *       dest,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(bw_is_finite(k_start));
+	BW_ASSERT(bw_is_finite(k_end));
+	BW_ASSERT(dest != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(dest[i] != dest[j]);
+#endif
+
+	for (size_t i = 0; i < n_channels; i++)
+		bw_buf_scale_ramp(src[i], k_start, k_end, dest[i], n_elems);
+}
+
+static inline void bw_buf_peak_multi(
+		const float * const * src,
+		float *               peak,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(peak != BW_NULL);
+
+	for (size_t i = 0; i < n_channels; i++)
+		peak[i] = bw_buf_peak(src[i], n_elems);
+}
+
+static inline void bw_buf_sum_sq_multi(
+		const float * const * src,
+		float *               sum_sq,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(sum_sq != BW_NULL);
+
+	for (size_t i = 0; i < n_channels; i++)
+		sum_sq[i] = bw_buf_sum_sq(src[i], n_elems);
+}
+
+static inline void bw_buf_flush_denormals_multi(
+		const float * const * src,
+		float * const *       dest,
+		size_t                n_channels,
+		size_t                n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(dest[i] != dest[j]);
+#endif
+
+	for (size_t i = 0; i < n_channels; i++)
+		bw_buf_flush_denormals(src[i], dest[i], n_elems);
+}
+
 #ifdef __cplusplus
 }
 
@@ -549,6 +1039,132 @@ inline void bufMul(
 	const std::array<const float *, N_CHANNELS> src2,
 	const std::array<float *, N_CHANNELS>       dest,
 	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufCopy
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufCopy(
+	const float * const * src,
+	float * const *       dest,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufCopy(
+	const std::array<const float *, N_CHANNELS> src,
+	const std::array<float *, N_CHANNELS>       dest,
+	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufMac
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufMac(
+	const float * const * src,
+	float                 k,
+	float * const *       dest,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufMac(
+	const std::array<const float *, N_CHANNELS> src,
+	float                                       k,
+	const std::array<float *, N_CHANNELS>       dest,
+	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufScaleRamp
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufScaleRamp(
+	const float * const * src,
+	float                 kStart,
+	float                 kEnd,
+	float * const *       dest,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufScaleRamp(
+	const std::array<const float *, N_CHANNELS> src,
+	float                                       kStart,
+	float                                       kEnd,
+	const std::array<float *, N_CHANNELS>       dest,
+	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufInterleave
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufInterleave(
+	const float * const * src,
+	float * BW_RESTRICT   dest,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufInterleave(
+	const std::array<const float *, N_CHANNELS> src,
+	float * BW_RESTRICT                         dest,
+	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufDeinterleave
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufDeinterleave(
+	const float * BW_RESTRICT src,
+	float * const *           dest,
+	size_t                    nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufDeinterleave(
+	const float * BW_RESTRICT             src,
+	const std::array<float *, N_CHANNELS> dest,
+	size_t                                nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufPeak
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufPeak(
+	const float * const * src,
+	float *               peak,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufPeak(
+	const std::array<const float *, N_CHANNELS> src,
+	std::array<float, N_CHANNELS> &             peak,
+	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufSumSq
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufSumSq(
+	const float * const * src,
+	float *               sumSq,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufSumSq(
+	const std::array<const float *, N_CHANNELS> src,
+	std::array<float, N_CHANNELS> &             sumSq,
+	size_t                                      nSamples);
+/*! <<<```
+ *
+ *    ##### Brickworks::bufFlushDenormals
+ *  ```>>> */
+template<size_t N_CHANNELS>
+inline void bufFlushDenormals(
+	const float * const * src,
+	float * const *       dest,
+	size_t                nSamples);
+
+template<size_t N_CHANNELS>
+inline void bufFlushDenormals(
+	const std::array<const float *, N_CHANNELS> src,
+	const std::array<float *, N_CHANNELS>       dest,
+	size_t                                      nSamples);
 /*! <<<```
  *  }}} */
 
@@ -661,6 +1277,140 @@ inline void bufMul(
 	bufMul<N_CHANNELS>(src1.data(), src2.data(), dest.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void bufCopy(
+		const float * const * src,
+		float * const *       dest,
+		size_t                nSamples) {
+	bw_buf_copy_multi(src, dest, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufCopy(
+		const std::array<const float *, N_CHANNELS> src,
+		const std::array<float *, N_CHANNELS>       dest,
+		size_t                                      nSamples) {
+	bufCopy<N_CHANNELS>(src.data(), dest.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufMac(
+		const float * const * src,
+		float                 k,
+		float * const *       dest,
+		size_t                nSamples) {
+	bw_buf_mac_multi(src, k, dest, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufMac(
+		const std::array<const float *, N_CHANNELS> src,
+		float                                       k,
+		const std::array<float *, N_CHANNELS>       dest,
+		size_t                                      nSamples) {
+	bufMac<N_CHANNELS>(src.data(), k, dest.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufScaleRamp(
+		const float * const * src,
+		float                 kStart,
+		float                 kEnd,
+		float * const *       dest,
+		size_t                nSamples) {
+	bw_buf_scale_ramp_multi(src, kStart, kEnd, dest, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufScaleRamp(
+		const std::array<const float *, N_CHANNELS> src,
+		float                                       kStart,
+		float                                       kEnd,
+		const std::array<float *, N_CHANNELS>       dest,
+		size_t                                      nSamples) {
+	bufScaleRamp<N_CHANNELS>(src.data(), kStart, kEnd, dest.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufInterleave(
+		const float * const * src,
+		float * BW_RESTRICT   dest,
+		size_t                nSamples) {
+	bw_buf_interleave(src, dest, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufInterleave(
+		const std::array<const float *, N_CHANNELS> src,
+		float * BW_RESTRICT                         dest,
+		size_t                                      nSamples) {
+	bufInterleave<N_CHANNELS>(src.data(), dest, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufDeinterleave(
+		const float * BW_RESTRICT src,
+		float * const *           dest,
+		size_t                    nSamples) {
+	bw_buf_deinterleave(src, dest, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufDeinterleave(
+		const float * BW_RESTRICT             src,
+		const std::array<float *, N_CHANNELS> dest,
+		size_t                                nSamples) {
+	bufDeinterleave<N_CHANNELS>(src, dest.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufPeak(
+		const float * const * src,
+		float *               peak,
+		size_t                nSamples) {
+	bw_buf_peak_multi(src, peak, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufPeak(
+		const std::array<const float *, N_CHANNELS> src,
+		std::array<float, N_CHANNELS> &             peak,
+		size_t                                      nSamples) {
+	bufPeak<N_CHANNELS>(src.data(), peak.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufSumSq(
+		const float * const * src,
+		float *               sumSq,
+		size_t                nSamples) {
+	bw_buf_sum_sq_multi(src, sumSq, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufSumSq(
+		const std::array<const float *, N_CHANNELS> src,
+		std::array<float, N_CHANNELS> &             sumSq,
+		size_t                                      nSamples) {
+	bufSumSq<N_CHANNELS>(src.data(), sumSq.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufFlushDenormals(
+		const float * const * src,
+		float * const *       dest,
+		size_t                nSamples) {
+	bw_buf_flush_denormals_multi(src, dest, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void bufFlushDenormals(
+		const std::array<const float *, N_CHANNELS> src,
+		const std::array<float *, N_CHANNELS>       dest,
+		size_t                                      nSamples) {
+	bufFlushDenormals<N_CHANNELS>(src.data(), dest.data(), nSamples);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.0 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_one_pole bw_svf }}}
  *  description {{{
  *    Cab simulator effect.
@@ -30,6 +30,15 @@
  *  }}}
  *  changelog {{{
  *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>Added <code>bw_cab_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_cab_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code>.</li>
+ *        </ul>
+ *      </li>
  *      <li>Version <strong>1.0.0</strong>:
  *        <ul>
  *          <li>First release.</li>
@@ -200,6 +209,34 @@ static inline void bw_cab_set_tone(
  *
  *    Default value: `0.5f`.
  *
+ *    #### bw_cab_set_interp_period()
+ *  ```>>> */
+static inline void bw_cab_set_interp_period(
+	bw_cab_coeffs * BW_RESTRICT coeffs,
+	size_t                      value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    See `bw_svf_set_interp_period()` for details.
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_cab_set_profile_stats()
+ *  ```>>> */
+static inline void bw_cab_set_profile_stats(
+	bw_cab_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_cab_process()` and
+ *    `bw_cab_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_cab_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_cab_coeffs_is_valid(
@@ -260,6 +297,9 @@ struct bw_cab_coeffs {
 	enum bw_cab_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_svf_coeffs			lp_coeffs;
@@ -301,6 +341,9 @@ static inline void bw_cab_init(
 	bw_gain_set_gain_lin(&coeffs->gain_bpl_coeffs, 2.25f);
 	bw_gain_set_gain_lin(&coeffs->gain_bph_coeffs, 3.75f);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_cab_coeffs");
 	coeffs->state = bw_cab_coeffs_state_init;
@@ -494,11 +537,13 @@ static inline void bw_cab_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_cab_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_cab_update_coeffs_audio(coeffs);
 		y[i] = bw_cab_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_cab_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_reset_coeffs);
@@ -530,12 +575,14 @@ static inline void bw_cab_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_cab_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_cab_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_cab_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_cab_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_reset_coeffs);
@@ -591,6 +638,41 @@ static inline void bw_cab_set_tone(
 	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_init);
 }
 
+static inline void bw_cab_set_interp_period(
+		bw_cab_coeffs * BW_RESTRICT coeffs,
+		size_t                      value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_cab_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	bw_svf_set_interp_period(&coeffs->lp_coeffs, value);
+	bw_svf_set_interp_period(&coeffs->hp_coeffs, value);
+	bw_svf_set_interp_period(&coeffs->bpl_coeffs, value);
+	bw_svf_set_interp_period(&coeffs->bph_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_cab_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_init);
+}
+
+static inline void bw_cab_set_profile_stats(
+		bw_cab_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_cab_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_cab_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_cab_coeffs_state_init);
+}
+
 static inline char bw_cab_coeffs_is_valid(
 		const bw_cab_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -683,6 +765,12 @@ public:
 
 	void setTone(
 		float value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -781,6 +869,18 @@ inline void Cab<N_CHANNELS>::setTone(
 	bw_cab_set_tone(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Cab<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_cab_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Cab<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_cab_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,10 +20,10 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{
- *    bw_buf bw_comb bw_common bw_delay bw_gain bw_math bw_one_pole bw_osc_sin
- *    bw_phase_gen
+ *    bw_arena bw_buf bw_comb bw_common bw_delay bw_gain bw_math bw_one_pole
+ *    bw_osc_sin bw_phase_gen
  *  }}}
  *  description {{{
  *    Chorus / vibrato / flanger with variable rate and amount.
@@ -36,8 +36,23 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_chorus_mem_req_max()</code>.</li>
+ *          <li>C++ API now only reallocates memory in
+ *              <code>setSampleRate()</code> when needed.</li>
+ *          <li>Added <code>getMemReq()</code> and <code>setMemory()</code> to
+ *              C++ API, which now also aligns the memory of each channel to
+ *              <code>BW_ARENA_ALIGN</code> bytes.</li>
+ *          <li><code>setSampleRate()</code> in C++ API now returns whether
+ *              it succeeded.</li>
+ *          <li>Added <code>bw_chorus_set_pow2_length()</code> and updated C++
+ *              API in this regard.</li>
+ *          <li>Added <code>bw_chorus_set_lazy_reset()</code> and updated C++
+ *              API in this regard.</li>
+ *          <li>Added <code>bw_chorus_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -137,6 +152,25 @@ static inline size_t bw_chorus_mem_req(
  *    Returns the size, in bytes, of contiguous memory to be supplied to
  *    `bw_chorus_mem_set()` using `coeffs`.
  *
+ *    #### bw_chorus_mem_req_max()
+ *  ```>>> */
+static inline size_t bw_chorus_mem_req_max(
+	const bw_chorus_coeffs * BW_RESTRICT coeffs,
+	float                                max_sample_rate);
+/*! <<<```
+ *    Returns the size, in bytes, of contiguous memory to be supplied to
+ *    `bw_chorus_mem_set()` using `coeffs` so that it can be reused at any
+ *    sample rate up to `max_sample_rate` (Hz).
+ *
+ *    After `bw_chorus_set_sample_rate()` is called with a `sample_rate` not
+ *    greater than `max_sample_rate`, the same memory block can be associated
+ *    again by calling `bw_chorus_mem_set()`, which neither allocates nor
+ *    touches the memory, and then `bw_chorus_reset_state()` as usual.
+ *
+ *    It can be called any time after `bw_chorus_init()`.
+ *
+ *    `max_sample_rate` must be finite and positive.
+ *
  *    #### bw_chorus_mem_set()
  *  ```>>> */
 static inline void bw_chorus_mem_set(
@@ -318,6 +352,45 @@ static inline void bw_chorus_set_coeff_fb(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_chorus_set_lazy_reset()
+ *  ```>>> */
+static inline void bw_chorus_set_lazy_reset(
+	bw_chorus_coeffs * BW_RESTRICT coeffs,
+	char                           value);
+/*! <<<```
+ *    Sets whether the internal delay line should be cleared lazily when
+ *    resetting (`value` non-`0`) or not (`0`) in `coeffs`. See
+ *    `bw_delay_set_lazy_reset()` in [bw_delay](bw_delay) for more details.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_chorus_set_pow2_length()
+ *  ```>>> */
+static inline void bw_chorus_set_pow2_length(
+	bw_chorus_coeffs * BW_RESTRICT coeffs,
+	char                           value);
+/*! <<<```
+ *    Sets whether the length of the internal delay line should be rounded
+ *    up to a power of `2` (`value` non-`0`) or not (`0`) in `coeffs`. See
+ *    `bw_delay_set_pow2_length()` in [bw_delay](bw_delay) for more details.
+ *
+ *    Changes only take effect at the next `bw_chorus_set_sample_rate()` call.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_chorus_set_profile_stats()
+ *  ```>>> */
+static inline void bw_chorus_set_profile_stats(
+	bw_chorus_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *             stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_chorus_process()` and
+ *    `bw_chorus_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_chorus_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_chorus_coeffs_is_valid(
@@ -387,6 +460,9 @@ struct bw_chorus_coeffs {
 	enum bw_chorus_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_phase_gen_coeffs		phase_gen_coeffs;
@@ -421,6 +497,9 @@ static inline void bw_chorus_init(
 	coeffs->delay = 0.f;
 	coeffs->amount = 0.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_chorus_coeffs");
 	coeffs->state = bw_chorus_coeffs_state_init;
@@ -457,6 +536,17 @@ static inline size_t bw_chorus_mem_req(
 	return bw_comb_mem_req(&coeffs->comb_coeffs);
 }
 
+static inline size_t bw_chorus_mem_req_max(
+		const bw_chorus_coeffs * BW_RESTRICT coeffs,
+		float                                max_sample_rate) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(max_sample_rate) && max_sample_rate > 0.f);
+
+	return bw_comb_mem_req_max(&coeffs->comb_coeffs, max_sample_rate);
+}
+
 static inline void bw_chorus_mem_set(
 		const bw_chorus_coeffs * BW_RESTRICT coeffs,
 		bw_chorus_state * BW_RESTRICT        state,
@@ -626,11 +716,13 @@ static inline void bw_chorus_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_chorus_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_chorus_update_coeffs_audio(coeffs);
 		y[i] = bw_chorus_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_reset_coeffs);
@@ -663,12 +755,14 @@ static inline void bw_chorus_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_chorus_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_chorus_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_chorus_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_reset_coeffs);
@@ -757,6 +851,50 @@ static inline void bw_chorus_set_coeff_fb(
 	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
 }
 
+static inline void bw_chorus_set_lazy_reset(
+		bw_chorus_coeffs * BW_RESTRICT coeffs,
+		char                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+
+	bw_comb_set_lazy_reset(&coeffs->comb_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+}
+
+static inline void bw_chorus_set_pow2_length(
+		bw_chorus_coeffs * BW_RESTRICT coeffs,
+		char                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+
+	bw_comb_set_pow2_length(&coeffs->comb_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+}
+
+static inline void bw_chorus_set_profile_stats(
+		bw_chorus_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *             stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_chorus_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_chorus_coeffs_state_init);
+}
+
 static inline char bw_chorus_coeffs_is_valid(
 		const bw_chorus_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -806,6 +944,7 @@ static inline char bw_chorus_state_is_valid(
 }
 
 #include <array>
+#include <bw_arena.h>
 
 namespace Brickworks {
 
@@ -822,9 +961,16 @@ public:
 
 	~Chorus();
 
-	void setSampleRate(
+	bool setSampleRate(
 		float sampleRate);
 
+	size_t getMemReq(
+		float sampleRate);
+
+	void setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size);
+
 	void reset(
 		float               x0 = 0.f,
 		float * BW_RESTRICT y0 = nullptr);
@@ -868,9 +1014,43 @@ public:
 
 	void setCoeffFB(
 		float value);
+
+	void setLazyReset(
+		bool value);
+
+	void setPow2Length(
+		bool value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
+ *
+ *    By default, `setSampleRate()` allocates the memory needed by all
+ *    channels, which is owned and later released by the object. It only
+ *    reallocates when the owned block is too small, hence going back to a
+ *    lower or previously used sample rate does not allocate. After
+ *    `setMemory()` is called, `setSampleRate()` uses the caller-owned
+ *    `memory` block of `size` bytes instead and never allocates, so that it
+ *    can be called from a realtime thread. Passing `nullptr` restores the
+ *    default behavior.
+ *
+ *    `setMemory()` only takes effect at the next successful `setSampleRate()`
+ *    call, until which the object keeps using its current memory. If the
+ *    object owned a memory block, such call releases it, hence, to avoid
+ *    deallocating on a realtime thread, either call `setMemory()` before
+ *    the first `setSampleRate()` or make the first `setSampleRate()` after
+ *    `setMemory()` on a non-realtime thread.
+ *
+ *    `setSampleRate()` returns `false` and leaves the object unchanged if
+ *    `size` is too small for the new sample rate, `true` otherwise.
+ *
+ *    `getMemReq()` returns the minimum `size` needed to use any sample rate
+ *    up to `sampleRate`.
+ *
+ *    In both cases, the memory of each channel is aligned to
+ *    `BW_ARENA_ALIGN` bytes (see [bw_arena](bw_arena)).
  *  }}} */
 
 /*** Implementation ***/
@@ -883,6 +1063,9 @@ private:
 	bw_chorus_state			states[N_CHANNELS];
 	bw_chorus_state * BW_RESTRICT	statesP[N_CHANNELS];
 	void * BW_RESTRICT		mem;
+	size_t				memSize;
+	void * BW_RESTRICT		userMem;
+	size_t				userMemSize;
 };
 
 template<size_t N_CHANNELS>
@@ -892,6 +1075,9 @@ inline Chorus<N_CHANNELS>::Chorus(
 	for (size_t i = 0; i < N_CHANNELS; i++)
 		statesP[i] = states + i;
 	mem = nullptr;
+	memSize = 0;
+	userMem = nullptr;
+	userMemSize = 0;
 }
 
 template<size_t N_CHANNELS>
@@ -901,16 +1087,59 @@ inline Chorus<N_CHANNELS>::~Chorus() {
 }
 
 template<size_t N_CHANNELS>
-inline void Chorus<N_CHANNELS>::setSampleRate(
+inline bool Chorus<N_CHANNELS>::setSampleRate(
 		float sampleRate) {
-	bw_chorus_set_sample_rate(&coeffs, sampleRate);
-	size_t req = bw_chorus_mem_req(&coeffs);
-	if (mem != nullptr)
+	bw_chorus_coeffs c = coeffs;
+	bw_chorus_set_sample_rate(&c, sampleRate);
+	const size_t req = bw_chorus_mem_req(&c);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	const size_t size = bw_arena_get_mem_req(&arena);
+	if (userMem != nullptr) {
+		if (size > userMemSize)
+			return false;
+		bw_arena_mem_set(&arena, userMem);
+	} else {
+		if (size > memSize) {
+			if (mem != nullptr)
+				operator delete(mem);
+			mem = operator new(size);
+			memSize = size;
+		}
+		bw_arena_mem_set(&arena, mem);
+	}
+	coeffs = c;
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_chorus_mem_set(&coeffs, states + i, bw_arena_alloc(&arena, req));
+	if (userMem != nullptr && mem != nullptr) {
+		// states do not point into the owned block anymore
 		operator delete(mem);
-	mem = operator new(req * N_CHANNELS);
-	void *m = mem;
-	for (size_t i = 0; i < N_CHANNELS; i++, m = static_cast<char *>(m) + req)
-		bw_chorus_mem_set(&coeffs, states + i, m);
+		mem = nullptr;
+		memSize = 0;
+	}
+	return true;
+}
+
+template<size_t N_CHANNELS>
+inline size_t Chorus<N_CHANNELS>::getMemReq(
+		float sampleRate) {
+	const size_t req = bw_chorus_mem_req_max(&coeffs, sampleRate);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	return bw_arena_get_mem_req(&arena);
+}
+
+template<size_t N_CHANNELS>
+inline void Chorus<N_CHANNELS>::setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size) {
+	BW_ASSERT(memory != nullptr || size == 0);
+	userMem = memory;
+	userMemSize = size;
 }
 
 template<size_t N_CHANNELS>
@@ -1000,6 +1229,24 @@ inline void Chorus<N_CHANNELS>::setCoeffFB(
 	bw_chorus_set_coeff_fb(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Chorus<N_CHANNELS>::setLazyReset(
+		bool value) {
+	bw_chorus_set_lazy_reset(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Chorus<N_CHANNELS>::setPow2Length(
+		bool value) {
+	bw_chorus_set_pow2_length(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Chorus<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_chorus_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Antialiased hard clipper with parametric bias and gain
@@ -45,8 +45,13 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_clip_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_clip_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -223,6 +228,22 @@ static inline void bw_clip_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_clip_process_interleaved()
+ *  ```>>> */
+static inline void bw_clip_process_interleaved(
+	bw_clip_coeffs * BW_RESTRICT                    coeffs,
+	bw_clip_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                   x,
+	float *                                         y,
+	size_t                                          n_channels,
+	size_t                                          n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_clip_set_bias()
  *  ```>>> */
 static inline void bw_clip_set_bias(
@@ -258,6 +279,19 @@ static inline void bw_clip_set_gain_compensation(
  *
  *    Default value: `0` (off).
  *
+ *    #### bw_clip_set_profile_stats()
+ *  ```>>> */
+static inline void bw_clip_set_profile_stats(
+	bw_clip_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *           stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_clip_process()`,
+ *    `bw_clip_process_multi()`, and `bw_clip_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_clip_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_clip_coeffs_is_valid(
@@ -318,6 +352,9 @@ struct bw_clip_coeffs {
 	enum bw_clip_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -356,6 +393,9 @@ static inline void bw_clip_init(
 	coeffs->gain = 1.f;
 	coeffs->gain_compensation = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_clip_coeffs");
 	coeffs->state = bw_clip_coeffs_state_init;
@@ -560,6 +600,7 @@ static inline void bw_clip_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->gain_compensation)
 		for (size_t i = 0; i < n_samples; i++) {
 			bw_clip_update_coeffs_audio(coeffs);
@@ -570,6 +611,7 @@ static inline void bw_clip_process(
 			bw_clip_update_coeffs_audio(coeffs);
 			y[i] = bw_clip_process1(coeffs, state, x[i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_clip_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_reset_coeffs);
@@ -601,6 +643,7 @@ static inline void bw_clip_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->gain_compensation)
 		for (size_t i = 0; i < n_samples; i++) {
 			bw_clip_update_coeffs_audio(coeffs);
@@ -613,11 +656,52 @@ static inline void bw_clip_process_multi(
 			for (size_t j = 0; j < n_channels; j++)
 				y[j][i] = bw_clip_process1(coeffs, state[j], x[j][i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_clip_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_clip_process_interleaved(
+		bw_clip_coeffs * BW_RESTRICT                    coeffs,
+		bw_clip_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                   x,
+		float *                                         y,
+		size_t                                          n_channels,
+		size_t                                          n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_clip_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	if (coeffs->gain_compensation)
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_clip_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				y[k] = bw_clip_process1_comp(coeffs, state[j], x[k]);
+		}
+	else
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_clip_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				y[k] = bw_clip_process1(coeffs, state[j], x[k]);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_clip_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
+}
+
 static inline void bw_clip_set_bias(
 		bw_clip_coeffs * BW_RESTRICT coeffs,
 		float                        value) {
@@ -661,6 +745,24 @@ static inline void bw_clip_set_gain_compensation(
 	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_init);
 }
 
+static inline void bw_clip_set_profile_stats(
+		bw_clip_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *           stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_clip_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_clip_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_clip_coeffs_state_init);
+}
+
 static inline char bw_clip_coeffs_is_valid(
 		const bw_clip_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -761,6 +863,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setBias(
 		float value);
 
@@ -769,6 +876,9 @@ public:
 
 	void setGainCompensation(
 		bool value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -849,6 +959,14 @@ inline void Clip<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void Clip<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_clip_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void Clip<N_CHANNELS>::setBias(
 		float value) {
@@ -867,6 +985,12 @@ inline void Clip<N_CHANNELS>::setGainCompensation(
 	bw_clip_set_gain_compensation(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Clip<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_clip_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
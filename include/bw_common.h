@@ -29,6 +29,18 @@
  *    <ul>
  *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>BW_FLUSH_DENORMALS</code>,
+ *              <code>bw_flush_denormal()</code>,
+ *              <code>bw_denormals_disable()</code>,
+ *              <code>bw_denormals_restore()</code>, and C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>BW_PROFILE</code>, <code>BW_PROFILE_BEGIN</code>,
+ *              <code>BW_PROFILE_END</code>, <code>bw_profile_stats</code>,
+ *              <code>bw_profile_get_ticks()</code>,
+ *              <code>bw_profile_stats_reset()</code>,
+ *              <code>bw_profile_begin()</code>, and
+ *              <code>bw_profile_end()</code>.</li>
+ *          <li>Added <code>BW_NO_TIME_H</code>.</li>
  *          <li>Added <code>BW_NULL</code> and relaxed <code>NULL</code> definition
  *              requirement in C++.</li>
  *        </ul>
@@ -112,6 +124,10 @@
  *    * if `BW_NO_STDLIB` or `BW_NO_MATH_H` is defined, then `math.h` is not
  *      `#include`d.
  *
+ *    If `BW_PROFILE` is defined, `time.h` may also be `#include`d to implement
+ *    `bw_profile_get_ticks()` on platforms lacking a known hardware counter.
+ *    This does not happen if `BW_NO_STDLIB` or `BW_NO_TIME_H` is defined.
+ *
  *    A `BW_NULL` macro is defined whose value is either `NULL` (C) or `nullptr`
  *    (C++).
  *  >>> */
@@ -148,6 +164,23 @@
 #ifndef INFINITY
 # error INFINITY not defined
 #endif
+
+#ifdef BW_PROFILE
+# if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86))
+#  include <intrin.h>
+# elif !defined(BW_NO_STDLIB) && !defined(BW_NO_TIME_H) \
+	&& !(defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)))
+#  include <time.h>
+# endif
+#endif
+
+#if defined(__GNUC__) && (defined(__SSE__) || defined(__x86_64__))
+# define BW_DENORMALS_MXCSR
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+# include <xmmintrin.h>
+# define BW_DENORMALS_MXCSR
+#endif
+
 /*! ...
  *
  *    #### BW_RESTRICT
@@ -212,12 +245,72 @@
 #  define BW_ASSERT_DEEP(ignore) ((void)0)
 # endif
 #endif
+/*! ...
+ *
+ *    #### BW_FLUSH_DENORMALS
+ *
+ *    If `BW_FLUSH_DENORMALS` is defined, stateful modules whose internal
+ *    states can decay towards zero (currently bw_lp1, bw_one_pole, bw_reverb,
+ *    and bw_svf) set such states to `0.f` as soon as they become denormal or
+ *    close to being so, by means of `bw_flush_denormal()`. This is normally
+ *    done at the end of each `*_process()`, `*_process_multi()`, and
+ *    `*_process_interleaved()` call.
+ *
+ *    This avoids the CPU load spikes that denormal arithmetic causes on many
+ *    platforms while tails die out, at the cost of some extra computation. It
+ *    is not needed if denormals are disabled already (see
+ *    `bw_denormals_disable()`).
+ *
+ *    #### BW_PROFILE, BW_PROFILE_BEGIN, and BW_PROFILE_END
+ *
+ *    If `BW_PROFILE` is defined, the `*_process()`, `*_process_multi()`, and
+ *    `*_process_interleaved()` functions of modules having coefficients
+ *    account for their own execution in the `bw_profile_stats` structure
+ *    associated with the `coeffs` they are given, if any (see the
+ *    `*_set_profile_stats()` function of each module).
+ *
+ *    This is done by wrapping the body of such functions between
+ *    `BW_PROFILE_BEGIN(stats);` and `BW_PROFILE_END(stats, n_samples);`, where
+ *    `stats` is a pointer to a `bw_profile_stats` (possibly `BW_NULL`) and
+ *    `n_samples` is the number of processed samples, summed over all channels.
+ *    You can also use these macros to instrument your own code. Each pair must
+ *    be used in its own scope.
+ *
+ *    If `BW_PROFILE` is not defined, both macros are stripped away by the
+ *    preprocessor.
+ *
+ *  >>> */
+#ifdef BW_PROFILE
+# define BW_PROFILE_BEGIN(stats)		const uint64_t bw_profile_t0 = bw_profile_begin(stats)
+# define BW_PROFILE_END(stats, n_samples)	bw_profile_end(stats, n_samples, bw_profile_t0)
+#else
+# define BW_PROFILE_BEGIN(ignore)		((void)0)
+# define BW_PROFILE_END(ignore, ignore2)	((void)0)
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /*! ...
+ *
+ *    #### bw_profile_stats
+ *  ```>>> */
+typedef struct {
+	uint64_t	n_calls;
+	uint64_t	n_samples;
+	uint64_t	n_ticks;
+	uint32_t	depth;
+} bw_profile_stats;
+/*! <<<```
+ *    Profiling statistics:
+ *
+ *    * `n_calls`: number of accounted calls;
+ *    * `n_samples`: total number of processed samples (summed over all
+ *      channels);
+ *    * `n_ticks`: total execution time, as measured by
+ *      `bw_profile_get_ticks()`;
+ *    * `depth`: current nesting depth, only used internally.
  *
  *    #### bw_is_inf()
  *  ```>>> */
@@ -275,6 +368,91 @@ static inline uint32_t bw_hash_sdbm(
 	const char * BW_RESTRICT string);
 /*! <<<```
  *    Returns the sdbm hash of the given `string`.
+ *
+ *    #### bw_flush_denormal()
+ *  ```>>> */
+static inline float bw_flush_denormal(
+	float x);
+/*! <<<```
+ *    Returns `0.f` if the absolute value of `x` is lower than 2^-80 (~8.27e-25,
+ *    i.e., if it is denormal or close to being so), `x` otherwise.
+ *
+ *    #### bw_denormals_disable()
+ *  ```>>> */
+static inline uint64_t bw_denormals_disable(void);
+/*! <<<```
+ *    Makes the floating-point unit of the calling thread treat denormal inputs
+ *    and results as zero and returns the previous floating-point mode, to be
+ *    passed to `bw_denormals_restore()`.
+ *
+ *    This is implemented for x86 with SSE (FTZ and DAZ bits in MXCSR) and for
+ *    32-bit and 64-bit ARM (FZ bit in FPSCR/FPCR) when using GCC- or
+ *    Clang-compatible compilers, as well as for x86 when using MSVC. Otherwise
+ *    it does nothing and returns `0`.
+ *
+ *    #### bw_denormals_restore()
+ *  ```>>> */
+static inline void bw_denormals_restore(
+	uint64_t mode);
+/*! <<<```
+ *    Restores the floating-point `mode` of the calling thread as previously
+ *    returned by `bw_denormals_disable()`.
+ *
+ *    #### bw_profile_get_ticks()
+ *  ```>>> */
+#ifdef BW_PROFILE
+static inline uint64_t bw_profile_get_ticks(void);
+#endif
+/*! <<<```
+ *    Returns the current value of a fast, monotonic time counter.
+ *
+ *    This is the time stamp counter on x86 (GCC-, Clang-compatible compilers or
+ *    MSVC) and the virtual counter (`CNTVCT_EL0`) on 64-bit ARM (GCC- or
+ *    Clang-compatible compilers). Otherwise, it is the value of
+ *    `CLOCK_MONOTONIC` in nanoseconds if `clock_gettime()` is available (see
+ *    `BW_NO_TIME_H`), or `0`.
+ *
+ *    Only defined if `BW_PROFILE` is defined.
+ *
+ *    #### bw_profile_stats_reset()
+ *  ```>>> */
+static inline void bw_profile_stats_reset(
+	bw_profile_stats * BW_RESTRICT stats);
+/*! <<<```
+ *    Resets all counters in `stats` to `0`.
+ *
+ *    #### bw_profile_begin()
+ *  ```>>> */
+#ifdef BW_PROFILE
+static inline uint64_t bw_profile_begin(
+	bw_profile_stats * BW_RESTRICT stats);
+#endif
+/*! <<<```
+ *    Enters a profiled section accounted in `stats` and returns the current
+ *    value of `bw_profile_get_ticks()`, or `0` if `stats` is `BW_NULL`.
+ *
+ *    Normally not used directly (see `BW_PROFILE_BEGIN`). Only defined if
+ *    `BW_PROFILE` is defined.
+ *
+ *    #### bw_profile_end()
+ *  ```>>> */
+#ifdef BW_PROFILE
+static inline void bw_profile_end(
+	bw_profile_stats * BW_RESTRICT stats,
+	size_t                         n_samples,
+	uint64_t                       t0);
+#endif
+/*! <<<```
+ *    Leaves a profiled section accounted in `stats` that started at time `t0`
+ *    and processed `n_samples` samples. `stats` may be `BW_NULL`, in which
+ *    case nothing happens.
+ *
+ *    Sections can be nested, in which case only the outermost one is accounted
+ *    for. This avoids counting twice when, e.g., a `*_process_multi()`
+ *    function calls the corresponding `*_process()` function.
+ *
+ *    Normally not used directly (see `BW_PROFILE_END`). Only defined if
+ *    `BW_PROFILE` is defined.
  *  }}} */
 
 #ifdef __cplusplus
@@ -346,7 +524,160 @@ static inline uint32_t bw_hash_sdbm(
 	return hash;
 }
 
+static inline float bw_flush_denormal(
+		float x) {
+	union { uint32_t u; float f; } v;
+	v.f = x;
+	// exponent field below 127 - 80 -> all bits cleared
+	v.u &= 0u - (uint32_t)((v.u & 0x7f800000u) >= 0x17800000u);
+	return v.f;
+}
+
+static inline uint64_t bw_denormals_disable(void) {
+#if defined(BW_DENORMALS_MXCSR)
+	// FTZ (bit 15) and DAZ (bit 6)
+# if defined(__GNUC__)
+	const uint32_t csr = __builtin_ia32_stmxcsr();
+	__builtin_ia32_ldmxcsr(csr | 0x8040);
+# else
+	const uint32_t csr = _mm_getcsr();
+	_mm_setcsr(csr | 0x8040);
+# endif
+	return csr;
+#elif defined(__GNUC__) && defined(__aarch64__)
+	// FZ (bit 24)
+	uint64_t fpcr;
+	__asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+	__asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | ((uint64_t)1 << 24)));
+	return fpcr;
+#elif defined(__GNUC__) && defined(__arm__) && defined(__ARM_FP)
+	// FZ (bit 24)
+	uint32_t fpscr;
+	__asm__ __volatile__("vmrs %0, fpscr" : "=r"(fpscr));
+	__asm__ __volatile__("vmsr fpscr, %0" : : "r"(fpscr | ((uint32_t)1 << 24)));
+	return fpscr;
+#else
+	return 0;
+#endif
+}
+
+static inline void bw_denormals_restore(
+		uint64_t mode) {
+#if defined(BW_DENORMALS_MXCSR)
+# if defined(__GNUC__)
+	__builtin_ia32_ldmxcsr((uint32_t)mode);
+# else
+	_mm_setcsr((unsigned int)mode);
+# endif
+#elif defined(__GNUC__) && defined(__aarch64__)
+	__asm__ __volatile__("msr fpcr, %0" : : "r"(mode));
+#elif defined(__GNUC__) && defined(__arm__) && defined(__ARM_FP)
+	__asm__ __volatile__("vmsr fpscr, %0" : : "r"((uint32_t)mode));
+#else
+	(void)mode;
+#endif
+}
+
+#ifdef BW_PROFILE
+static inline uint64_t bw_profile_get_ticks(void) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	return __builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+	uint64_t t;
+	__asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+	return t;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86))
+	return __rdtsc();
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#else
+	return 0;
+#endif
+}
+#endif
+
+static inline void bw_profile_stats_reset(
+		bw_profile_stats * BW_RESTRICT stats) {
+	BW_ASSERT(stats != BW_NULL);
+
+	stats->n_calls = 0;
+	stats->n_samples = 0;
+	stats->n_ticks = 0;
+	stats->depth = 0;
+}
+
+#ifdef BW_PROFILE
+static inline uint64_t bw_profile_begin(
+		bw_profile_stats * BW_RESTRICT stats) {
+	if (stats == BW_NULL)
+		return 0;
+	stats->depth++;
+	return bw_profile_get_ticks();
+}
+
+static inline void bw_profile_end(
+		bw_profile_stats * BW_RESTRICT stats,
+		size_t                         n_samples,
+		uint64_t                       t0) {
+	if (stats == BW_NULL)
+		return;
+	const uint64_t t1 = bw_profile_get_ticks();
+	BW_ASSERT(stats->depth > 0);
+	stats->depth--;
+	if (stats->depth == 0) {
+		stats->n_calls++;
+		stats->n_samples += n_samples;
+		stats->n_ticks += t1 - t0;
+	}
+}
+#endif
+
 #ifdef __cplusplus
+}
+
+namespace Brickworks {
+
+/*** Public C++ API ***/
+
+/*! api_cpp {{{
+ *    ##### Brickworks::DenormalsGuard
+ *
+ *    Disables denormals (see `bw_denormals_disable()`) for the calling thread
+ *    for as long as it is in scope and restores the previous floating-point
+ *    mode when destroyed.
+ *  ```>>> */
+class DenormalsGuard {
+public:
+	DenormalsGuard();
+
+	~DenormalsGuard();
+/*! <<<...
+ *  }
+ *  ```
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+private:
+	uint64_t	mode;
+
+	DenormalsGuard(const DenormalsGuard &other) = delete;
+	DenormalsGuard & operator=(const DenormalsGuard &other) = delete;
+};
+
+inline DenormalsGuard::DenormalsGuard() {
+	mode = bw_denormals_disable();
+}
+
+inline DenormalsGuard::~DenormalsGuard() {
+	bw_denormals_restore(mode);
+}
+
 }
 #endif
 
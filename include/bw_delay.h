@@ -20,8 +20,8 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
- *  requires {{{ bw_buf bw_common bw_math }}}
+ *  version {{{ 1.1.0 }}}
+ *  requires {{{ bw_arena bw_buf bw_common bw_math }}}
  *  description {{{
  *    Interpolated delay line, not smoothed.
  *
@@ -31,8 +31,33 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_delay_mem_req_max()</code>.</li>
+ *          <li>C++ API now only reallocates memory in
+ *              <code>setSampleRate()</code> when needed.</li>
+ *          <li>Added <code>getMemReq()</code> and <code>setMemory()</code> to
+ *              C++ API, which now also aligns the memory of each channel to
+ *              <code>BW_ARENA_ALIGN</code> bytes.</li>
+ *          <li><code>setSampleRate()</code> in C++ API now returns whether
+ *              it succeeded.</li>
+ *          <li>Added optional half-precision storage via
+ *              <code>BW_DELAY_FLOAT16</code>.</li>
+ *          <li>Added <code>bw_delay_set_pow2_length()</code> and updated C++
+ *              API in this regard.</li>
+ *          <li>Added <code>bw_delay_set_lazy_reset()</code> and updated C++
+ *              API in this regard.</li>
+ *          <li>Added <code>bw_delay_tap</code>,
+ *              <code>bw_delay_read_taps()</code>, and
+ *              <code>bw_delay_read_taps_sum()</code>.</li>
+ *          <li>Added <code>bw_delay_read_block()</code> and
+ *              <code>bw_delay_write_block()</code>.</li>
+ *          <li><code>bw_delay_process()</code> and
+ *              <code>bw_delay_process_multi()</code> now access the delay
+ *              line by contiguous blocks of samples.</li>
+ *          <li>Added <code>bw_delay_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -89,6 +114,24 @@
 
 #include <bw_common.h>
 
+/*! ...
+ *
+ *    #### BW_DELAY_FLOAT16
+ *
+ *    If `BW_DELAY_FLOAT16` is defined, delay lines store samples in IEEE 754
+ *    half-precision format (16 bits) rather than as `float`s. This halves
+ *    memory requirements and traffic at the cost of precision (11 significant
+ *    bits) and range (absolute values are clipped to `65504.f`). Since it is
+ *    a compile-time setting, it also affects all modules that use delay lines
+ *    internally (e.g., [bw_reverb](bw_reverb)).
+ *
+ *    Conversions are performed using F16C instructions on x86 (when
+ *    `__F16C__` is defined, or when `__AVX2__` is defined with MSVC), native
+ *    half-precision support on ARM (when `__ARM_FP16_FORMAT_IEEE` is defined),
+ *    or otherwise a portable implementation, always rounding to nearest even.
+ *
+ *  >>> */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -106,6 +149,19 @@ typedef struct bw_delay_state bw_delay_state;
 /*! <<<```
  *    Internal state and related.
  *
+ *    #### bw_delay_tap
+ *  ```>>> */
+typedef struct {
+	size_t	di;
+	float	df;
+	float	gain;
+} bw_delay_tap;
+/*! <<<```
+ *    Delay line tap:
+ *     * `di`: integer part of the delay in samples;
+ *     * `df`: fractional part of the delay in samples, in [`0.f`, `1.f`);
+ *     * `gain`: gain (linear) applied to the value read.
+ *
  *    #### bw_delay_init()
  *  ```>>> */
 static inline void bw_delay_init(
@@ -133,6 +189,30 @@ static inline size_t bw_delay_mem_req(
  *    Returns the size, in bytes, of contiguous memory to be supplied to
  *    `bw_delay_mem_set()` using `coeffs`.
  *
+ *    It is up to twice as large when the delay line length is rounded up to a
+ *    power of `2` (see `bw_delay_set_pow2_length()`) and half as large if
+ *    `BW_DELAY_FLOAT16` is defined.
+ *
+ *    #### bw_delay_mem_req_max()
+ *  ```>>> */
+static inline size_t bw_delay_mem_req_max(
+	const bw_delay_coeffs * BW_RESTRICT coeffs,
+	float                               max_sample_rate);
+/*! <<<```
+ *    Returns the size, in bytes, of contiguous memory to be supplied to
+ *    `bw_delay_mem_set()` using `coeffs` so that it can be reused at any
+ *    sample rate up to `max_sample_rate` (Hz).
+ *
+ *    After `bw_delay_set_sample_rate()` is called with a `sample_rate` not
+ *    greater than `max_sample_rate`, the same memory block can be associated
+ *    again by calling `bw_delay_mem_set()`, which neither allocates nor
+ *    touches the memory, and then `bw_delay_reset_state()` as usual (see also
+ *    `bw_delay_set_lazy_reset()` to avoid clearing it).
+ *
+ *    It can be called any time after `bw_delay_init()`.
+ *
+ *    `max_sample_rate` must be finite and positive.
+ *
  *    #### bw_delay_mem_set()
  *  ```>>> */
 static inline void bw_delay_mem_set(
@@ -190,7 +270,7 @@ static float bw_delay_read(
  *    `coeffs` and `state` by applying a delay of `di` + `df` samples.
  *
  *    `df` must be in [`0.f`, `1.f`) and `di` + `df` must not exceed the delay
- *    line length (`max_delay * sample_rate`).
+ *    line length (see `bw_delay_get_length()`).
  *
  *    #### bw_delay_write()
  *  ```>>> */
@@ -202,6 +282,72 @@ static void bw_delay_write(
  *    Pushes the new sample `x` on the delay line identified by `coeffs` and
  *    `state`.
  *
+ *    #### bw_delay_read_block()
+ *  ```>>> */
+static inline void bw_delay_read_block(
+	const bw_delay_coeffs * BW_RESTRICT coeffs,
+	const bw_delay_state * BW_RESTRICT  state,
+	size_t                              di,
+	float                               df,
+	float * BW_RESTRICT                 y,
+	size_t                              n_samples);
+/*! <<<```
+ *    Fills the first `n_samples` of the output buffer `y` with interpolated
+ *    values read from the delay line identified by `coeffs` and `state`. The
+ *    last value is the same that `bw_delay_read()` would return when applying
+ *    a delay of `di` + `df` samples, and each of the previous values is read
+ *    one sample further in the past.
+ *
+ *    Memory is accessed by at most two contiguous runs, and no interpolation
+ *    happens if `df` is `0.f`.
+ *
+ *    `df` must be in [`0.f`, `1.f`) and `di` + `df` + `n_samples` - `1` must
+ *    not exceed the delay line length (see `bw_delay_get_length()`).
+ *
+ *    #### bw_delay_write_block()
+ *  ```>>> */
+static inline void bw_delay_write_block(
+	const bw_delay_coeffs * BW_RESTRICT coeffs,
+	bw_delay_state * BW_RESTRICT        state,
+	const float * BW_RESTRICT           x,
+	size_t                              n_samples);
+/*! <<<```
+ *    Pushes the first `n_samples` of the input buffer `x` on the delay line
+ *    identified by `coeffs` and `state`, in order. The result is the same as
+ *    calling `bw_delay_write()` on each of them.
+ *
+ *    #### bw_delay_read_taps()
+ *  ```>>> */
+static inline void bw_delay_read_taps(
+	const bw_delay_coeffs * BW_RESTRICT coeffs,
+	const bw_delay_state * BW_RESTRICT  state,
+	const bw_delay_tap * BW_RESTRICT    taps,
+	size_t                              n_taps,
+	float * const *                     y,
+	size_t                              n_samples);
+/*! <<<```
+ *    Reads each of the `n_taps` `taps` from the delay line identified by
+ *    `coeffs` and `state` as `bw_delay_read_block()` does, applies its gain,
+ *    and fills the first `n_samples` of the corresponding output buffer in
+ *    the `y` array.
+ *
+ *    For each tap, `di` + `df` + `n_samples` - `1` must not exceed the delay
+ *    line length (see `bw_delay_get_length()`).
+ *
+ *    #### bw_delay_read_taps_sum()
+ *  ```>>> */
+static inline void bw_delay_read_taps_sum(
+	const bw_delay_coeffs * BW_RESTRICT coeffs,
+	const bw_delay_state * BW_RESTRICT  state,
+	const bw_delay_tap * BW_RESTRICT    taps,
+	size_t                              n_taps,
+	float * BW_RESTRICT                 y,
+	size_t                              n_samples);
+/*! <<<```
+ *    Like `bw_delay_read_taps()`, but fills the first `n_samples` of the
+ *    output buffer `y` with the sum of the outputs of all taps (or `0.f` if
+ *    `n_taps` is `0`).
+ *
  *    #### bw_delay_update_coeffs_ctrl()
  *  ```>>> */
 static inline void bw_delay_update_coeffs_ctrl(
@@ -266,6 +412,39 @@ static inline void bw_delay_set_delay(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_delay_set_lazy_reset()
+ *  ```>>> */
+static inline void bw_delay_set_lazy_reset(
+	bw_delay_coeffs * BW_RESTRICT coeffs,
+	char                          value);
+/*! <<<```
+ *    Sets whether `bw_delay_reset_state()` should clear the delay line lazily
+ *    (`value` non-`0`) or not (`0`) in `coeffs`.
+ *
+ *    In the former case resetting takes constant time and the delay line is
+ *    not cleared at all. Rather, reading portions of the delay line that were
+ *    not written since the reset returns the initial input value, at the cost
+ *    of a small overhead until the whole delay line is written again.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_delay_set_pow2_length()
+ *  ```>>> */
+static inline void bw_delay_set_pow2_length(
+	bw_delay_coeffs * BW_RESTRICT coeffs,
+	char                          value);
+/*! <<<```
+ *    Sets whether the delay line length should be rounded up to a power of
+ *    `2` (`value` non-`0`) or not (`0`) in `coeffs`.
+ *
+ *    In the former case, reading and writing wrap around the delay line using
+ *    a bitmask rather than conditionals, at the cost of up to twice the memory
+ *    (see `bw_delay_mem_req()` and `bw_delay_get_length()`).
+ *
+ *    Changes only take effect at the next `bw_delay_set_sample_rate()` call.
+ *
+ *    Default value: `0` (off).
+ *
  *    #### bw_delay_get_length()
  *  ```>>> */
 static inline size_t bw_delay_get_length(
@@ -275,6 +454,19 @@ static inline size_t bw_delay_get_length(
  *
  *    `coeffs` must be at least in the "sample-rate-set" state.
  *
+ *    #### bw_delay_set_profile_stats()
+ *  ```>>> */
+static inline void bw_delay_set_profile_stats(
+	bw_delay_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *            stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_delay_process()` and
+ *    `bw_delay_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_delay_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_delay_coeffs_is_valid(
@@ -316,10 +508,77 @@ static inline char bw_delay_state_is_valid(
 #include <bw_buf.h>
 #include <bw_math.h>
 
+#if defined(BW_DELAY_FLOAT16) && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+# define BW_DELAY_FLOAT16_F16C
+# include <immintrin.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#ifdef BW_DELAY_FLOAT16
+typedef uint16_t bw_delay_sample;
+
+static inline bw_delay_sample bw_delay_do_store(
+		float x) {
+	x = bw_clipf(x, -65504.f, 65504.f);
+# if defined(BW_DELAY_FLOAT16_F16C)
+	return (bw_delay_sample)_cvtss_sh(x, _MM_FROUND_TO_NEAREST_INT);
+# elif defined(__ARM_FP16_FORMAT_IEEE)
+	union { __fp16 h; uint16_t u; } v;
+	v.h = (__fp16)x;
+	return v.u;
+# else
+	// round to nearest even
+	union { float f; uint32_t u; } v;
+	v.f = x;
+	const uint32_t s = (v.u >> 16) & 0x8000;
+	v.u &= 0x7fffffff;
+	if (v.u < 0x38800000) {
+		// subnormal or zero
+		v.f += 0.5f;
+		return (bw_delay_sample)(s | (v.u - 0x3f000000));
+	}
+	v.u += 0xc8000fff + ((v.u >> 13) & 1);
+	return (bw_delay_sample)(s | (v.u >> 13));
+# endif
+}
+
+static inline float bw_delay_do_load(
+		bw_delay_sample x) {
+# if defined(BW_DELAY_FLOAT16_F16C)
+	return _cvtsh_ss(x);
+# elif defined(__ARM_FP16_FORMAT_IEEE)
+	union { __fp16 h; uint16_t u; } v;
+	v.u = x;
+	return (float)v.h;
+# else
+	union { float f; uint32_t u; } v;
+	v.u = ((uint32_t)(x & 0x7fff) << 13) + 0x38000000;
+	if ((x & 0x7c00) == 0) {
+		// subnormal or zero
+		v.u += 0x800000;
+		v.f -= 6.103515625e-5f;
+	}
+	v.u |= (uint32_t)(x & 0x8000) << 16;
+	return v.f;
+# endif
+}
+#else
+typedef float bw_delay_sample;
+
+static inline bw_delay_sample bw_delay_do_store(
+		float x) {
+	return x;
+}
+
+static inline float bw_delay_do_load(
+		bw_delay_sample x) {
+	return x;
+}
+#endif
+
 #ifdef BW_DEBUG_DEEP
 enum bw_delay_coeffs_state {
 	bw_delay_coeffs_state_invalid,
@@ -343,10 +602,14 @@ struct bw_delay_coeffs {
 	enum bw_delay_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	float				fs;
 	size_t				len;
+	size_t				mask;
 
 	size_t				di;
 	float				df;
@@ -355,6 +618,8 @@ struct bw_delay_coeffs {
 	float				max_delay;
 	float				delay;
 	char				delay_changed;
+	char				lazy_reset;
+	char				pow2_length;
 };
 
 struct bw_delay_state {
@@ -365,8 +630,10 @@ struct bw_delay_state {
 #endif
 
 	// States
-	float * BW_RESTRICT		buf;
+	bw_delay_sample * BW_RESTRICT	buf;
 	size_t				idx;
+	size_t				n_valid;
+	float				x_0;
 };
 
 static inline void bw_delay_init(
@@ -378,7 +645,12 @@ static inline void bw_delay_init(
 
 	coeffs->max_delay = max_delay;
 	coeffs->delay = 0.f;
+	coeffs->lazy_reset = 0;
+	coeffs->pow2_length = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_delay_coeffs");
 	coeffs->state = bw_delay_coeffs_state_init;
@@ -388,6 +660,19 @@ static inline void bw_delay_init(
 	BW_ASSERT_DEEP(coeffs->state == bw_delay_coeffs_state_init);
 }
 
+static inline size_t bw_delay_do_get_len(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		float                               sample_rate) {
+	size_t len = (size_t)bw_ceilf(sample_rate * coeffs->max_delay) + 1;
+	if (coeffs->pow2_length) {
+		size_t l = 2;
+		while (l < len)
+			l <<= 1;
+		len = l;
+	}
+	return len;
+}
+
 static inline void bw_delay_set_sample_rate(
 		bw_delay_coeffs * BW_RESTRICT coeffs,
 		float                         sample_rate) {
@@ -397,7 +682,8 @@ static inline void bw_delay_set_sample_rate(
 	BW_ASSERT(bw_is_finite(sample_rate) && sample_rate > 0.f);
 
 	coeffs->fs = sample_rate;
-	coeffs->len = (size_t)bw_ceilf(coeffs->fs * coeffs->max_delay) + 1;
+	coeffs->len = bw_delay_do_get_len(coeffs, sample_rate);
+	coeffs->mask = coeffs->pow2_length ? coeffs->len - 1 : 0;
 
 #ifdef BW_DEBUG_DEEP
 	coeffs->state = bw_delay_coeffs_state_set_sample_rate;
@@ -412,7 +698,18 @@ static inline size_t bw_delay_mem_req(
 	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_set_sample_rate);
 
-	return coeffs->len * sizeof(float);
+	return coeffs->len * sizeof(bw_delay_sample);
+}
+
+static inline size_t bw_delay_mem_req_max(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		float                               max_sample_rate) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(max_sample_rate) && max_sample_rate > 0.f);
+
+	return bw_delay_do_get_len(coeffs, max_sample_rate) * sizeof(bw_delay_sample);
 }
 
 static inline void bw_delay_mem_set(
@@ -426,7 +723,7 @@ static inline void bw_delay_mem_set(
 	BW_ASSERT(mem != BW_NULL);
 
 	(void)coeffs;
-	state->buf = (float *)mem;
+	state->buf = (bw_delay_sample *)mem;
 
 #ifdef BW_DEBUG_DEEP
 	state->hash = bw_hash_sdbm("bw_delay_state");
@@ -476,8 +773,18 @@ static inline float bw_delay_reset_state(
 	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_mem_set);
 	BW_ASSERT(bw_is_finite(x_0));
 
-	bw_buf_fill(x_0, state->buf, coeffs->len);
+	const bw_delay_sample v = bw_delay_do_store(x_0);
+	if (coeffs->lazy_reset) {
+		state->buf[0] = v;
+		state->n_valid = 1;
+	} else {
+		for (size_t i = 0; i < coeffs->len; i++)
+			state->buf[i] = v;
+		state->n_valid = coeffs->len;
+	}
 	state->idx = 0;
+	// stored as read back from the buffer, so that lazy and eager resets match
+	state->x_0 = bw_delay_do_load(v);
 	const float y = x_0;
 
 #ifdef BW_DEBUG_DEEP
@@ -537,9 +844,23 @@ static float bw_delay_read(
 	BW_ASSERT(df >= 0.f && df < 1.f);
 	BW_ASSERT(di + df <= coeffs->len);
 
-	const size_t n = (state->idx + (state->idx >= di ? 0 : coeffs->len)) - di;
-	const size_t p = (n ? n : coeffs->len) - 1;
-	const float y = state->buf[n] + df * (state->buf[p] - state->buf[n]);
+	size_t n, p;
+	if (coeffs->mask != 0) {
+		n = (state->idx - di) & coeffs->mask;
+		p = (n - 1) & coeffs->mask;
+	} else {
+		n = (state->idx + (state->idx >= di ? 0 : coeffs->len)) - di;
+		p = (n ? n : coeffs->len) - 1;
+	}
+	float y;
+	if (state->n_valid < coeffs->len && di + 1 >= state->n_valid) {
+		// lazy reset, not all samples are written yet
+		const float yn = di < state->n_valid ? bw_delay_do_load(state->buf[n]) : state->x_0;
+		y = yn + df * (state->x_0 - yn);
+	} else {
+		const float yn = bw_delay_do_load(state->buf[n]);
+		y = yn + df * (bw_delay_do_load(state->buf[p]) - yn);
+	}
 
 	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
@@ -562,9 +883,111 @@ static void bw_delay_write(
 	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
 	BW_ASSERT(bw_is_finite(x));
 
-	state->idx++;
-	state->idx = state->idx == coeffs->len ? 0 : state->idx;
-	state->buf[state->idx] = x;
+	if (coeffs->mask != 0)
+		state->idx = (state->idx + 1) & coeffs->mask;
+	else {
+		state->idx++;
+		state->idx = state->idx == coeffs->len ? 0 : state->idx;
+	}
+	state->buf[state->idx] = bw_delay_do_store(x);
+	state->n_valid += state->n_valid < coeffs->len;
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+}
+
+static inline void bw_delay_read_block(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		const bw_delay_state * BW_RESTRICT  state,
+		size_t                              di,
+		float                               df,
+		float * BW_RESTRICT                 y,
+		size_t                              n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+	BW_ASSERT(bw_is_finite(df));
+	BW_ASSERT(df >= 0.f && df < 1.f);
+	BW_ASSERT(n_samples == 0 || di + df + (n_samples - 1) <= coeffs->len);
+	BW_ASSERT(y != BW_NULL);
+
+	if (state->n_valid < coeffs->len && di + n_samples >= state->n_valid)
+		// lazy reset, not all samples are written yet
+		for (size_t i = 0; i < n_samples; i++)
+			y[i] = bw_delay_read(coeffs, state, di + (n_samples - 1 - i), df);
+	else if (n_samples != 0) {
+		size_t n = state->idx + coeffs->len - (di + n_samples - 1);
+		n = n >= coeffs->len ? n - coeffs->len : n;
+		size_t i = 0;
+		if (df == 0.f)
+			while (i < n_samples) {
+				const size_t k = coeffs->len - n < n_samples - i ? coeffs->len - n : n_samples - i;
+				const bw_delay_sample * BW_RESTRICT b = state->buf + n;
+				float * BW_RESTRICT o = y + i;
+				for (size_t j = 0; j < k; j++)
+					o[j] = bw_delay_do_load(b[j]);
+				i += k;
+				n = 0;
+			}
+		else
+			while (i < n_samples) {
+				if (n == 0) {
+					const float b = bw_delay_do_load(state->buf[0]);
+					y[i] = b + df * (bw_delay_do_load(state->buf[coeffs->len - 1]) - b);
+					i++;
+					n = 1;
+				}
+				const size_t k = coeffs->len - n < n_samples - i ? coeffs->len - n : n_samples - i;
+				const bw_delay_sample * BW_RESTRICT b = state->buf + n;
+				const bw_delay_sample * BW_RESTRICT p = b - 1;
+				float * BW_RESTRICT o = y + i;
+				for (size_t j = 0; j < k; j++) {
+					const float v = bw_delay_do_load(b[j]);
+					o[j] = v + df * (bw_delay_do_load(p[j]) - v);
+				}
+				i += k;
+				n = 0;
+			}
+	}
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_samples));
+}
+
+static inline void bw_delay_write_block(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		bw_delay_state * BW_RESTRICT        state,
+		const float * BW_RESTRICT           x,
+		size_t                              n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
+
+	size_t i = 0;
+	while (i < n_samples) {
+		const size_t n = state->idx + 1 == coeffs->len ? 0 : state->idx + 1;
+		const size_t k = coeffs->len - n < n_samples - i ? coeffs->len - n : n_samples - i;
+		bw_delay_sample * BW_RESTRICT b = state->buf + n;
+		const float * BW_RESTRICT v = x + i;
+		for (size_t j = 0; j < k; j++)
+			b[j] = bw_delay_do_store(v[j]);
+		state->idx = n + k - 1;
+		i += k;
+	}
+	state->n_valid = coeffs->len - state->n_valid > n_samples ? state->n_valid + n_samples : coeffs->len;
 
 	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
@@ -572,6 +995,132 @@ static void bw_delay_write(
 	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
 }
 
+static inline void bw_delay_do_read_block_mac(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		const bw_delay_state * BW_RESTRICT  state,
+		size_t                              di,
+		float                               df,
+		float                               gain,
+		float * BW_RESTRICT                 y,
+		size_t                              n_samples) {
+	if (state->n_valid < coeffs->len && di + n_samples >= state->n_valid) {
+		// lazy reset, not all samples are written yet
+		for (size_t i = 0; i < n_samples; i++)
+			y[i] += gain * bw_delay_read(coeffs, state, di + (n_samples - 1 - i), df);
+		return;
+	}
+	if (n_samples == 0)
+		return;
+	size_t n = state->idx + coeffs->len - (di + n_samples - 1);
+	n = n >= coeffs->len ? n - coeffs->len : n;
+	size_t i = 0;
+	if (df == 0.f)
+		while (i < n_samples) {
+			const size_t k = coeffs->len - n < n_samples - i ? coeffs->len - n : n_samples - i;
+			const bw_delay_sample * BW_RESTRICT b = state->buf + n;
+			float * BW_RESTRICT o = y + i;
+			for (size_t j = 0; j < k; j++)
+				o[j] += gain * bw_delay_do_load(b[j]);
+			i += k;
+			n = 0;
+		}
+	else
+		while (i < n_samples) {
+			if (n == 0) {
+				const float b = bw_delay_do_load(state->buf[0]);
+				y[i] += gain * (b + df * (bw_delay_do_load(state->buf[coeffs->len - 1]) - b));
+				i++;
+				n = 1;
+			}
+			const size_t k = coeffs->len - n < n_samples - i ? coeffs->len - n : n_samples - i;
+			const bw_delay_sample * BW_RESTRICT b = state->buf + n;
+			const bw_delay_sample * BW_RESTRICT p = b - 1;
+			float * BW_RESTRICT o = y + i;
+			for (size_t j = 0; j < k; j++) {
+				const float v = bw_delay_do_load(b[j]);
+				o[j] += gain * (v + df * (bw_delay_do_load(p[j]) - v));
+			}
+			i += k;
+			n = 0;
+		}
+}
+
+static inline void bw_delay_read_taps(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		const bw_delay_state * BW_RESTRICT  state,
+		const bw_delay_tap * BW_RESTRICT    taps,
+		size_t                              n_taps,
+		float * const *                     y,
+		size_t                              n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+	BW_ASSERT(taps != BW_NULL);
+	BW_ASSERT(y != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_taps; i++)
+		BW_ASSERT(bw_is_finite(taps[i].gain));
+	for (size_t i = 0; i < n_taps; i++)
+		for (size_t j = i + 1; j < n_taps; j++)
+			BW_ASSERT(y[i] != y[j]);
+#endif
+
+	for (size_t i = 0; i < n_taps; i++) {
+		bw_delay_read_block(coeffs, state, taps[i].di, taps[i].df, y[i], n_samples);
+		if (taps[i].gain != 1.f)
+			bw_buf_scale(y[i], taps[i].gain, y[i], n_samples);
+	}
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+}
+
+static inline void bw_delay_read_taps_sum(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		const bw_delay_state * BW_RESTRICT  state,
+		const bw_delay_tap * BW_RESTRICT    taps,
+		size_t                              n_taps,
+		float * BW_RESTRICT                 y,
+		size_t                              n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+	BW_ASSERT(taps != BW_NULL);
+	BW_ASSERT(y != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_taps; i++) {
+		BW_ASSERT(bw_is_finite(taps[i].df));
+		BW_ASSERT(taps[i].df >= 0.f && taps[i].df < 1.f);
+		BW_ASSERT(n_samples == 0 || taps[i].di + taps[i].df + (n_samples - 1) <= coeffs->len);
+		BW_ASSERT(bw_is_finite(taps[i].gain));
+	}
+#endif
+
+	if (n_taps == 0)
+		bw_buf_fill(0.f, y, n_samples);
+	else {
+		bw_delay_read_block(coeffs, state, taps[0].di, taps[0].df, y, n_samples);
+		if (taps[0].gain != 1.f)
+			bw_buf_scale(y, taps[0].gain, y, n_samples);
+		for (size_t i = 1; i < n_taps; i++)
+			bw_delay_do_read_block_mac(coeffs, state, taps[i].di, taps[i].df, taps[i].gain, y, n_samples);
+	}
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_delay_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_delay_state_state_reset_state);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_samples));
+}
+
 static inline void bw_delay_update_coeffs_ctrl(
 		bw_delay_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -617,6 +1166,27 @@ static inline float bw_delay_process1(
 	return y;
 }
 
+static inline void bw_delay_do_process(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		bw_delay_state * BW_RESTRICT        state,
+		const float *                       x,
+		float *                             y,
+		size_t                              n_samples) {
+	if (n_samples < 8) {
+		for (size_t i = 0; i < n_samples; i++)
+			y[i] = bw_delay_process1(coeffs, state, x[i]);
+		return;
+	}
+	// longest block that can be written before reading without overwriting
+	// samples that are still to be read
+	const size_t m = coeffs->len - coeffs->di - (coeffs->df != 0.f);
+	for (size_t i = 0; i < n_samples; i += m) {
+		const size_t n = m < n_samples - i ? m : n_samples - i;
+		bw_delay_write_block(coeffs, state, x + i, n);
+		bw_delay_read_block(coeffs, state, coeffs->di, coeffs->df, y + i, n);
+	}
+}
+
 static inline void bw_delay_process(
 		bw_delay_coeffs * BW_RESTRICT coeffs,
 		bw_delay_state * BW_RESTRICT  state,
@@ -633,9 +1203,10 @@ static inline void bw_delay_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_delay_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++)
-		y[i] = bw_delay_process1(coeffs, state, x[i]);
+	bw_delay_do_process(coeffs, state, x, y, n_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
@@ -668,10 +1239,11 @@ static inline void bw_delay_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_delay_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++)
-		for (size_t j = 0; j < n_channels; j++)
-			y[j][i] = bw_delay_process1(coeffs, state[j], x[j][i]);
+	for (size_t i = 0; i < n_channels; i++)
+		bw_delay_do_process(coeffs, state[i], x[i], y[i], n_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_reset_coeffs);
@@ -694,6 +1266,32 @@ static inline void bw_delay_set_delay(
 	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
 }
 
+static inline void bw_delay_set_lazy_reset(
+		bw_delay_coeffs * BW_RESTRICT coeffs,
+		char                          value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+
+	coeffs->lazy_reset = value;
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+}
+
+static inline void bw_delay_set_pow2_length(
+		bw_delay_coeffs * BW_RESTRICT coeffs,
+		char                          value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+
+	coeffs->pow2_length = value;
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+}
+
 static inline size_t bw_delay_get_length(
 		const bw_delay_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -703,6 +1301,24 @@ static inline size_t bw_delay_get_length(
 	return coeffs->len;
 }
 
+static inline void bw_delay_set_profile_stats(
+		bw_delay_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *            stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_delay_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_delay_coeffs_state_init);
+}
+
 static inline char bw_delay_coeffs_is_valid(
 		const bw_delay_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -725,6 +1341,8 @@ static inline char bw_delay_coeffs_is_valid(
 			return 0;
 		if (coeffs->len == 0)
 			return 0;
+		if (coeffs->mask != 0 && (coeffs->mask != coeffs->len - 1 || (coeffs->len & coeffs->mask) != 0))
+			return 0;
 	}
 
 	if (coeffs->state >= bw_delay_coeffs_state_reset_coeffs) {
@@ -762,6 +1380,10 @@ static inline char bw_delay_state_is_valid(
 
 		if (state->idx >= coeffs->len)
 			return 0;
+		if (state->n_valid == 0 || state->n_valid > coeffs->len)
+			return 0;
+		if (!bw_is_finite(state->x_0))
+			return 0;
 	}
 #endif
 
@@ -772,6 +1394,7 @@ static inline char bw_delay_state_is_valid(
 }
 
 #include <array>
+#include <bw_arena.h>
 
 namespace Brickworks {
 
@@ -788,9 +1411,16 @@ public:
 
 	~Delay();
 
-	void setSampleRate(
+	bool setSampleRate(
+		float sampleRate);
+
+	size_t getMemReq(
 		float sampleRate);
 
+	void setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size);
+
 	void reset(
 		float               x0 = 0.f,
 		float * BW_RESTRICT y0 = nullptr);
@@ -820,10 +1450,44 @@ public:
 	void setDelay(
 		float value);
 
+	void setLazyReset(
+		bool value);
+
+	void setPow2Length(
+		bool value);
+
 	size_t getLength();
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
+ *
+ *    By default, `setSampleRate()` allocates the memory needed by all
+ *    channels, which is owned and later released by the object. It only
+ *    reallocates when the owned block is too small, hence going back to a
+ *    lower or previously used sample rate does not allocate. After
+ *    `setMemory()` is called, `setSampleRate()` uses the caller-owned
+ *    `memory` block of `size` bytes instead and never allocates, so that it
+ *    can be called from a realtime thread. Passing `nullptr` restores the
+ *    default behavior.
+ *
+ *    `setMemory()` only takes effect at the next successful `setSampleRate()`
+ *    call, until which the object keeps using its current memory. If the
+ *    object owned a memory block, such call releases it, hence, to avoid
+ *    deallocating on a realtime thread, either call `setMemory()` before
+ *    the first `setSampleRate()` or make the first `setSampleRate()` after
+ *    `setMemory()` on a non-realtime thread.
+ *
+ *    `setSampleRate()` returns `false` and leaves the object unchanged if
+ *    `size` is too small for the new sample rate, `true` otherwise.
+ *
+ *    `getMemReq()` returns the minimum `size` needed to use any sample rate
+ *    up to `sampleRate`.
+ *
+ *    In both cases, the memory of each channel is aligned to
+ *    `BW_ARENA_ALIGN` bytes (see [bw_arena](bw_arena)).
  *  }}} */
 
 /*** Implementation ***/
@@ -836,6 +1500,9 @@ private:
 	bw_delay_state			states[N_CHANNELS];
 	bw_delay_state * BW_RESTRICT	statesP[N_CHANNELS];
 	void * BW_RESTRICT		mem;
+	size_t				memSize;
+	void * BW_RESTRICT		userMem;
+	size_t				userMemSize;
 };
 
 template<size_t N_CHANNELS>
@@ -844,6 +1511,9 @@ inline Delay<N_CHANNELS>::Delay(float maxDelay) {
 	for (size_t i = 0; i < N_CHANNELS; i++)
 		statesP[i] = states + i;
 	mem = nullptr;
+	memSize = 0;
+	userMem = nullptr;
+	userMemSize = 0;
 }
 
 template<size_t N_CHANNELS>
@@ -853,16 +1523,59 @@ inline Delay<N_CHANNELS>::~Delay() {
 }
 
 template<size_t N_CHANNELS>
-inline void Delay<N_CHANNELS>::setSampleRate(
+inline bool Delay<N_CHANNELS>::setSampleRate(
 		float sampleRate) {
-	bw_delay_set_sample_rate(&coeffs, sampleRate);
-	size_t req = bw_delay_mem_req(&coeffs);
-	if (mem != nullptr)
+	bw_delay_coeffs c = coeffs;
+	bw_delay_set_sample_rate(&c, sampleRate);
+	const size_t req = bw_delay_mem_req(&c);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	const size_t size = bw_arena_get_mem_req(&arena);
+	if (userMem != nullptr) {
+		if (size > userMemSize)
+			return false;
+		bw_arena_mem_set(&arena, userMem);
+	} else {
+		if (size > memSize) {
+			if (mem != nullptr)
+				operator delete(mem);
+			mem = operator new(size);
+			memSize = size;
+		}
+		bw_arena_mem_set(&arena, mem);
+	}
+	coeffs = c;
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_delay_mem_set(&coeffs, states + i, bw_arena_alloc(&arena, req));
+	if (userMem != nullptr && mem != nullptr) {
+		// states do not point into the owned block anymore
 		operator delete(mem);
-	mem = operator new(req * N_CHANNELS);
-	void *m = mem;
-	for (size_t i = 0; i < N_CHANNELS; i++, m = static_cast<char *>(m) + req)
-		bw_delay_mem_set(&coeffs, states + i, m);
+		mem = nullptr;
+		memSize = 0;
+	}
+	return true;
+}
+
+template<size_t N_CHANNELS>
+inline size_t Delay<N_CHANNELS>::getMemReq(
+		float sampleRate) {
+	const size_t req = bw_delay_mem_req_max(&coeffs, sampleRate);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	return bw_arena_get_mem_req(&arena);
+}
+
+template<size_t N_CHANNELS>
+inline void Delay<N_CHANNELS>::setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size) {
+	BW_ASSERT(memory != nullptr || size == 0);
+	userMem = memory;
+	userMemSize = size;
 }
 
 template<size_t N_CHANNELS>
@@ -922,11 +1635,29 @@ inline void Delay<N_CHANNELS>::setDelay(
 	bw_delay_set_delay(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Delay<N_CHANNELS>::setLazyReset(
+		bool value) {
+	bw_delay_set_lazy_reset(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Delay<N_CHANNELS>::setPow2Length(
+		bool value) {
+	bw_delay_set_pow2_length(&coeffs, value);
+}
+
 template<size_t N_CHANNELS>
 inline size_t Delay<N_CHANNELS>::getLength() {
 	return bw_delay_get_length(&coeffs);
 }
 
+template<size_t N_CHANNELS>
+inline void Delay<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_delay_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
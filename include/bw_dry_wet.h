@@ -20,15 +20,20 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_one_pole }}}
  *  description {{{
  *    Dry/wet mixer.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_dry_wet_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_dry_wet_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -152,6 +157,22 @@ static inline void bw_dry_wet_process_multi(
  *    first `n_samples` of the `n_channels` output buffers `y`, while using and
  *    updating the common `coeffs` (control and audio rate).
  *
+ *    #### bw_dry_wet_process_interleaved()
+ *  ```>>> */
+static inline void bw_dry_wet_process_interleaved(
+	bw_dry_wet_coeffs * BW_RESTRICT coeffs,
+	const float *                   x_dry,
+	const float *                   x_wet,
+	float *                         y,
+	size_t                          n_channels,
+	size_t                          n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved dry input buffer
+ *    `x_dry` and of the interleaved wet input buffer `x_wet`, and fills the
+ *    first `n_frames` frames of the interleaved output buffer `y`, all made of
+ *    `n_channels` channels, while using and updating the common `coeffs`
+ *    (control and audio rate).
+ *
  *    #### bw_dry_wet_set_wet()
  *  ```>>> */
 static inline void bw_dry_wet_set_wet(
@@ -176,6 +197,20 @@ static inline void bw_dry_wet_set_smooth_tau(
  *
  *    Default value: `0.05f`.
  *
+ *    #### bw_dry_wet_set_profile_stats()
+ *  ```>>> */
+static inline void bw_dry_wet_set_profile_stats(
+	bw_dry_wet_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *              stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_dry_wet_process()`,
+ *    `bw_dry_wet_process_multi()`, and `bw_dry_wet_process_interleaved()`
+ *    update when using `coeffs` if `BW_PROFILE` is defined (see
+ *    [bw_common](bw_common)). If `stats` is `BW_NULL`, no profiling takes
+ *    place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_dry_wet_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_dry_wet_coeffs_is_valid(
@@ -218,6 +253,9 @@ struct bw_dry_wet_coeffs {
 	uint32_t			hash;
 	enum bw_dry_wet_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_gain_coeffs			gain_coeffs;
@@ -229,6 +267,9 @@ static inline void bw_dry_wet_init(
 
 	bw_gain_init(&coeffs->gain_coeffs);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_dry_wet_coeffs");
 	coeffs->state = bw_dry_wet_coeffs_state_init;
@@ -327,11 +368,13 @@ static inline void bw_dry_wet_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x_wet, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_dry_wet_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_dry_wet_update_coeffs_audio(coeffs);
 		y[i] = bw_dry_wet_process1(coeffs, x_dry[i], x_wet[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_dry_wet_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_reset_coeffs);
@@ -357,15 +400,47 @@ static inline void bw_dry_wet_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_dry_wet_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_dry_wet_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_dry_wet_process1(coeffs, x_dry[j][i], x_wet[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_dry_wet_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_dry_wet_process_interleaved(
+		bw_dry_wet_coeffs * BW_RESTRICT coeffs,
+		const float *                   x_dry,
+		const float *                   x_wet,
+		float *                         y,
+		size_t                          n_channels,
+		size_t                          n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_dry_wet_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_reset_coeffs);
+	BW_ASSERT(x_dry != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x_dry, n_channels * n_frames));
+	BW_ASSERT(x_wet != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x_wet, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_dry_wet_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_dry_wet_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_dry_wet_process1(coeffs, x_dry[k], x_wet[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
 
 	BW_ASSERT_DEEP(bw_dry_wet_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
 }
 
 static inline void bw_dry_wet_set_wet(
@@ -398,6 +473,24 @@ static inline void bw_dry_wet_set_smooth_tau(
 	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_init);
 }
 
+static inline void bw_dry_wet_set_profile_stats(
+		bw_dry_wet_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *              stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_dry_wet_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_dry_wet_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_dry_wet_coeffs_state_init);
+}
+
 static inline char bw_dry_wet_coeffs_is_valid(
 		const bw_dry_wet_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -446,11 +539,20 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * xDry,
+		const float * xWet,
+		float *       y,
+		size_t        nFrames);
+
 	void setWet(
 		float value);
 
 	void setSmoothTau(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -499,6 +601,15 @@ inline void DryWet<N_CHANNELS>::process(
 	process(xDry.data(), xWet.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void DryWet<N_CHANNELS>::processInterleaved(
+		const float * xDry,
+		const float * xWet,
+		float *       y,
+		size_t        nFrames) {
+	bw_dry_wet_process_interleaved(&coeffs, xDry, xWet, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void DryWet<N_CHANNELS>::setWet(
 		float value) {
@@ -511,6 +622,12 @@ inline void DryWet<N_CHANNELS>::setSmoothTau(
 	bw_dry_wet_set_smooth_tau(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void DryWet<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_dry_wet_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
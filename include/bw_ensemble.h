@@ -0,0 +1,1308 @@
+/*
+ * Brickworks
+ *
+ * Copyright (C) 2024 Orastron Srl unipersonale
+ *
+ * Brickworks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Brickworks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Brickworks.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File author: agent
+ */
+
+/*!
+ *  module_type {{{ dsp }}}
+ *  version {{{ 1.1.0 }}}
+ *  requires {{{
+ *    bw_arena bw_buf bw_common bw_delay bw_gain bw_math bw_one_pole
+ *    bw_phase_gen
+ *  }}}
+ *  description {{{
+ *    Multi-voice ensemble chorus with variable rate and amount.
+ *
+ *    It outputs a mix of the dry input signal with the average of up to
+ *    `BW_ENSEMBLE_MAX_VOICES` modulated delay taps, whose sinusoidal
+ *    modulating signals are evenly spread in phase.
+ *
+ *    Contrary to stacking several [bw_chorus](bw_chorus) instances, all voices
+ *    read from one delay line per channel, hence memory usage and delay line
+ *    writes do not grow with the number of voices. Also, all modulating
+ *    signals are derived from one phase generator and evaluated together for
+ *    all voices.
+ *  }}}
+ *  changelog {{{
+ *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>First release.</li>
+ *        </ul>
+ *      </li>
+ *    </ul>
+ *  }}}
+ */
+
+#ifndef BW_ENSEMBLE_H
+#define BW_ENSEMBLE_H
+
+#include <bw_common.h>
+
+/*! ...
+ *
+ *    #### BW_ENSEMBLE_MAX_VOICES
+ *
+ *    `BW_ENSEMBLE_MAX_VOICES` is the maximum number of voices.
+ *
+ *    If it is not defined already, then it gets defined as `8`. Its value
+ *    determines the size of `bw_ensemble_coeffs`.
+ *
+ *  >>> */
+#ifndef BW_ENSEMBLE_MAX_VOICES
+# define BW_ENSEMBLE_MAX_VOICES 8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! api {{{
+ *    #### bw_ensemble_coeffs
+ *  ```>>> */
+typedef struct bw_ensemble_coeffs bw_ensemble_coeffs;
+/*! <<<```
+ *    Coefficients and related.
+ *
+ *    #### bw_ensemble_state
+ *  ```>>> */
+typedef struct bw_ensemble_state bw_ensemble_state;
+/*! <<<```
+ *    Internal state and related.
+ *
+ *    #### bw_ensemble_init()
+ *  ```>>> */
+static inline void bw_ensemble_init(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            max_delay);
+/*! <<<```
+ *    Initializes input parameter values in `coeffs` using `max_delay` (s) as
+ *    the maximum delay time.
+ *
+ *    `max_delay` must be finite and non-negative.
+ *
+ *    #### bw_ensemble_set_sample_rate()
+ *  ```>>> */
+static inline void bw_ensemble_set_sample_rate(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            sample_rate);
+/*! <<<```
+ *    Sets the `sample_rate` (Hz) value in `coeffs`.
+ *
+ *    #### bw_ensemble_mem_req()
+ *  ```>>> */
+static inline size_t bw_ensemble_mem_req(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Returns the size, in bytes, of contiguous memory to be supplied to
+ *    `bw_ensemble_mem_set()` using `coeffs`.
+ *
+ *    It does not depend on the number of voices.
+ *
+ *    #### bw_ensemble_mem_req_max()
+ *  ```>>> */
+static inline size_t bw_ensemble_mem_req_max(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                                  max_sample_rate);
+/*! <<<```
+ *    Returns the size, in bytes, of contiguous memory to be supplied to
+ *    `bw_ensemble_mem_set()` using `coeffs` so that it can be reused at any
+ *    sample rate up to `max_sample_rate` (Hz).
+ *
+ *    After `bw_ensemble_set_sample_rate()` is called with a `sample_rate` not
+ *    greater than `max_sample_rate`, the same memory block can be associated
+ *    again by calling `bw_ensemble_mem_set()`, which neither allocates nor
+ *    touches the memory, and then `bw_ensemble_reset_state()` as usual.
+ *
+ *    It can be called any time after `bw_ensemble_init()`.
+ *
+ *    `max_sample_rate` must be finite and positive.
+ *
+ *    #### bw_ensemble_mem_set()
+ *  ```>>> */
+static inline void bw_ensemble_mem_set(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	bw_ensemble_state * BW_RESTRICT        state,
+	void * BW_RESTRICT                     mem);
+/*! <<<```
+ *    Associates the contiguous memory block `mem` to the given `state` using
+ *    `coeffs`.
+ *
+ *    #### bw_ensemble_reset_coeffs()
+ *  ```>>> */
+static inline void bw_ensemble_reset_coeffs(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Resets coefficients in `coeffs` to assume their target values.
+ *
+ *    #### bw_ensemble_reset_state()
+ *  ```>>> */
+static inline float bw_ensemble_reset_state(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	bw_ensemble_state * BW_RESTRICT        state,
+	float                                  x_0);
+/*! <<<```
+ *    Resets the given `state` to its initial values using the given `coeffs`
+ *    and the initial input value `x_0`.
+ *
+ *    Returns the corresponding initial output value.
+ *
+ *    #### bw_ensemble_reset_state_multi()
+ *  ```>>> */
+static inline void bw_ensemble_reset_state_multi(
+	const bw_ensemble_coeffs * BW_RESTRICT              coeffs,
+	bw_ensemble_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                       x_0,
+	float *                                             y_0,
+	size_t                                              n_channels);
+/*! <<<```
+ *    Resets each of the `n_channels` `state`s to its initial values using the
+ *    given `coeffs` and the corresponding initial input value in the `x_0`
+ *    array.
+ *
+ *    The corresponding initial output values are written into the `y_0` array,
+ *    if not `BW_NULL`.
+ *
+ *    #### bw_ensemble_update_coeffs_ctrl()
+ *  ```>>> */
+static inline void bw_ensemble_update_coeffs_ctrl(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Triggers control-rate update of coefficients in `coeffs`.
+ *
+ *    #### bw_ensemble_update_coeffs_audio()
+ *  ```>>> */
+static inline void bw_ensemble_update_coeffs_audio(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Triggers audio-rate update of coefficients in `coeffs`.
+ *
+ *    #### bw_ensemble_process1()
+ *  ```>>> */
+static inline float bw_ensemble_process1(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	bw_ensemble_state * BW_RESTRICT        state,
+	float                                  x);
+/*! <<<```
+ *    Processes one input sample `x` using `coeffs`, while using and updating
+ *    `state`. Returns the corresponding output sample.
+ *
+ *    #### bw_ensemble_process()
+ *  ```>>> */
+static inline void bw_ensemble_process(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	bw_ensemble_state * BW_RESTRICT  state,
+	const float *                    x,
+	float *                          y,
+	size_t                           n_samples);
+/*! <<<```
+ *    Processes the first `n_samples` of the input buffer `x` and fills the
+ *    first `n_samples` of the output buffer `y`, while using and updating both
+ *    `coeffs` and `state` (control and audio rate).
+ *
+ *    #### bw_ensemble_process_multi()
+ *  ```>>> */
+static inline void bw_ensemble_process_multi(
+	bw_ensemble_coeffs * BW_RESTRICT                    coeffs,
+	bw_ensemble_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float * const *                               x,
+	float * const *                                     y,
+	size_t                                              n_channels,
+	size_t                                              n_samples);
+/*! <<<```
+ *    Processes the first `n_samples` of the `n_channels` input buffers `x` and
+ *    fills the first `n_samples` of the `n_channels` output buffers `y`, while
+ *    using and updating both the common `coeffs` and each of the `n_channels`
+ *    `state`s (control and audio rate).
+ *
+ *    #### bw_ensemble_set_voices()
+ *  ```>>> */
+static inline void bw_ensemble_set_voices(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	size_t                           value);
+/*! <<<```
+ *    Sets the number of voices `value` in `coeffs`.
+ *
+ *    Voice `k` is modulated with a phase offset of `k` / `value` of a cycle.
+ *
+ *    Valid range: [`1`, `BW_ENSEMBLE_MAX_VOICES`].
+ *
+ *    Default value: `3`.
+ *
+ *    #### bw_ensemble_set_rate()
+ *  ```>>> */
+static inline void bw_ensemble_set_rate(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            value);
+/*! <<<```
+ *    Sets the modulation rate `value` (Hz) in `coeffs`.
+ *
+ *    `value` must be finite.
+ *
+ *    Default value: `1.f`.
+ *
+ *    #### bw_ensemble_set_delay()
+ *  ```>>> */
+static inline void bw_ensemble_set_delay(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            value);
+/*! <<<```
+ *    Sets the center delay `value` (s) in `coeffs`.
+ *
+ *    The actual instantaneous delay of each voice is internally limited to
+ *    avoid buffer overflows.
+ *
+ *    `value` must be finite.
+ *
+ *    Default value: `0.f`.
+ *
+ *    #### bw_ensemble_set_amount()
+ *  ```>>> */
+static inline void bw_ensemble_set_amount(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            value);
+/*! <<<```
+ *    Sets the delay modulation amount (semi-amplitude) `value` (s) in `coeffs`.
+ *
+ *    The actual instantaneous delay of each voice is internally limited to
+ *    avoid buffer overflows.
+ *
+ *    `value` must be finite.
+ *
+ *    Default value: `0.f`.
+ *
+ *    #### bw_ensemble_set_coeff_x()
+ *  ```>>> */
+static inline void bw_ensemble_set_coeff_x(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            value);
+/*! <<<```
+ *    Sets the input coefficient `value` in `coeffs`.
+ *
+ *    `value` must be finite.
+ *
+ *    Default value: `1.f`.
+ *
+ *    #### bw_ensemble_set_coeff_mod()
+ *  ```>>> */
+static inline void bw_ensemble_set_coeff_mod(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	float                            value);
+/*! <<<```
+ *    Sets the modulated branch coefficient `value` in `coeffs`, which is
+ *    applied to the average of all voices.
+ *
+ *    `value` must be finite.
+ *
+ *    Default value: `0.f`.
+ *
+ *    #### bw_ensemble_set_lazy_reset()
+ *  ```>>> */
+static inline void bw_ensemble_set_lazy_reset(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	char                             value);
+/*! <<<```
+ *    Sets whether the internal delay line should be cleared lazily when
+ *    resetting (`value` non-`0`) or not (`0`) in `coeffs`. See
+ *    `bw_delay_set_lazy_reset()` in [bw_delay](bw_delay) for more details.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_ensemble_set_pow2_length()
+ *  ```>>> */
+static inline void bw_ensemble_set_pow2_length(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	char                             value);
+/*! <<<```
+ *    Sets whether the length of the internal delay line should be rounded
+ *    up to a power of `2` (`value` non-`0`) or not (`0`) in `coeffs`. See
+ *    `bw_delay_set_pow2_length()` in [bw_delay](bw_delay) for more details.
+ *
+ *    Changes only take effect at the next `bw_ensemble_set_sample_rate()`
+ *    call.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_ensemble_set_profile_stats()
+ *  ```>>> */
+static inline void bw_ensemble_set_profile_stats(
+	bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *               stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_ensemble_process()` and
+ *    `bw_ensemble_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
+ *    #### bw_ensemble_coeffs_is_valid()
+ *  ```>>> */
+static inline char bw_ensemble_coeffs_is_valid(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Tries to determine whether `coeffs` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    `coeffs` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_ensemble_coeffs`.
+ *
+ *    #### bw_ensemble_state_is_valid()
+ *  ```>>> */
+static inline char bw_ensemble_state_is_valid(
+	const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+	const bw_ensemble_state * BW_RESTRICT  state);
+/*! <<<```
+ *    Tries to determine whether `state` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    If `coeffs` is not `BW_NULL` extra cross-checks might be performed
+ *    (`state` is supposed to be associated to `coeffs`).
+ *
+ *    `state` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_ensemble_state`.
+ *  }}} */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+#include <bw_math.h>
+#include <bw_phase_gen.h>
+#include <bw_one_pole.h>
+#include <bw_gain.h>
+#include <bw_delay.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef BW_DEBUG_DEEP
+enum bw_ensemble_coeffs_state {
+	bw_ensemble_coeffs_state_invalid,
+	bw_ensemble_coeffs_state_init,
+	bw_ensemble_coeffs_state_set_sample_rate,
+	bw_ensemble_coeffs_state_reset_coeffs
+};
+#endif
+
+#ifdef BW_DEBUG_DEEP
+enum bw_ensemble_state_state {
+	bw_ensemble_state_state_invalid,
+	bw_ensemble_state_state_mem_set,
+	bw_ensemble_state_state_reset_state
+};
+#endif
+
+struct bw_ensemble_coeffs {
+#ifdef BW_DEBUG_DEEP
+	uint32_t			hash;
+	enum bw_ensemble_coeffs_state	state;
+	uint32_t			reset_id;
+#endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
+
+	// Sub-components
+	bw_phase_gen_coeffs		phase_gen_coeffs;
+	bw_phase_gen_state		phase_gen_state;
+	bw_one_pole_coeffs		smooth_coeffs;
+	bw_one_pole_state		smooth_delay_state;
+	bw_one_pole_state		smooth_amount_state;
+	bw_gain_coeffs			dry_coeffs;
+	bw_gain_coeffs			wet_coeffs;
+	bw_delay_coeffs			delay_coeffs;
+
+	// Coefficients
+	float				fs;
+	float				d_max;
+
+	// Voices (one array per field, so that they are updated together)
+	float				voice_phase[BW_ENSEMBLE_MAX_VOICES];
+	float				voice_mod[BW_ENSEMBLE_MAX_VOICES];
+	size_t				voice_di[BW_ENSEMBLE_MAX_VOICES];
+	float				voice_df[BW_ENSEMBLE_MAX_VOICES];
+
+	// Parameters
+	size_t				n_voices;
+	float				delay;
+	float				amount;
+	float				coeff_mod;
+};
+
+struct bw_ensemble_state {
+#ifdef BW_DEBUG_DEEP
+	uint32_t			hash;
+	enum bw_ensemble_state_state	state;
+	uint32_t			coeffs_reset_id;
+#endif
+
+	// Sub-components
+	bw_delay_state			delay_state;
+};
+
+static inline void bw_ensemble_do_set_voices(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		size_t                           n_voices) {
+	const float k = 1.f / (float)n_voices;
+	for (size_t i = 0; i < n_voices; i++)
+		coeffs->voice_phase[i] = k * (float)i;
+	bw_gain_set_gain_lin(&coeffs->wet_coeffs, k * coeffs->coeff_mod);
+	coeffs->n_voices = n_voices;
+}
+
+static inline void bw_ensemble_init(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            max_delay) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT(bw_is_finite(max_delay));
+	BW_ASSERT(max_delay >= 0.f);
+
+	bw_phase_gen_init(&coeffs->phase_gen_coeffs);
+	bw_one_pole_init(&coeffs->smooth_coeffs);
+	bw_one_pole_set_tau(&coeffs->smooth_coeffs, 0.05f);
+	bw_one_pole_set_sticky_thresh(&coeffs->smooth_coeffs, 1e-6f);
+	bw_gain_init(&coeffs->dry_coeffs);
+	bw_gain_init(&coeffs->wet_coeffs);
+	bw_delay_init(&coeffs->delay_coeffs, max_delay);
+	coeffs->delay = 0.f;
+	coeffs->amount = 0.f;
+	coeffs->coeff_mod = 0.f;
+	bw_ensemble_do_set_voices(coeffs, 3);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
+#ifdef BW_DEBUG_DEEP
+	coeffs->hash = bw_hash_sdbm("bw_ensemble_coeffs");
+	coeffs->state = bw_ensemble_coeffs_state_init;
+	coeffs->reset_id = coeffs->hash + 1;
+#endif
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state == bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_sample_rate(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            sample_rate) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(sample_rate) && sample_rate > 0.f);
+
+	bw_phase_gen_set_sample_rate(&coeffs->phase_gen_coeffs, sample_rate);
+	bw_one_pole_set_sample_rate(&coeffs->smooth_coeffs, sample_rate);
+	bw_one_pole_reset_coeffs(&coeffs->smooth_coeffs);
+	bw_gain_set_sample_rate(&coeffs->dry_coeffs, sample_rate);
+	bw_gain_set_sample_rate(&coeffs->wet_coeffs, sample_rate);
+	bw_delay_set_sample_rate(&coeffs->delay_coeffs, sample_rate);
+	coeffs->fs = sample_rate;
+	coeffs->d_max = (float)(bw_delay_get_length(&coeffs->delay_coeffs) - 1);
+
+#ifdef BW_DEBUG_DEEP
+	coeffs->state = bw_ensemble_coeffs_state_set_sample_rate;
+#endif
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state == bw_ensemble_coeffs_state_set_sample_rate);
+}
+
+static inline size_t bw_ensemble_mem_req(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_set_sample_rate);
+
+	return bw_delay_mem_req(&coeffs->delay_coeffs);
+}
+
+static inline size_t bw_ensemble_mem_req_max(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                                  max_sample_rate) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(max_sample_rate) && max_sample_rate > 0.f);
+
+	return bw_delay_mem_req_max(&coeffs->delay_coeffs, max_sample_rate);
+}
+
+static inline void bw_ensemble_mem_set(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		bw_ensemble_state * BW_RESTRICT        state,
+		void * BW_RESTRICT                     mem) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_set_sample_rate);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT(mem != BW_NULL);
+
+	bw_delay_mem_set(&coeffs->delay_coeffs, &state->delay_state, mem);
+
+#ifdef BW_DEBUG_DEEP
+	state->hash = bw_hash_sdbm("bw_ensemble_state");
+	state->state = bw_ensemble_state_state_mem_set;
+#endif
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_set_sample_rate);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state == bw_ensemble_state_state_mem_set);
+}
+
+static inline void bw_ensemble_do_update_voices(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            phase) {
+	const size_t n = coeffs->n_voices;
+	const float d = coeffs->fs * bw_one_pole_get_y_z1(&coeffs->smooth_delay_state);
+	const float a = coeffs->fs * bw_one_pole_get_y_z1(&coeffs->smooth_amount_state);
+	for (size_t i = 0; i < n; i++)
+		coeffs->voice_mod[i] = phase + coeffs->voice_phase[i];
+	bw_sin2pif_buf(coeffs->voice_mod, coeffs->voice_mod, n);
+	for (size_t i = 0; i < n; i++) {
+		float di;
+		bw_intfracf(bw_clipf(d + a * coeffs->voice_mod[i], 0.f, coeffs->d_max), &di, coeffs->voice_df + i);
+		coeffs->voice_di[i] = (size_t)di;
+	}
+}
+
+static inline void bw_ensemble_reset_coeffs(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_set_sample_rate);
+
+	bw_phase_gen_reset_coeffs(&coeffs->phase_gen_coeffs);
+	float p, pi;
+	bw_phase_gen_reset_state(&coeffs->phase_gen_coeffs, &coeffs->phase_gen_state, 0.f, &p, &pi);
+	bw_one_pole_reset_state(&coeffs->smooth_coeffs, &coeffs->smooth_delay_state, coeffs->delay);
+	bw_one_pole_reset_state(&coeffs->smooth_coeffs, &coeffs->smooth_amount_state, coeffs->amount);
+	bw_gain_reset_coeffs(&coeffs->dry_coeffs);
+	bw_gain_reset_coeffs(&coeffs->wet_coeffs);
+	bw_delay_reset_coeffs(&coeffs->delay_coeffs);
+	bw_ensemble_do_update_voices(coeffs, p);
+
+#ifdef BW_DEBUG_DEEP
+	coeffs->state = bw_ensemble_coeffs_state_reset_coeffs;
+	coeffs->reset_id++;
+#endif
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state == bw_ensemble_coeffs_state_reset_coeffs);
+}
+
+static inline float bw_ensemble_reset_state(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		bw_ensemble_state * BW_RESTRICT        state,
+		float                                  x_0) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_ensemble_state_state_mem_set);
+	BW_ASSERT(bw_is_finite(x_0));
+
+	bw_delay_reset_state(&coeffs->delay_coeffs, &state->delay_state, x_0);
+	const float y = bw_gain_process1(&coeffs->dry_coeffs, x_0) + bw_gain_process1(&coeffs->wet_coeffs, (float)coeffs->n_voices * x_0);
+
+#ifdef BW_DEBUG_DEEP
+	state->state = bw_ensemble_state_state_reset_state;
+	state->coeffs_reset_id = coeffs->reset_id;
+#endif
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_ensemble_state_state_reset_state);
+	BW_ASSERT(bw_is_finite(y));
+
+	return y;
+}
+
+static inline void bw_ensemble_reset_state_multi(
+		const bw_ensemble_coeffs * BW_RESTRICT              coeffs,
+		bw_ensemble_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                       x_0,
+		float *                                             y_0,
+		size_t                                              n_channels) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x_0 != BW_NULL);
+
+	if (y_0 != BW_NULL)
+		for (size_t i = 0; i < n_channels; i++)
+			y_0[i] = bw_ensemble_reset_state(coeffs, state[i], x_0[i]);
+	else
+		for (size_t i = 0; i < n_channels; i++)
+			bw_ensemble_reset_state(coeffs, state[i], x_0[i]);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(y_0 != BW_NULL ? bw_has_only_finite(y_0, n_channels) : 1);
+}
+
+static inline void bw_ensemble_update_coeffs_ctrl(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+
+	bw_phase_gen_update_coeffs_ctrl(&coeffs->phase_gen_coeffs);
+	bw_gain_update_coeffs_ctrl(&coeffs->dry_coeffs);
+	bw_gain_update_coeffs_ctrl(&coeffs->wet_coeffs);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_ensemble_update_coeffs_audio(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+
+	bw_phase_gen_update_coeffs_audio(&coeffs->phase_gen_coeffs);
+	float p, pi;
+	bw_phase_gen_process1(&coeffs->phase_gen_coeffs, &coeffs->phase_gen_state, &p, &pi);
+	bw_one_pole_process1_sticky_abs(&coeffs->smooth_coeffs, &coeffs->smooth_delay_state, coeffs->delay);
+	bw_one_pole_process1_sticky_abs(&coeffs->smooth_coeffs, &coeffs->smooth_amount_state, coeffs->amount);
+	bw_gain_update_coeffs_audio(&coeffs->dry_coeffs);
+	bw_gain_update_coeffs_audio(&coeffs->wet_coeffs);
+	bw_ensemble_do_update_voices(coeffs, p);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+}
+
+static inline float bw_ensemble_process1(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		bw_ensemble_state * BW_RESTRICT        state,
+		float                                  x) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_ensemble_state_state_reset_state);
+	BW_ASSERT(bw_is_finite(x));
+
+	bw_delay_write(&coeffs->delay_coeffs, &state->delay_state, x);
+	float v = 0.f;
+	for (size_t i = 0; i < coeffs->n_voices; i++)
+		v += bw_delay_read(&coeffs->delay_coeffs, &state->delay_state, coeffs->voice_di[i], coeffs->voice_df[i]);
+	const float y = bw_gain_process1(&coeffs->dry_coeffs, x) + bw_gain_process1(&coeffs->wet_coeffs, v);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_ensemble_state_state_reset_state);
+	BW_ASSERT(bw_is_finite(y));
+
+	return y;
+}
+
+static inline void bw_ensemble_process(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		bw_ensemble_state * BW_RESTRICT  state,
+		const float *                    x,
+		float *                          y,
+		size_t                           n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_ensemble_state_state_reset_state);
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_ensemble_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0; i < n_samples; i++) {
+		bw_ensemble_update_coeffs_audio(coeffs);
+		y[i] = bw_ensemble_process1(coeffs, state, x[i]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_ensemble_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_ensemble_state_state_reset_state);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_samples));
+}
+
+static inline void bw_ensemble_process_multi(
+		bw_ensemble_coeffs * BW_RESTRICT                    coeffs,
+		bw_ensemble_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float * const *                               x,
+		float * const *                                     y,
+		size_t                                              n_channels,
+		size_t                                              n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT(y != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(y[i] != y[j]);
+#endif
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_ensemble_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0; i < n_samples; i++) {
+		bw_ensemble_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++)
+			y[j][i] = bw_ensemble_process1(coeffs, state[j], x[j][i]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_ensemble_set_voices(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		size_t                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(value >= 1 && value <= BW_ENSEMBLE_MAX_VOICES);
+
+	bw_ensemble_do_set_voices(coeffs, value);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_rate(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+
+	bw_phase_gen_set_frequency(&coeffs->phase_gen_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_delay(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+
+	coeffs->delay = value;
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_amount(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+
+	coeffs->amount = value;
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_coeff_x(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+
+	bw_gain_set_gain_lin(&coeffs->dry_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_coeff_mod(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		float                            value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+
+	coeffs->coeff_mod = value;
+	bw_gain_set_gain_lin(&coeffs->wet_coeffs, value / (float)coeffs->n_voices);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_lazy_reset(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		char                             value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+
+	bw_delay_set_lazy_reset(&coeffs->delay_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_pow2_length(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		char                             value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+
+	bw_delay_set_pow2_length(&coeffs->delay_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline void bw_ensemble_set_profile_stats(
+		bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *               stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_ensemble_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ensemble_coeffs_state_init);
+}
+
+static inline char bw_ensemble_coeffs_is_valid(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+
+#ifdef BW_DEBUG_DEEP
+	if (coeffs->hash != bw_hash_sdbm("bw_ensemble_coeffs"))
+		return 0;
+	if (coeffs->state < bw_ensemble_coeffs_state_init || coeffs->state > bw_ensemble_coeffs_state_reset_coeffs)
+		return 0;
+#endif
+
+	if (coeffs->n_voices < 1 || coeffs->n_voices > BW_ENSEMBLE_MAX_VOICES)
+		return 0;
+	if (!bw_is_finite(coeffs->delay))
+		return 0;
+	if (!bw_is_finite(coeffs->amount))
+		return 0;
+	if (!bw_is_finite(coeffs->coeff_mod))
+		return 0;
+	for (size_t i = 0; i < coeffs->n_voices; i++)
+		if (!(coeffs->voice_phase[i] >= 0.f && coeffs->voice_phase[i] < 1.f))
+			return 0;
+
+	if (!bw_phase_gen_coeffs_is_valid(&coeffs->phase_gen_coeffs)
+		|| !bw_one_pole_coeffs_is_valid(&coeffs->smooth_coeffs)
+		|| !bw_gain_coeffs_is_valid(&coeffs->dry_coeffs)
+		|| !bw_gain_coeffs_is_valid(&coeffs->wet_coeffs))
+		return 0;
+
+#ifdef BW_DEBUG_DEEP
+	if (coeffs->state >= bw_ensemble_coeffs_state_set_sample_rate) {
+		if (!bw_is_finite(coeffs->fs) || coeffs->fs <= 0.f)
+			return 0;
+		if (!bw_is_finite(coeffs->d_max) || coeffs->d_max < 0.f)
+			return 0;
+	}
+
+	if (coeffs->state >= bw_ensemble_coeffs_state_reset_coeffs) {
+		if (!bw_phase_gen_state_is_valid(&coeffs->phase_gen_coeffs, &coeffs->phase_gen_state)
+			|| !bw_one_pole_state_is_valid(&coeffs->smooth_coeffs, &coeffs->smooth_delay_state)
+			|| !bw_one_pole_state_is_valid(&coeffs->smooth_coeffs, &coeffs->smooth_amount_state))
+			return 0;
+		for (size_t i = 0; i < coeffs->n_voices; i++)
+			if (!(coeffs->voice_df[i] >= 0.f && coeffs->voice_df[i] < 1.f)
+				|| (float)coeffs->voice_di[i] + coeffs->voice_df[i] > coeffs->d_max)
+				return 0;
+	}
+#endif
+
+	return bw_delay_coeffs_is_valid(&coeffs->delay_coeffs);
+}
+
+static inline char bw_ensemble_state_is_valid(
+		const bw_ensemble_coeffs * BW_RESTRICT coeffs,
+		const bw_ensemble_state * BW_RESTRICT  state) {
+	BW_ASSERT(state != BW_NULL);
+
+#ifdef BW_DEBUG_DEEP
+	if (state->hash != bw_hash_sdbm("bw_ensemble_state"))
+		return 0;
+	if (state->state < bw_ensemble_state_state_mem_set || state->state > bw_ensemble_state_state_reset_state)
+		return 0;
+
+	if (state->state >= bw_ensemble_state_state_reset_state && coeffs != BW_NULL && coeffs->reset_id != state->coeffs_reset_id)
+		return 0;
+#endif
+
+	return bw_delay_state_is_valid(coeffs ? &coeffs->delay_coeffs : BW_NULL, &state->delay_state);
+}
+
+#ifdef __cplusplus
+}
+
+#include <array>
+#include <bw_arena.h>
+
+namespace Brickworks {
+
+/*** Public C++ API ***/
+
+/*! api_cpp {{{
+ *    ##### Brickworks::Ensemble
+ *  ```>>> */
+template<size_t N_CHANNELS>
+class Ensemble {
+public:
+	Ensemble(
+		float maxDelay = 0.01f);
+
+	~Ensemble();
+
+	bool setSampleRate(
+		float sampleRate);
+
+	size_t getMemReq(
+		float sampleRate);
+
+	void setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size);
+
+	void reset(
+		float               x0 = 0.f,
+		float * BW_RESTRICT y0 = nullptr);
+
+	void reset(
+		float                                       x0,
+		std::array<float, N_CHANNELS> * BW_RESTRICT y0);
+
+	void reset(
+		const float * x0,
+		float *       y0 = nullptr);
+
+	void reset(
+		std::array<float, N_CHANNELS>               x0,
+		std::array<float, N_CHANNELS> * BW_RESTRICT y0 = nullptr);
+
+	void process(
+		const float * const * x,
+		float * const *       y,
+		size_t                nSamples);
+
+	void process(
+		std::array<const float *, N_CHANNELS> x,
+		std::array<float *, N_CHANNELS>       y,
+		size_t                                nSamples);
+
+	void setVoices(
+		size_t value);
+
+	void setRate(
+		float value);
+
+	void setDelay(
+		float value);
+
+	void setAmount(
+		float value);
+
+	void setCoeffX(
+		float value);
+
+	void setCoeffMod(
+		float value);
+
+	void setLazyReset(
+		bool value);
+
+	void setPow2Length(
+		bool value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
+/*! <<<...
+ *  }
+ *  ```
+ *
+ *    By default, `setSampleRate()` allocates the memory needed by all
+ *    channels, which is owned and later released by the object. It only
+ *    reallocates when the owned block is too small, hence going back to a
+ *    lower or previously used sample rate does not allocate. After
+ *    `setMemory()` is called, `setSampleRate()` uses the caller-owned
+ *    `memory` block of `size` bytes instead and never allocates, so that it
+ *    can be called from a realtime thread. Passing `nullptr` restores the
+ *    default behavior.
+ *
+ *    `setMemory()` only takes effect at the next successful `setSampleRate()`
+ *    call, until which the object keeps using its current memory. If the
+ *    object owned a memory block, such call releases it, hence, to avoid
+ *    deallocating on a realtime thread, either call `setMemory()` before
+ *    the first `setSampleRate()` or make the first `setSampleRate()` after
+ *    `setMemory()` on a non-realtime thread.
+ *
+ *    `setSampleRate()` returns `false` and leaves the object unchanged if
+ *    `size` is too small for the new sample rate, `true` otherwise.
+ *
+ *    `getMemReq()` returns the minimum `size` needed to use any sample rate
+ *    up to `sampleRate`.
+ *
+ *    In both cases, the memory of each channel is aligned to
+ *    `BW_ARENA_ALIGN` bytes (see [bw_arena](bw_arena)).
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+private:
+	bw_ensemble_coeffs		coeffs;
+	bw_ensemble_state		states[N_CHANNELS];
+	bw_ensemble_state * BW_RESTRICT	statesP[N_CHANNELS];
+	void * BW_RESTRICT		mem;
+	size_t				memSize;
+	void * BW_RESTRICT		userMem;
+	size_t				userMemSize;
+};
+
+template<size_t N_CHANNELS>
+inline Ensemble<N_CHANNELS>::Ensemble(
+		float maxDelay) {
+	bw_ensemble_init(&coeffs, maxDelay);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		statesP[i] = states + i;
+	mem = nullptr;
+	memSize = 0;
+	userMem = nullptr;
+	userMemSize = 0;
+}
+
+template<size_t N_CHANNELS>
+inline Ensemble<N_CHANNELS>::~Ensemble() {
+	if (mem != nullptr)
+		operator delete(mem);
+}
+
+template<size_t N_CHANNELS>
+inline bool Ensemble<N_CHANNELS>::setSampleRate(
+		float sampleRate) {
+	bw_ensemble_coeffs c = coeffs;
+	bw_ensemble_set_sample_rate(&c, sampleRate);
+	const size_t req = bw_ensemble_mem_req(&c);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	const size_t size = bw_arena_get_mem_req(&arena);
+	if (userMem != nullptr) {
+		if (size > userMemSize)
+			return false;
+		bw_arena_mem_set(&arena, userMem);
+	} else {
+		if (size > memSize) {
+			if (mem != nullptr)
+				operator delete(mem);
+			mem = operator new(size);
+			memSize = size;
+		}
+		bw_arena_mem_set(&arena, mem);
+	}
+	coeffs = c;
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_ensemble_mem_set(&coeffs, states + i, bw_arena_alloc(&arena, req));
+	if (userMem != nullptr && mem != nullptr) {
+		// states do not point into the owned block anymore
+		operator delete(mem);
+		mem = nullptr;
+		memSize = 0;
+	}
+	return true;
+}
+
+template<size_t N_CHANNELS>
+inline size_t Ensemble<N_CHANNELS>::getMemReq(
+		float sampleRate) {
+	const size_t req = bw_ensemble_mem_req_max(&coeffs, sampleRate);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	return bw_arena_get_mem_req(&arena);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size) {
+	BW_ASSERT(memory != nullptr || size == 0);
+	userMem = memory;
+	userMemSize = size;
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::reset(
+		float               x0,
+		float * BW_RESTRICT y0) {
+	bw_ensemble_reset_coeffs(&coeffs);
+	if (y0 != nullptr)
+		for (size_t i = 0; i < N_CHANNELS; i++)
+			y0[i] = bw_ensemble_reset_state(&coeffs, states + i, x0);
+	else
+		for (size_t i = 0; i < N_CHANNELS; i++)
+			bw_ensemble_reset_state(&coeffs, states + i, x0);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::reset(
+		float                                       x0,
+		std::array<float, N_CHANNELS> * BW_RESTRICT y0) {
+	reset(x0, y0 != nullptr ? y0->data() : nullptr);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::reset(
+		const float * x0,
+		float *       y0) {
+	bw_ensemble_reset_coeffs(&coeffs);
+	bw_ensemble_reset_state_multi(&coeffs, statesP, x0, y0, N_CHANNELS);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::reset(
+		std::array<float, N_CHANNELS>               x0,
+		std::array<float, N_CHANNELS> * BW_RESTRICT y0) {
+	reset(x0.data(), y0 != nullptr ? y0->data() : nullptr);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::process(
+		const float * const * x,
+		float * const *       y,
+		size_t                nSamples) {
+	bw_ensemble_process_multi(&coeffs, statesP, x, y, N_CHANNELS, nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::process(
+		std::array<const float *, N_CHANNELS> x,
+		std::array<float *, N_CHANNELS>       y,
+		size_t                                nSamples) {
+	process(x.data(), y.data(), nSamples);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setVoices(
+		size_t value) {
+	bw_ensemble_set_voices(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setRate(
+		float value) {
+	bw_ensemble_set_rate(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setDelay(
+		float value) {
+	bw_ensemble_set_delay(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setAmount(
+		float value) {
+	bw_ensemble_set_amount(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setCoeffX(
+		float value) {
+	bw_ensemble_set_coeff_x(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setCoeffMod(
+		float value) {
+	bw_ensemble_set_coeff_mod(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setLazyReset(
+		bool value) {
+	bw_ensemble_set_lazy_reset(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setPow2Length(
+		bool value) {
+	bw_ensemble_set_pow2_length(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Ensemble<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_ensemble_set_profile_stats(&coeffs, stats);
+}
+
+}
+#endif
+
+#endif
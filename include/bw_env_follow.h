@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Envelope follower made of a full-wave rectifier followed by
@@ -28,8 +28,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_env_follow_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -247,6 +250,19 @@ static inline float bw_env_follow_get_y_z1(
 /*! <<<```
  *    Returns the last output sample as stored in `state`.
  *
+ *    #### bw_env_follow_set_profile_stats()
+ *  ```>>> */
+static inline void bw_env_follow_set_profile_stats(
+	bw_env_follow_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                 stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_env_follow_process()` and
+ *    `bw_env_follow_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_env_follow_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_env_follow_coeffs_is_valid(
@@ -307,6 +323,9 @@ struct bw_env_follow_coeffs {
 	enum bw_env_follow_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		one_pole_coeffs;
@@ -328,6 +347,9 @@ static inline void bw_env_follow_init(
 
 	bw_one_pole_init(&coeffs->one_pole_coeffs);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_env_follow_coeffs");
 	coeffs->state = bw_env_follow_coeffs_state_init;
@@ -484,6 +506,7 @@ static inline void bw_env_follow_process(
 	BW_ASSERT(x != BW_NULL);
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_env_follow_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL)
 		for (size_t i = 0; i < n_samples; i++) {
@@ -495,6 +518,7 @@ static inline void bw_env_follow_process(
 			bw_env_follow_update_coeffs_audio(coeffs);
 			bw_env_follow_process1(coeffs, state, x[i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_env_follow_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_env_follow_coeffs_state_reset_coeffs);
@@ -526,6 +550,7 @@ static inline void bw_env_follow_process_multi(
 				BW_ASSERT(y[i] == BW_NULL || y[j] == BW_NULL || y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_env_follow_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL)
 		for (size_t i = 0; i < n_samples; i++) {
@@ -542,6 +567,7 @@ static inline void bw_env_follow_process_multi(
 			for (size_t j = 0; j < n_channels; j++)
 				bw_env_follow_process1(coeffs, state[j], x[j][i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_env_follow_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_env_follow_coeffs_state_reset_coeffs);
@@ -585,6 +611,24 @@ static inline float bw_env_follow_get_y_z1(
 	return bw_one_pole_get_y_z1(&state->one_pole_state);
 }
 
+static inline void bw_env_follow_set_profile_stats(
+		bw_env_follow_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                 stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_env_follow_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_env_follow_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_env_follow_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_env_follow_coeffs_state_init);
+}
+
 static inline char bw_env_follow_coeffs_is_valid(
 		const bw_env_follow_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -669,6 +713,9 @@ public:
 
 	float getYZ1(
 		size_t channel);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -767,6 +814,12 @@ inline float EnvFollow<N_CHANNELS>::getYZ1(
 	return bw_env_follow_get_y_z1(states + channel);
 }
 
+template<size_t N_CHANNELS>
+inline void EnvFollow<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_env_follow_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -42,6 +42,9 @@
  *    <ul>
  *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_env_gen_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Added skip_sustain and always_reach_sustain parameters.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
@@ -351,6 +354,19 @@ static inline float bw_env_gen_get_y_z1(
 /*! <<<```
  *    Returns the last output sample as stored in `state`.
  *
+ *    #### bw_env_gen_set_profile_stats()
+ *  ```>>> */
+static inline void bw_env_gen_set_profile_stats(
+	bw_env_gen_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *              stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_env_gen_process()` and
+ *    `bw_env_gen_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_env_gen_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_env_gen_coeffs_is_valid(
@@ -411,6 +427,9 @@ struct bw_env_gen_coeffs {
 	enum bw_env_gen_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -464,6 +483,9 @@ static inline void bw_env_gen_init(
 	coeffs->skip_sustain = 0;
 	coeffs->always_reach_sustain = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_env_gen_coeffs");
 	coeffs->state = bw_env_gen_coeffs_state_init;
@@ -693,6 +715,7 @@ static inline void bw_env_gen_process(
 	BW_ASSERT(state != BW_NULL);
 	BW_ASSERT_DEEP(bw_env_gen_state_is_valid(coeffs, state));
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_env_gen_update_coeffs_ctrl(coeffs);
 	bw_env_gen_process_ctrl(coeffs, state, gate);
 	if (y != BW_NULL)
@@ -701,6 +724,7 @@ static inline void bw_env_gen_process(
 	else
 		for (size_t i = 0; i < n_samples; i++)
 			bw_env_gen_process1(coeffs, state);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_env_gen_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_env_gen_coeffs_state_reset_coeffs);
@@ -732,6 +756,7 @@ static inline void bw_env_gen_process_multi(
 				BW_ASSERT(y[i] == BW_NULL || y[j] == BW_NULL || y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_env_gen_update_coeffs_ctrl(coeffs);
 	for (size_t j = 0; j < n_channels; j++)
 		bw_env_gen_process_ctrl(coeffs, state[j], gate[j]);
@@ -746,6 +771,7 @@ static inline void bw_env_gen_process_multi(
 		for (size_t i = 0; i < n_samples; i++)
 			for (size_t j = 0; j < n_channels; j++)
 				bw_env_gen_process1(coeffs, state[j]);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_env_gen_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_env_gen_coeffs_state_reset_coeffs);
@@ -881,6 +907,24 @@ static inline float bw_env_gen_get_y_z1(
 	return y;
 }
 
+static inline void bw_env_gen_set_profile_stats(
+		bw_env_gen_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *              stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_env_gen_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_env_gen_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_env_gen_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_env_gen_coeffs_state_init);
+}
+
 static inline char bw_env_gen_coeffs_is_valid(
 		const bw_env_gen_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -1002,6 +1046,9 @@ public:
 
 	float getYZ1(
 		size_t channel);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -1130,6 +1177,12 @@ inline float EnvGen<N_CHANNELS>::getYZ1(
 	return bw_env_gen_get_y_z1(states + channel);
 }
 
+template<size_t N_CHANNELS>
+inline void EnvGen<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_env_gen_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
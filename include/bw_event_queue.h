@@ -0,0 +1,431 @@
+/*
+ * Brickworks
+ *
+ * Copyright (C) 2024 Orastron Srl unipersonale
+ *
+ * Brickworks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Brickworks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Brickworks.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File author: agent
+ */
+
+/*!
+ *  module_type {{{ utility }}}
+ *  version {{{ 1.1.0 }}}
+ *  requires {{{ bw_common }}}
+ *  description {{{
+ *    Queue of timestamped events (notes, parameter changes, pitch bend) for
+ *    one block of samples, along with a helper that splits the block into
+ *    slices at event offsets.
+ *
+ *    Contrary to [bw_note_queue](bw_note_queue), each event carries the
+ *    offset, in samples, from the beginning of the block at which it should
+ *    take effect. By processing the block slice by slice and applying events
+ *    in between, timing is sample-accurate.
+ *
+ *    Since very short slices would hurt throughput and defeat
+ *    control-rate coefficient updates, a minimum slice length can be given:
+ *    blocks are split exactly at event offsets, except that events falling
+ *    less than that length after the beginning of a slice are applied at the
+ *    beginning of such slice instead of starting a new one.
+ *
+ *    Typical usage:
+ *
+ *    ```
+ *    bw_event_queue_slice s;
+ *    bw_event_queue_slice_reset(&s);
+ *    while (bw_event_queue_next_slice(&queue, n_samples, min_slice, &s)) {
+ *        for (size_t i = 0; i < s.n_events; i++)
+ *            apply(s.events + i);
+ *        process(x + s.offset, y + s.offset, s.n_samples);
+ *    }
+ *    bw_event_queue_clear(&queue);
+ *    ```
+ *  }}}
+ *  changelog {{{
+ *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>First release.</li>
+ *        </ul>
+ *      </li>
+ *    </ul>
+ *  }}}
+ */
+
+#ifndef BW_EVENT_QUEUE_H
+#define BW_EVENT_QUEUE_H
+
+#include <bw_common.h>
+
+/*! ...
+ *
+ *    #### BW_EVENT_QUEUE_MAX_EVENTS
+ *
+ *    `BW_EVENT_QUEUE_MAX_EVENTS` is the maximum number of events that a
+ *    `bw_event_queue` can hold.
+ *
+ *    If it is not defined already, then it gets defined as `256`.
+ *
+ *  >>> */
+#ifndef BW_EVENT_QUEUE_MAX_EVENTS
+# define BW_EVENT_QUEUE_MAX_EVENTS 256
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*** Public API ***/
+
+/*! api {{{
+ *    #### bw_event_queue_type
+ *  ```>>> */
+typedef enum {
+	bw_event_queue_type_note_on,
+	bw_event_queue_type_note_off,
+	bw_event_queue_type_parameter,
+	bw_event_queue_type_pitch_bend
+} bw_event_queue_type;
+/*! <<<```
+ *    Event type:
+ *     * `bw_event_queue_type_note_on`: note on, `index` is the note number
+ *       and `value` is the velocity;
+ *     * `bw_event_queue_type_note_off`: note off, `index` is the note number
+ *       and `value` is the velocity;
+ *     * `bw_event_queue_type_parameter`: parameter change, `index` is the
+ *       parameter index and `value` is the new value;
+ *     * `bw_event_queue_type_pitch_bend`: pitch bend, `index` is unused and
+ *       `value` is the new pitch bend value.
+ *
+ *    The meaning and range of values is up to the user.
+ *
+ *    #### bw_event_queue_event
+ *  ```>>> */
+typedef struct {
+	size_t              offset;
+	bw_event_queue_type type;
+	uint32_t            index;
+	float               value;
+} bw_event_queue_event;
+/*! <<<```
+ *    Timestamped event:
+ *     * `offset`: offset (samples) from the beginning of the block;
+ *     * `type`: event type;
+ *     * `index`: note number or parameter index, depending on `type`;
+ *     * `value`: velocity or parameter value, depending on `type`.
+ *
+ *    #### bw_event_queue
+ *  ```>>> */
+typedef struct {
+	bw_event_queue_event events[BW_EVENT_QUEUE_MAX_EVENTS];
+	size_t               n_events;
+} bw_event_queue;
+/*! <<<```
+ *    Event queue:
+ *     * `events`: events since the reset/clear, sorted by `offset` and, for
+ *       equal offsets, in the order they were added;
+ *     * `n_events`: number of elements in `events`.
+ *
+ *    #### bw_event_queue_slice
+ *  ```>>> */
+typedef struct {
+	size_t                       offset;
+	size_t                       n_samples;
+	const bw_event_queue_event * events;
+	size_t                       n_events;
+} bw_event_queue_slice;
+/*! <<<```
+ *    Block slice:
+ *     * `offset`: offset (samples) of the slice from the beginning of the
+ *       block;
+ *     * `n_samples`: slice length (samples);
+ *     * `events`: events to be applied before processing the slice;
+ *     * `n_events`: number of elements in `events`.
+ *
+ *    #### bw_event_queue_reset()
+ *  ```>>> */
+static inline void bw_event_queue_reset(
+	bw_event_queue * BW_RESTRICT queue);
+/*! <<<```
+ *    Resets `queue` so that it contains no events.
+ *
+ *    #### bw_event_queue_clear()
+ *  ```>>> */
+static inline void bw_event_queue_clear(
+	bw_event_queue * BW_RESTRICT queue);
+/*! <<<```
+ *    Removes all events from `queue`. Meant to be called after a block has
+ *    been processed.
+ *
+ *    #### bw_event_queue_add()
+ *  ```>>> */
+static inline char bw_event_queue_add(
+	bw_event_queue * BW_RESTRICT queue,
+	size_t                       offset,
+	bw_event_queue_type          type,
+	uint32_t                     index,
+	float                        value);
+/*! <<<```
+ *    Adds a new event to `queue` with the given `offset`, `type`, `index`,
+ *    and `value`, and returns non-`0` on success or `0` if `queue` is full,
+ *    in which case the event is discarded.
+ *
+ *    Events are kept sorted: adding events in non-decreasing `offset` order,
+ *    as hosts normally provide them, takes constant time.
+ *
+ *    #### bw_event_queue_slice_reset()
+ *  ```>>> */
+static inline void bw_event_queue_slice_reset(
+	bw_event_queue_slice * BW_RESTRICT slice);
+/*! <<<```
+ *    Prepares `slice` for iterating over a new block using
+ *    `bw_event_queue_next_slice()`.
+ *
+ *    #### bw_event_queue_next_slice()
+ *  ```>>> */
+static inline char bw_event_queue_next_slice(
+	const bw_event_queue * BW_RESTRICT queue,
+	size_t                             n_samples,
+	size_t                             min_slice,
+	bw_event_queue_slice * BW_RESTRICT slice);
+/*! <<<```
+ *    Moves `slice` to the next slice of the current block of `n_samples`
+ *    samples according to the events in `queue` and returns non-`0`, or
+ *    returns `0` if the block is over.
+ *
+ *    `min_slice` is the minimum slice length (samples), which must be
+ *    positive. Each slice starts exactly at the `offset` of its first event,
+ *    and events whose `offset` is less than `min_slice` samples after that
+ *    are also applied at the beginning of the same slice. Hence, `1` gives
+ *    sample-accurate timing for all events, while with greater values events
+ *    closely following others or the beginning of the block may be applied up
+ *    to `min_slice - 1` samples early. All slices but the last in a block are
+ *    at least `min_slice` samples long.
+ *
+ *    Events whose `offset` is not less than `n_samples` are applied before
+ *    the last slice. If `n_samples` is `0`, all events are returned in a
+ *    single empty slice.
+ *
+ *    `queue`, `n_samples`, and `min_slice` must not change while iterating
+ *    over a block.
+ *
+ *    #### bw_event_queue_is_valid()
+ *  ```>>> */
+static inline char bw_event_queue_is_valid(
+	const bw_event_queue * BW_RESTRICT queue);
+/*! <<<```
+ *    Tries to determine whether `queue` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    `queue` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_event_queue`.
+ *  }}} */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void bw_event_queue_reset(
+		bw_event_queue * BW_RESTRICT queue) {
+	BW_ASSERT(queue != BW_NULL);
+
+	queue->n_events = 0;
+
+	BW_ASSERT_DEEP(bw_event_queue_is_valid(queue));
+}
+
+static inline void bw_event_queue_clear(
+		bw_event_queue * BW_RESTRICT queue) {
+	BW_ASSERT(queue != BW_NULL);
+	BW_ASSERT_DEEP(bw_event_queue_is_valid(queue));
+
+	queue->n_events = 0;
+
+	BW_ASSERT_DEEP(bw_event_queue_is_valid(queue));
+}
+
+static inline char bw_event_queue_add(
+		bw_event_queue * BW_RESTRICT queue,
+		size_t                       offset,
+		bw_event_queue_type          type,
+		uint32_t                     index,
+		float                        value) {
+	BW_ASSERT(queue != BW_NULL);
+	BW_ASSERT_DEEP(bw_event_queue_is_valid(queue));
+	BW_ASSERT(type >= bw_event_queue_type_note_on && type <= bw_event_queue_type_pitch_bend);
+	BW_ASSERT(bw_is_finite(value));
+
+	if (queue->n_events == BW_EVENT_QUEUE_MAX_EVENTS)
+		return 0;
+
+	size_t i = queue->n_events;
+	for (; i > 0 && queue->events[i - 1].offset > offset; i--)
+		queue->events[i] = queue->events[i - 1];
+	queue->events[i].offset = offset;
+	queue->events[i].type = type;
+	queue->events[i].index = index;
+	queue->events[i].value = value;
+	queue->n_events++;
+
+	BW_ASSERT_DEEP(bw_event_queue_is_valid(queue));
+	return 1;
+}
+
+static inline void bw_event_queue_slice_reset(
+		bw_event_queue_slice * BW_RESTRICT slice) {
+	BW_ASSERT(slice != BW_NULL);
+
+	slice->offset = 0;
+	slice->n_samples = 0;
+	slice->events = BW_NULL;
+	slice->n_events = 0;
+}
+
+static inline char bw_event_queue_next_slice(
+		const bw_event_queue * BW_RESTRICT queue,
+		size_t                             n_samples,
+		size_t                             min_slice,
+		bw_event_queue_slice * BW_RESTRICT slice) {
+	BW_ASSERT(queue != BW_NULL);
+	BW_ASSERT_DEEP(bw_event_queue_is_valid(queue));
+	BW_ASSERT(min_slice > 0);
+	BW_ASSERT(slice != BW_NULL);
+	BW_ASSERT(slice->offset + slice->n_samples <= n_samples);
+
+	const size_t offset = slice->offset + slice->n_samples;
+	const size_t i = slice->events == BW_NULL ? 0 : (size_t)(slice->events - queue->events) + slice->n_events;
+	BW_ASSERT(i <= queue->n_events);
+	if (offset == n_samples && (i == queue->n_events || n_samples != 0))
+		return 0;
+
+	// events past the end go in the last sample, those closer than
+	// min_slice to the start of the slice are merged into it
+	const size_t last = n_samples == 0 ? 0 : n_samples - 1;
+	size_t j = i;
+	size_t end = n_samples;
+	for (; j < queue->n_events; j++) {
+		const size_t o = queue->events[j].offset < last ? queue->events[j].offset : last;
+		if (o - offset >= min_slice) {
+			end = o;
+			break;
+		}
+	}
+
+	slice->offset = offset;
+	slice->n_samples = end - offset;
+	slice->events = queue->events + i;
+	slice->n_events = j - i;
+	return 1;
+}
+
+static inline char bw_event_queue_is_valid(
+		const bw_event_queue * BW_RESTRICT queue) {
+	BW_ASSERT(queue != BW_NULL);
+
+	if (queue->n_events > BW_EVENT_QUEUE_MAX_EVENTS)
+		return 0;
+
+	for (size_t i = 0; i < queue->n_events; i++) {
+		const bw_event_queue_event *ev = queue->events + i;
+		if (ev->type < bw_event_queue_type_note_on || ev->type > bw_event_queue_type_pitch_bend)
+			return 0;
+		if (!bw_is_finite(ev->value))
+			return 0;
+		if (i > 0 && ev->offset < queue->events[i - 1].offset)
+			return 0;
+	}
+
+	return 1;
+}
+
+#ifdef __cplusplus
+}
+
+/*** Public C++ API ***/
+
+namespace Brickworks {
+
+/*! api_cpp {{{
+ *    ##### Brickworks::EventQueue
+ *  ```>>> */
+class EventQueue {
+public:
+	EventQueue();
+
+	void clear();
+
+	bool add(
+		size_t              offset,
+		bw_event_queue_type type,
+		uint32_t            index,
+		float               value);
+
+	template<typename F>
+	void forEachSlice(
+		size_t nSamples,
+		size_t minSlice,
+		F      f) const;
+
+	bw_event_queue queue;
+};
+/*! <<<```
+ *    `forEachSlice()` calls `f(const bw_event_queue_slice &slice)` for each
+ *    slice of the block, as given by `bw_event_queue_next_slice()`.
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+inline EventQueue::EventQueue() {
+	bw_event_queue_reset(&queue);
+}
+
+inline void EventQueue::clear() {
+	bw_event_queue_clear(&queue);
+}
+
+inline bool EventQueue::add(
+		size_t              offset,
+		bw_event_queue_type type,
+		uint32_t            index,
+		float               value) {
+	return bw_event_queue_add(&queue, offset, type, index, value);
+}
+
+template<typename F>
+inline void EventQueue::forEachSlice(
+		size_t nSamples,
+		size_t minSlice,
+		F      f) const {
+	bw_event_queue_slice s;
+	bw_event_queue_slice_reset(&s);
+	while (bw_event_queue_next_slice(&queue, nSamples, minSlice, &s))
+		f(static_cast<const bw_event_queue_slice &>(s));
+}
+
+}
+#endif
+
+#endif
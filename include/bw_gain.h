@@ -20,15 +20,23 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Gain.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_gain_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_gain_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li><code>bw_gain_process()</code> and
+ *              <code>bw_gain_process_multi()</code> now use a faster code
+ *              path when gain smoothing has settled.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -171,6 +179,20 @@ static inline void bw_gain_process_multi(
  *    fills the first `n_samples` of the `n_channels` output buffers `y`, while
  *    using and updating the common `coeffs` (control and audio rate).
  *
+ *    #### bw_gain_process_interleaved()
+ *  ```>>> */
+static inline void bw_gain_process_interleaved(
+	bw_gain_coeffs * BW_RESTRICT coeffs,
+	const float *                x,
+	float *                      y,
+	size_t                       n_channels,
+	size_t                       n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating the
+ *    common `coeffs` (control and audio rate).
+ *
  *    #### bw_gain_set_gain_lin()
  *  ```>>> */
 static inline void bw_gain_set_gain_lin(
@@ -223,6 +245,19 @@ static inline float bw_gain_get_gain_cur(
  *
  *    `coeffs` must be at least in the "reset" state.
  *
+ *    #### bw_gain_set_profile_stats()
+ *  ```>>> */
+static inline void bw_gain_set_profile_stats(
+	bw_gain_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *           stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_gain_process()`,
+ *    `bw_gain_process_multi()`, and `bw_gain_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_gain_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_gain_coeffs_is_valid(
@@ -266,11 +301,17 @@ struct bw_gain_coeffs {
 	uint32_t			hash;
 	enum bw_gain_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
 	bw_one_pole_state		smooth_state;
 
+	// Coefficients
+	char				settled;
+
 	// Parameters
 	float				gain;
 };
@@ -283,6 +324,9 @@ static inline void bw_gain_init(
 	bw_one_pole_set_tau(&coeffs->smooth_coeffs, 0.05f);
 	coeffs->gain = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_gain_coeffs");
 	coeffs->state = bw_gain_coeffs_state_init;
@@ -316,6 +360,7 @@ static inline void bw_gain_reset_coeffs(
 
 	bw_one_pole_reset_coeffs(&coeffs->smooth_coeffs);
 	bw_one_pole_reset_state(&coeffs->smooth_coeffs, &coeffs->smooth_state, coeffs->gain);
+	coeffs->settled = 1;
 
 #ifdef BW_DEBUG_DEEP
 	coeffs->state = bw_gain_coeffs_state_reset_coeffs;
@@ -331,6 +376,9 @@ static inline void bw_gain_update_coeffs_ctrl(
 	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_reset_coeffs);
 
 	bw_one_pole_update_coeffs_ctrl(&coeffs->smooth_coeffs);
+	// once the smoother has reached its target, update_coeffs_audio() is a
+	// no-op until the gain is changed again
+	coeffs->settled = bw_one_pole_get_y_z1(&coeffs->smooth_state) == coeffs->gain;
 
 	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_reset_coeffs);
@@ -378,11 +426,18 @@ static inline void bw_gain_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_gain_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_gain_update_coeffs_audio(coeffs);
-		y[i] = bw_gain_process1(coeffs, x[i]);
-	}
+	if (coeffs->settled) {
+		const float g = bw_one_pole_get_y_z1(&coeffs->smooth_state);
+		for (size_t i = 0; i < n_samples; i++)
+			y[i] = g * x[i];
+	} else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_gain_update_coeffs_audio(coeffs);
+			y[i] = bw_gain_process1(coeffs, x[i]);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_reset_coeffs);
@@ -406,17 +461,58 @@ static inline void bw_gain_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_gain_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_gain_update_coeffs_audio(coeffs);
+	if (coeffs->settled) {
+		const float g = bw_one_pole_get_y_z1(&coeffs->smooth_state);
 		for (size_t j = 0; j < n_channels; j++)
-			y[j][i] = bw_gain_process1(coeffs, x[j][i]);
-	}
+			for (size_t i = 0; i < n_samples; i++)
+				y[j][i] = g * x[j][i];
+	} else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_gain_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++)
+				y[j][i] = bw_gain_process1(coeffs, x[j][i]);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_gain_process_interleaved(
+		bw_gain_coeffs * BW_RESTRICT coeffs,
+		const float *                x,
+		float *                      y,
+		size_t                       n_channels,
+		size_t                       n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_reset_coeffs);
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_gain_update_coeffs_ctrl(coeffs);
+	if (coeffs->settled) {
+		const float g = bw_one_pole_get_y_z1(&coeffs->smooth_state);
+		const size_t n = n_channels * n_frames;
+		for (size_t i = 0; i < n; i++)
+			y[i] = g * x[i];
+	} else
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_gain_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				y[k] = bw_gain_process1(coeffs, x[k]);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
+}
+
 static inline void bw_gain_set_gain_lin(
 		bw_gain_coeffs * BW_RESTRICT coeffs,
 		float                        value) {
@@ -478,6 +574,24 @@ static inline float bw_gain_get_gain_cur(
 	return bw_one_pole_get_y_z1(&coeffs->smooth_state);
 }
 
+static inline void bw_gain_set_profile_stats(
+		bw_gain_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *           stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_gain_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_gain_coeffs_state_init);
+}
+
 static inline char bw_gain_coeffs_is_valid(
 		const bw_gain_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -535,6 +649,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setGainLin(
 		float value);
 
@@ -547,6 +666,9 @@ public:
 	float getGainLin();
 
 	float getGainCur();
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -593,6 +715,14 @@ inline void Gain<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void Gain<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_gain_process_interleaved(&coeffs, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void Gain<N_CHANNELS>::setGainLin(
 		float value) {
@@ -621,6 +751,12 @@ inline float Gain<N_CHANNELS>::getGainCur() {
 	return bw_gain_get_gain_cur(&coeffs);
 }
 
+template<size_t N_CHANNELS>
+inline void Gain<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_gain_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,15 +20,20 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_lp1 bw_math bw_mm1 bw_one_pole }}}
  *  description {{{
  *    First-order high shelf filter (6 dB/oct) with unitary DC gain.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_hs1_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_hs1_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -206,6 +211,22 @@ static inline void bw_hs1_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_hs1_process_interleaved()
+ *  ```>>> */
+static inline void bw_hs1_process_interleaved(
+	bw_hs1_coeffs * BW_RESTRICT                    coeffs,
+	bw_hs1_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_hs1_set_cutoff()
  *  ```>>> */
 static inline void bw_hs1_set_cutoff(
@@ -285,6 +306,19 @@ static inline void bw_hs1_set_high_gain_dB(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_hs1_set_profile_stats()
+ *  ```>>> */
+static inline void bw_hs1_set_profile_stats(
+	bw_hs1_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_hs1_process()`,
+ *    `bw_hs1_process_multi()`, and `bw_hs1_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_hs1_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_hs1_coeffs_is_valid(
@@ -345,6 +379,9 @@ struct bw_hs1_coeffs {
 	enum bw_hs1_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_mm1_coeffs			mm1_coeffs;
@@ -380,6 +417,9 @@ static inline void bw_hs1_init(
 	coeffs->prewarp_freq = 1e3f;
 	coeffs->high_gain = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_hs1_coeffs");
 	coeffs->state = bw_hs1_coeffs_state_init;
@@ -554,11 +594,13 @@ static inline void bw_hs1_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_hs1_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_hs1_update_coeffs_audio(coeffs);
 		y[i] = bw_hs1_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_hs1_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_reset_coeffs);
@@ -591,15 +633,52 @@ static inline void bw_hs1_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_hs1_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_hs1_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_hs1_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_hs1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_hs1_process_interleaved(
+		bw_hs1_coeffs * BW_RESTRICT                    coeffs,
+		bw_hs1_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_hs1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(coeffs->cutoff * bw_sqrtf(coeffs->high_gain) >= 1e-6f && coeffs->cutoff * bw_sqrtf(coeffs->high_gain) <= 1e12f);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_hs1_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_hs1_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_hs1_process1(coeffs, state[j], x[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
 
 	BW_ASSERT_DEEP(bw_hs1_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
 }
 
 static inline void bw_hs1_set_cutoff(
@@ -681,6 +760,24 @@ static inline void bw_hs1_set_high_gain_dB(
 	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_init);
 }
 
+static inline void bw_hs1_set_profile_stats(
+		bw_hs1_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_hs1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_hs1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs1_coeffs_state_init);
+}
+
 static inline char bw_hs1_coeffs_is_valid(
 		const bw_hs1_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -766,6 +863,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -780,6 +882,9 @@ public:
 
 	void setHighGainDB(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -860,6 +965,14 @@ inline void HS1<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void HS1<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_hs1_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void HS1<N_CHANNELS>::setCutoff(
 		float value) {
@@ -890,6 +1003,12 @@ inline void HS1<N_CHANNELS>::setHighGainDB(
 	bw_hs1_set_high_gain_dB(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void HS1<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_hs1_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
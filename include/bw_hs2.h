@@ -20,15 +20,22 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_mm2 bw_one_pole bw_svf }}}
  *  description {{{
  *    Second-order high shelf filter (12 dB/oct) with unitary DC gain.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_hs2_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_hs2_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li>Added <code>bw_hs2_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -208,6 +215,22 @@ static inline void bw_hs2_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_hs2_process_interleaved()
+ *  ```>>> */
+static inline void bw_hs2_process_interleaved(
+	bw_hs2_coeffs * BW_RESTRICT                    coeffs,
+	bw_hs2_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_hs2_set_cutoff()
  *  ```>>> */
 static inline void bw_hs2_set_cutoff(
@@ -299,6 +322,34 @@ static inline void bw_hs2_set_high_gain_dB(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_hs2_set_interp_period()
+ *  ```>>> */
+static inline void bw_hs2_set_interp_period(
+	bw_hs2_coeffs * BW_RESTRICT coeffs,
+	size_t                      value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    See `bw_mm2_set_interp_period()` for details.
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_hs2_set_profile_stats()
+ *  ```>>> */
+static inline void bw_hs2_set_profile_stats(
+	bw_hs2_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_hs2_process()`,
+ *    `bw_hs2_process_multi()`, and `bw_hs2_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_hs2_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_hs2_coeffs_is_valid(
@@ -359,6 +410,9 @@ struct bw_hs2_coeffs {
 	enum bw_hs2_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_mm2_coeffs			mm2_coeffs;
@@ -399,6 +453,9 @@ static inline void bw_hs2_init(
 	coeffs->prewarp_freq = 1.f;
 	coeffs->high_gain = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_hs2_coeffs");
 	coeffs->state = bw_hs2_coeffs_state_init;
@@ -578,11 +635,13 @@ static inline void bw_hs2_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_hs2_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_hs2_update_coeffs_audio(coeffs);
 		y[i] = bw_hs2_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_reset_coeffs);
@@ -615,15 +674,52 @@ static inline void bw_hs2_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_hs2_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_hs2_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_hs2_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_hs2_process_interleaved(
+		bw_hs2_coeffs * BW_RESTRICT                    coeffs,
+		bw_hs2_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(coeffs->cutoff * bw_sqrtf(bw_sqrtf(coeffs->high_gain)) >= 1e-6f && coeffs->cutoff * bw_sqrtf(bw_sqrtf(coeffs->high_gain)) <= 1e12f);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_hs2_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_hs2_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_hs2_process1(coeffs, state[j], x[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
 
 	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
 }
 
 static inline void bw_hs2_set_cutoff(
@@ -726,6 +822,38 @@ static inline void bw_hs2_set_high_gain_dB(
 	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_init);
 }
 
+static inline void bw_hs2_set_interp_period(
+		bw_hs2_coeffs * BW_RESTRICT coeffs,
+		size_t                      value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	bw_mm2_set_interp_period(&coeffs->mm2_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_init);
+}
+
+static inline void bw_hs2_set_profile_stats(
+		bw_hs2_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_hs2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_hs2_coeffs_state_init);
+}
+
 static inline char bw_hs2_coeffs_is_valid(
 		const bw_hs2_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -823,6 +951,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -840,6 +973,12 @@ public:
 
 	void setHighGainDB(
 		float value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -920,6 +1059,14 @@ inline void HS2<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void HS2<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_hs2_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void HS2<N_CHANNELS>::setCutoff(
 		float value) {
@@ -956,6 +1103,18 @@ inline void HS2<N_CHANNELS>::setHighGainDB(
 	bw_hs2_set_high_gain_dB(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void HS2<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_hs2_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void HS2<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_hs2_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    First-order lowpass filter (6 dB/oct) with unitary DC gain.
@@ -30,8 +30,15 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_lp1_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_lp1_flush_denormals()</code> and support for
+ *              <code>BW_FLUSH_DENORMALS</code>.</li>
+ *          <li>Added <code>bw_lp1_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -206,6 +213,22 @@ static inline void bw_lp1_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_lp1_process_interleaved()
+ *  ```>>> */
+static inline void bw_lp1_process_interleaved(
+	bw_lp1_coeffs * BW_RESTRICT                    coeffs,
+	bw_lp1_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_lp1_set_cutoff()
  *  ```>>> */
 static inline void bw_lp1_set_cutoff(
@@ -244,6 +267,32 @@ static inline void bw_lp1_set_prewarp_freq(
  *
  *    Default value: `1e3f`.
  *
+ *    #### bw_lp1_flush_denormals()
+ *  ```>>> */
+static inline void bw_lp1_flush_denormals(
+	const bw_lp1_coeffs * BW_RESTRICT coeffs,
+	bw_lp1_state * BW_RESTRICT        state);
+/*! <<<```
+ *    Sets the values in `state` whose absolute value is lower than 2^-80 to
+ *    `0.f` (see `bw_flush_denormal()`).
+ *
+ *    If `BW_FLUSH_DENORMALS` is defined, this is automatically called at the
+ *    end of `bw_lp1_process()`, `bw_lp1_process_multi()`, and
+ *    `bw_lp1_process_interleaved()`.
+ *
+ *    #### bw_lp1_set_profile_stats()
+ *  ```>>> */
+static inline void bw_lp1_set_profile_stats(
+	bw_lp1_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_lp1_process()`,
+ *    `bw_lp1_process_multi()`, and `bw_lp1_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_lp1_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_lp1_coeffs_is_valid(
@@ -304,6 +353,9 @@ struct bw_lp1_coeffs {
 	enum bw_lp1_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -346,6 +398,9 @@ static inline void bw_lp1_init(
 	coeffs->prewarp_k = 1.f;
 	coeffs->prewarp_freq = 1e3f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_lp1_coeffs");
 	coeffs->state = bw_lp1_coeffs_state_init;
@@ -531,11 +586,17 @@ static inline void bw_lp1_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_lp1_update_coeffs_audio(coeffs);
 		y[i] = bw_lp1_process1(coeffs, state, x[i]);
 	}
 
+#ifdef BW_FLUSH_DENORMALS
+	bw_lp1_flush_denormals(coeffs, state);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
+
 	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_reset_coeffs);
 	BW_ASSERT_DEEP(bw_lp1_state_is_valid(coeffs, state));
@@ -566,14 +627,59 @@ static inline void bw_lp1_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_lp1_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_lp1_process1(coeffs, state[j], x[j][i]);
 	}
 
+#ifdef BW_FLUSH_DENORMALS
+	for (size_t i = 0; i < n_channels; i++)
+		bw_lp1_flush_denormals(coeffs, state[i]);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_lp1_process_interleaved(
+		bw_lp1_coeffs * BW_RESTRICT                    coeffs,
+		bw_lp1_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_lp1_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_lp1_process1(coeffs, state[j], x[k]);
+	}
+
+#ifdef BW_FLUSH_DENORMALS
+	for (size_t i = 0; i < n_channels; i++)
+		bw_lp1_flush_denormals(coeffs, state[i]);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
 	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
 }
 
 static inline void bw_lp1_set_cutoff(
@@ -619,6 +725,40 @@ static inline void bw_lp1_set_prewarp_freq(
 	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_init);
 }
 
+static inline void bw_lp1_flush_denormals(
+		const bw_lp1_coeffs * BW_RESTRICT coeffs,
+		bw_lp1_state * BW_RESTRICT        state) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_lp1_state_is_valid(coeffs, state));
+
+	(void)coeffs;
+	state->y_z1 = bw_flush_denormal(state->y_z1);
+	state->X_z1 = bw_flush_denormal(state->X_z1);
+
+	BW_ASSERT_DEEP(bw_lp1_state_is_valid(coeffs, state));
+}
+
+static inline void bw_lp1_set_profile_stats(
+		bw_lp1_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_lp1_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_lp1_coeffs_state_init);
+}
+
 static inline char bw_lp1_coeffs_is_valid(
 		const bw_lp1_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -730,6 +870,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -738,6 +883,9 @@ public:
 
 	void setPrewarpFreq(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -818,6 +966,14 @@ inline void LP1<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void LP1<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_lp1_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void LP1<N_CHANNELS>::setCutoff(
 		float value) {
@@ -836,6 +992,12 @@ inline void LP1<N_CHANNELS>::setPrewarpFreq(
 	bw_lp1_set_prewarp_freq(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void LP1<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_lp1_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
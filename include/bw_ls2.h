@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_mm2 bw_one_pole bw_svf }}}
  *  description {{{
  *    Second-order low shelf filter (12 dB/oct) with gain asymptotically
@@ -28,8 +28,15 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_ls2_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_ls2_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li>Added <code>bw_ls2_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *          <li>Fixed typos in documentation of
  *              <code>bw_ls2_set_cutoff()</code>,
@@ -213,6 +220,22 @@ static inline void bw_ls2_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_ls2_process_interleaved()
+ *  ```>>> */
+static inline void bw_ls2_process_interleaved(
+	bw_ls2_coeffs * BW_RESTRICT                    coeffs,
+	bw_ls2_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_ls2_set_cutoff()
  *  ```>>> */
 static inline void bw_ls2_set_cutoff(
@@ -305,6 +328,34 @@ static inline void bw_ls2_set_dc_gain_dB(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_ls2_set_interp_period()
+ *  ```>>> */
+static inline void bw_ls2_set_interp_period(
+	bw_ls2_coeffs * BW_RESTRICT coeffs,
+	size_t                      value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    See `bw_mm2_set_interp_period()` for details.
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_ls2_set_profile_stats()
+ *  ```>>> */
+static inline void bw_ls2_set_profile_stats(
+	bw_ls2_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_ls2_process()`,
+ *    `bw_ls2_process_multi()`, and `bw_ls2_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_ls2_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_ls2_coeffs_is_valid(
@@ -365,6 +416,9 @@ struct bw_ls2_coeffs {
 	enum bw_ls2_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_mm2_coeffs			mm2_coeffs;
@@ -405,6 +459,9 @@ static inline void bw_ls2_init(
 	coeffs->prewarp_freq = 1.f;
 	coeffs->dc_gain = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_ls2_coeffs");
 	coeffs->state = bw_ls2_coeffs_state_init;
@@ -584,11 +641,13 @@ static inline void bw_ls2_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_ls2_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_ls2_update_coeffs_audio(coeffs);
 		y[i] = bw_ls2_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_reset_coeffs);
@@ -621,17 +680,54 @@ static inline void bw_ls2_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_ls2_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_ls2_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_ls2_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_ls2_process_interleaved(
+		bw_ls2_coeffs * BW_RESTRICT                    coeffs,
+		bw_ls2_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(coeffs->cutoff * bw_rcpf(bw_sqrtf(bw_sqrtf(coeffs->dc_gain))) >= 1e-6f && coeffs->cutoff * bw_rcpf(bw_sqrtf(bw_sqrtf(coeffs->dc_gain))) <= 1e12f);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_ls2_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_ls2_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_ls2_process1(coeffs, state[j], x[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
+}
+
 static inline void bw_ls2_set_cutoff(
 		bw_ls2_coeffs * BW_RESTRICT coeffs,
 		float                       value) {
@@ -732,6 +828,38 @@ static inline void bw_ls2_set_dc_gain_dB(
 	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_init);
 }
 
+static inline void bw_ls2_set_interp_period(
+		bw_ls2_coeffs * BW_RESTRICT coeffs,
+		size_t                      value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	bw_mm2_set_interp_period(&coeffs->mm2_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_init);
+}
+
+static inline void bw_ls2_set_profile_stats(
+		bw_ls2_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_ls2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ls2_coeffs_state_init);
+}
+
 static inline char bw_ls2_coeffs_is_valid(
 		const bw_ls2_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -829,6 +957,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -846,6 +979,12 @@ public:
 
 	void setDcGainDB(
 		float value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -926,6 +1065,14 @@ inline void LS2<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void LS2<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_ls2_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void LS2<N_CHANNELS>::setCutoff(
 		float value) {
@@ -962,6 +1109,18 @@ inline void LS2<N_CHANNELS>::setDcGainDB(
 	bw_ls2_set_dc_gain_dB(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void LS2<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_ls2_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void LS2<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_ls2_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
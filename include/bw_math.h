@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ utility }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common }}}
  *  description {{{
  *    A collection of mathematical routines that strive to be better suited to
@@ -38,14 +38,31 @@
  *    In practice they should guarantee fast and consistent performance, but
  *    always do your own benchmarking.
  *
+ *    Most functions also come in a `_buf` variant that processes a whole
+ *    buffer at once, giving the same results as the scalar version applied to
+ *    each element. These are written so that compilers can easily vectorize
+ *    them and are usually considerably faster than calling scalar functions in
+ *    a loop (results could still differ slightly if the compiler contracts
+ *    multiplications and additions differently in the two cases).
+ *
  *    All functions in this module are [reentrant](api#reentrant-function),
  *    [RT-safe](api#rt-safe-function), [thread-safe](api#thread-safe-function),
- *    and have [no side effects](api#no-side-effects).
+ *    and have [no side effects](api#no-side-effects) (other than writing
+ *    output buffers in the case of `_buf` functions).
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_rcpf_buf()</code>, <code>bw_sin2pif_buf()</code>,
+ *              <code>bw_sinf_buf()</code>, <code>bw_cos2pif_buf()</code>,
+ *              <code>bw_cosf_buf()</code>, <code>bw_tan2pif_buf()</code>,
+ *              <code>bw_tanf_buf()</code>, <code>bw_log2f_buf()</code>,
+ *              <code>bw_logf_buf()</code>, <code>bw_log10f_buf()</code>,
+ *              <code>bw_pow2f_buf()</code>, <code>bw_expf_buf()</code>,
+ *              <code>bw_pow10f_buf()</code>, <code>bw_dB2linf_buf()</code>,
+ *              <code>bw_lin2dBf_buf()</code>, and
+ *              <code>bw_tanhf_buf()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -547,6 +564,198 @@ static inline float bw_acoshf(
  *    `x` must be in [1.f, 8.507059173023462e+37f].
  *
  *    Absolute error < 0.004 or relative error < 0.8%, whatever is worse.
+ *
+ *    #### bw_rcpf_buf()
+ *  ```>>> */
+static inline void bw_rcpf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_rcpf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_rcpf()` apply.
+ *
+ *    #### bw_sin2pif_buf()
+ *  ```>>> */
+static inline void bw_sin2pif_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_sin2pif()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_sin2pif()` apply.
+ *
+ *    #### bw_sinf_buf()
+ *  ```>>> */
+static inline void bw_sinf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_sinf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_sinf()` apply.
+ *
+ *    #### bw_cos2pif_buf()
+ *  ```>>> */
+static inline void bw_cos2pif_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_cos2pif()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_cos2pif()` apply.
+ *
+ *    #### bw_cosf_buf()
+ *  ```>>> */
+static inline void bw_cosf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_cosf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_cosf()` apply.
+ *
+ *    #### bw_tan2pif_buf()
+ *  ```>>> */
+static inline void bw_tan2pif_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_tan2pif()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_tan2pif()` apply.
+ *
+ *    #### bw_tanf_buf()
+ *  ```>>> */
+static inline void bw_tanf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_tanf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_tanf()` apply.
+ *
+ *    #### bw_log2f_buf()
+ *  ```>>> */
+static inline void bw_log2f_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_log2f()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_log2f()` apply.
+ *
+ *    #### bw_logf_buf()
+ *  ```>>> */
+static inline void bw_logf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_logf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_logf()` apply.
+ *
+ *    #### bw_log10f_buf()
+ *  ```>>> */
+static inline void bw_log10f_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_log10f()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_log10f()` apply.
+ *
+ *    #### bw_pow2f_buf()
+ *  ```>>> */
+static inline void bw_pow2f_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_pow2f()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_pow2f()` apply.
+ *
+ *    #### bw_expf_buf()
+ *  ```>>> */
+static inline void bw_expf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_expf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_expf()` apply.
+ *
+ *    #### bw_pow10f_buf()
+ *  ```>>> */
+static inline void bw_pow10f_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_pow10f()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_pow10f()` apply.
+ *
+ *    #### bw_dB2linf_buf()
+ *  ```>>> */
+static inline void bw_dB2linf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_dB2linf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_dB2linf()` apply.
+ *
+ *    #### bw_lin2dBf_buf()
+ *  ```>>> */
+static inline void bw_lin2dBf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_lin2dBf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_lin2dBf()` apply.
+ *
+ *    #### bw_tanhf_buf()
+ *  ```>>> */
+static inline void bw_tanhf_buf(
+	const float * src,
+	float *       dest,
+	size_t        n_elems);
+/*! <<<```
+ *    Computes `bw_tanhf()` of each of the first `n_elems` in `src` and stores
+ *    the results in the first `n_elems` of `dest`.
+ *
+ *    The same input validity constraints of `bw_tanhf()` apply.
  *  }}} */
 
 #ifdef __cplusplus
@@ -990,6 +1199,329 @@ static inline float bw_acoshf(
 	return y;
 }
 
+// Branchless element kernels for the *_buf() functions below. They give the
+// same results as the corresponding scalar functions, but avoid
+// floating-point comparisons and conditional float-to-int conversions so that
+// compilers can vectorize the loops they are used in.
+
+static inline float bw_floorf_k(
+		float x) {
+	union { float f; uint32_t u; } v, t, d;
+	v.f = x;
+	const uint32_t m = (uint32_t)bw_signfilli32((int32_t)((v.u & 0x7fffffffu) - 0x4b000000u)); // |x| < 2^23
+	t.u = v.u & m;
+	t.f = (float)(int32_t)t.f;
+	t.u = ((t.u | (v.u & 0x80000000u)) & m) | (v.u & ~m); // same as bw_truncf()
+	d.f = x - t.f;
+	return t.f - (float)((t.u & d.u) >> 31);
+}
+
+static inline float bw_sin2pif_k(
+		float x) {
+	x = x - bw_floorf_k(x);
+	const float xp1 = x + x - 1.f;
+	const float xp2 = bw_absf(xp1);
+	const float xp = 1.570796326794897f - 1.570796326794897f * bw_absf(xp2 + xp2 - 1.f);
+	return -bw_copysignf(1.f, xp1) * (xp + xp * xp * (-0.05738534102710938f - 0.1107398163618408f * xp));
+}
+
+static inline float bw_pow2f_k(
+		float x) {
+	union { float f; int32_t i; uint32_t u; } v, y;
+	v.f = x;
+	const uint32_t m = (uint32_t)bw_signfilli32(v.i & (int32_t)(0xc2fc0000u - v.u)); // x < -126.f
+	v.u = (v.u & ~m) | (0xc2fc0000u & m);
+	const float xc = v.f;
+	const int32_t xi = (int32_t)xc;
+	const int32_t l = xi - ((v.i >> 31) & 1);
+	const float f = xc - (float)l;
+	v.i = (l + 127) << 23;
+	y.f = v.f + v.f * f * (0.6931471805599453f + f * (0.2274112777602189f + f * 0.07944154167983575f));
+	y.u &= ~m;
+	return y.f;
+}
+
+static inline float bw_tanhf_k(
+		float x) {
+	union { float f; uint32_t u; } v, a;
+	v.f = x;
+	a.u = bw_minu32(v.u & 0x7fffffffu, 0x400760deu); // |x| clipped to 2.115287308554551f
+	v.u = a.u | (v.u & 0x80000000u);
+	const float xm = v.f;
+	const float axm = a.f;
+	return xm * axm * (0.01218073260037716f * axm - 0.2750231331124371f) + xm;
+}
+
+static inline void bw_rcpf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT((x >= 8.077935669e-28f && x <= 1.237940039e27f) || (x <= -8.077935669e-28f && x >= -1.237940039e27f));
+		dest[i] = bw_rcpf(x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_sin2pif_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		dest[i] = bw_sin2pif_k(x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_sinf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		dest[i] = bw_sin2pif_k(0.1591549430918953f * x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_cos2pif_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		dest[i] = bw_sin2pif_k(x + 0.25f);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_cosf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		dest[i] = bw_sin2pif_k(0.1591549430918953f * x + 0.25f);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_tan2pif_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT((x - 0.5f * bw_floorf(x + x) <= 0.249840845056908f)
+			|| (x - 0.5f * bw_floorf(x + x) >= 0.250159154943092f));
+		dest[i] = bw_sin2pif_k(x) * bw_rcpf(bw_sin2pif_k(x + 0.25f));
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_tanf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT((x - 3.141592653589793f * bw_floorf(0.318309886183791f * x) <= 1.569796326794897f)
+			|| (x - 3.141592653589793f * bw_floorf(0.318309886183791f * x) >= 1.571796326794896f));
+		const float xn = 0.1591549430918953f * x;
+		dest[i] = bw_sin2pif_k(xn) * bw_rcpf(bw_sin2pif_k(xn + 0.25f));
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_log2f_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT(x >= 1.175494350822287e-38f);
+		dest[i] = bw_log2f(x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_logf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT(x >= 1.175494350822287e-38f);
+		dest[i] = 0.693147180559945f * bw_log2f(x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_log10f_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT(x >= 1.175494350822287e-38f);
+		dest[i] = 0.3010299956639811f * bw_log2f(x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_pow2f_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(!bw_is_nan(x));
+		BW_ASSERT(x <= 127.999f);
+		dest[i] = bw_pow2f_k(x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_expf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(!bw_is_nan(x));
+		BW_ASSERT(x <= 88.722f);
+		dest[i] = bw_pow2f_k(1.442695040888963f * x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_pow10f_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(!bw_is_nan(x));
+		BW_ASSERT(x <= 38.531f);
+		dest[i] = bw_pow2f_k(3.321928094887363f * x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_dB2linf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(!bw_is_nan(x));
+		BW_ASSERT(x <= 770.630f);
+		dest[i] = bw_pow2f_k(0.1660964047443682f * x);
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_lin2dBf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(bw_is_finite(x));
+		BW_ASSERT(x >= 1.175494350822287e-38f);
+		dest[i] = 20.f * (0.3010299956639811f * bw_log2f(x));
+	}
+
+	BW_ASSERT_DEEP(bw_has_only_finite(dest, n_elems));
+}
+
+static inline void bw_tanhf_buf(
+		const float * src,
+		float *       dest,
+		size_t        n_elems) {
+	BW_ASSERT(src != BW_NULL);
+	BW_ASSERT(dest != BW_NULL);
+
+	for (size_t i = 0; i < n_elems; i++) {
+		const float x = src[i];
+		BW_ASSERT(!bw_is_nan(x));
+		dest[i] = bw_tanhf_k(x);
+	}
+
+	BW_ASSERT_DEEP(!bw_has_nan(dest, n_elems));
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,15 +20,22 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_one_pole bw_svf }}}
  *  description {{{
  *    Second-order multimode filter.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_mm2_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_mm2_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li>Added <code>bw_mm2_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -203,6 +210,22 @@ static inline void bw_mm2_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_mm2_process_interleaved()
+ *  ```>>> */
+static inline void bw_mm2_process_interleaved(
+	bw_mm2_coeffs * BW_RESTRICT                    coeffs,
+	bw_mm2_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_mm2_set_cutoff()
  *  ```>>> */
 static inline void bw_mm2_set_cutoff(
@@ -301,6 +324,34 @@ static inline void bw_mm2_set_coeff_hp(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_mm2_set_interp_period()
+ *  ```>>> */
+static inline void bw_mm2_set_interp_period(
+	bw_mm2_coeffs * BW_RESTRICT coeffs,
+	size_t                      value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    See `bw_svf_set_interp_period()` for details.
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_mm2_set_profile_stats()
+ *  ```>>> */
+static inline void bw_mm2_set_profile_stats(
+	bw_mm2_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_mm2_process()`,
+ *    `bw_mm2_process_multi()`, and `bw_mm2_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_mm2_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_mm2_coeffs_is_valid(
@@ -361,6 +412,9 @@ struct bw_mm2_coeffs {
 	enum bw_mm2_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_svf_coeffs			svf_coeffs;
@@ -398,6 +452,9 @@ static inline void bw_mm2_init(
 	bw_gain_set_gain_lin(&coeffs->gain_bp_coeffs, 0.f);
 	bw_gain_set_gain_lin(&coeffs->gain_hp_coeffs, 0.f);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_mm2_coeffs");
 	coeffs->state = bw_mm2_coeffs_state_init;
@@ -581,11 +638,13 @@ static inline void bw_mm2_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_mm2_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_mm2_update_coeffs_audio(coeffs);
 		y[i] = bw_mm2_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_reset_coeffs);
@@ -617,15 +676,51 @@ static inline void bw_mm2_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_mm2_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_mm2_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_mm2_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_mm2_process_interleaved(
+		bw_mm2_coeffs * BW_RESTRICT                    coeffs,
+		bw_mm2_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_mm2_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_mm2_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_mm2_process1(coeffs, state[j], x[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
 
 	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
 }
 
 static inline void bw_mm2_set_cutoff(
@@ -742,6 +837,38 @@ static inline void bw_mm2_set_coeff_hp(
 	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_init);
 }
 
+static inline void bw_mm2_set_interp_period(
+		bw_mm2_coeffs * BW_RESTRICT coeffs,
+		size_t                      value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	bw_svf_set_interp_period(&coeffs->svf_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_init);
+}
+
+static inline void bw_mm2_set_profile_stats(
+		bw_mm2_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_mm2_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_mm2_coeffs_state_init);
+}
+
 static inline char bw_mm2_coeffs_is_valid(
 		const bw_mm2_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -822,6 +949,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -845,6 +977,12 @@ public:
 
 	void setCoeffHp(
 		float value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -925,6 +1063,14 @@ inline void MM2<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void MM2<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_mm2_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void MM2<N_CHANNELS>::setCutoff(
 		float value) {
@@ -973,6 +1119,18 @@ inline void MM2<N_CHANNELS>::setCoeffHp(
 	bw_mm2_set_coeff_hp(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void MM2<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_mm2_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void MM2<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_mm2_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,15 +20,18 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_env_follow bw_math bw_one_pole }}}
  *  description {{{
  *    Noise gate with independent sidechain input.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_noise_gate_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -274,6 +277,19 @@ static inline void bw_noise_gate_set_release_tau(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_noise_gate_set_profile_stats()
+ *  ```>>> */
+static inline void bw_noise_gate_set_profile_stats(
+	bw_noise_gate_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                 stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_noise_gate_process()` and
+ *    `bw_noise_gate_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_noise_gate_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_noise_gate_coeffs_is_valid(
@@ -335,6 +351,9 @@ struct bw_noise_gate_coeffs {
 	enum bw_noise_gate_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_env_follow_coeffs		env_follow_coeffs;
@@ -371,6 +390,9 @@ static inline void bw_noise_gate_init(
 	coeffs->thresh = 1.f;
 	coeffs->ratio = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_noise_gate_coeffs");
 	coeffs->state = bw_noise_gate_coeffs_state_init;
@@ -552,11 +574,13 @@ static inline void bw_noise_gate_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x_sc, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_noise_gate_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_noise_gate_update_coeffs_audio(coeffs);
 		y[i] = bw_noise_gate_process1(coeffs, state, x[i], x_sc[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_noise_gate_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gate_coeffs_state_reset_coeffs);
@@ -589,12 +613,14 @@ static inline void bw_noise_gate_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_noise_gate_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_noise_gate_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_noise_gate_process1(coeffs, state[j], x[j][i], x_sc[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_noise_gate_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gate_coeffs_state_reset_coeffs);
@@ -675,6 +701,24 @@ static inline void bw_noise_gate_set_release_tau(
 	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gate_coeffs_state_init);
 }
 
+static inline void bw_noise_gate_set_profile_stats(
+		bw_noise_gate_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                 stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_noise_gate_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gate_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_noise_gate_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gate_coeffs_state_init);
+}
+
 static inline char bw_noise_gate_coeffs_is_valid(
 		const bw_noise_gate_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -793,6 +837,9 @@ public:
 
 	void setReleaseTau(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -909,6 +956,12 @@ inline void NoiseGate<N_CHANNELS>::setReleaseTau(
 	bw_noise_gate_set_release_tau(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void NoiseGate<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_noise_gate_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
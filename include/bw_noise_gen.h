@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_rand }}}
  *  description {{{
  *    Generator of white noise with uniform distribution.
@@ -31,8 +31,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_noise_gen_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -195,6 +198,19 @@ static inline float bw_noise_gen_get_scaling_k(
  *
  *    `coeffs` must be at least inthe "sample-rate-set" state.
  *
+ *    #### bw_noise_gen_set_profile_stats()
+ *  ```>>> */
+static inline void bw_noise_gen_set_profile_stats(
+	bw_noise_gen_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_noise_gen_process()` and
+ *    `bw_noise_gen_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_noise_gen_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_noise_gen_coeffs_is_valid(
@@ -238,6 +254,9 @@ struct bw_noise_gen_coeffs {
 	uint32_t			hash;
 	enum bw_noise_gen_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	float				scaling_k;
@@ -256,6 +275,9 @@ static inline void bw_noise_gen_init(
 	coeffs->rand_state = state;
 	coeffs->sample_rate_scaling = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_noise_gen_coeffs");
 	coeffs->state = bw_noise_gen_coeffs_state_init;
@@ -353,12 +375,14 @@ static inline void bw_noise_gen_process(
 	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gen_coeffs_state_reset_coeffs);
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->sample_rate_scaling)
 		for (size_t i = 0; i < n_samples; i++)
 			y[i] = bw_noise_gen_process1(coeffs);
 	else
 		for (size_t i = 0; i < n_samples; i++)
 			y[i] = bw_noise_gen_process1_scaling(coeffs);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_noise_gen_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gen_coeffs_state_reset_coeffs);
@@ -380,8 +404,10 @@ static inline void bw_noise_gen_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_channels; i++)
 		bw_noise_gen_process(coeffs, y[i], n_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_noise_gen_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gen_coeffs_state_reset_coeffs);
@@ -409,6 +435,24 @@ static inline float bw_noise_gen_get_scaling_k(
 	return coeffs->scaling_k;
 }
 
+static inline void bw_noise_gen_set_profile_stats(
+		bw_noise_gen_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_noise_gen_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gen_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_noise_gen_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_noise_gen_coeffs_state_init);
+}
+
 static inline char bw_noise_gen_coeffs_is_valid(
 		const bw_noise_gen_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -466,6 +510,9 @@ public:
 		bool value);
 	
 	float getScalingK();
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -522,6 +569,12 @@ inline float NoiseGen<N_CHANNELS>::getScalingK() {
 	return bw_noise_gen_get_scaling_k(&coeffs);
 }
 
+template<size_t N_CHANNELS>
+inline void NoiseGen<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_noise_gen_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
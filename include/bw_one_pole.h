@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    One-pole (6 dB/oct) lowpass filter with unitary DC gain, separate attack
@@ -30,9 +30,17 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_one_pole_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_one_pole_flush_denormals()</code> and support for
+ *              <code>BW_FLUSH_DENORMALS</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
+ *          <li><code>bw_one_pole_process_multi()</code> now processes
+ *              channels in groups of 8 lanes using a structure-of-arrays
+ *              layout that can be vectorized by the compiler.</li>
  *        </ul>
  *      </li>
  *      <li>Version <strong>1.0.0</strong>:
@@ -421,6 +429,31 @@ static inline float bw_one_pole_get_y_z1(
 /*! <<<```
  *    Returns the last output sample as stored in `state`.
  *
+ *    #### bw_one_pole_flush_denormals()
+ *  ```>>> */
+static inline void bw_one_pole_flush_denormals(
+	const bw_one_pole_coeffs * BW_RESTRICT coeffs,
+	bw_one_pole_state * BW_RESTRICT        state);
+/*! <<<```
+ *    Sets the values in `state` whose absolute value is lower than 2^-80 to
+ *    `0.f` (see `bw_flush_denormal()`).
+ *
+ *    If `BW_FLUSH_DENORMALS` is defined, this is automatically called at the
+ *    end of `bw_one_pole_process()` and `bw_one_pole_process_multi()`.
+ *
+ *    #### bw_one_pole_set_profile_stats()
+ *  ```>>> */
+static inline void bw_one_pole_set_profile_stats(
+	bw_one_pole_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *               stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_one_pole_process()` and
+ *    `bw_one_pole_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_one_pole_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_one_pole_coeffs_is_valid(
@@ -480,6 +513,9 @@ struct bw_one_pole_coeffs {
 	enum bw_one_pole_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	float				fs_2pi;
@@ -519,6 +555,9 @@ static inline void bw_one_pole_init(
 	coeffs->sticky_thresh = 0.f;
 	coeffs->sticky_mode = bw_one_pole_sticky_mode_abs;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_one_pole_coeffs");
 	coeffs->state = bw_one_pole_coeffs_state_init;
@@ -811,6 +850,7 @@ static inline void bw_one_pole_process(
 	BW_ASSERT(x != BW_NULL);
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_one_pole_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL) {
 		if (coeffs->mA1u != coeffs->mA1d) {
@@ -872,12 +912,138 @@ static inline void bw_one_pole_process(
 		}
 	}
 
+#ifdef BW_FLUSH_DENORMALS
+	bw_one_pole_flush_denormals(coeffs, state);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
+
 	BW_ASSERT_DEEP(bw_one_pole_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_one_pole_coeffs_state_reset_coeffs);
 	BW_ASSERT_DEEP(bw_one_pole_state_is_valid(coeffs, state));
 	BW_ASSERT_DEEP(y != BW_NULL ? bw_has_only_finite(y, n_samples) : 1);
 }
 
+#define BW_ONE_POLE_N_LANES	8
+#define BW_ONE_POLE_LANE_BLOCK	32
+
+enum bw_one_pole_lanes_mode {
+	bw_one_pole_lanes_mode_sym,
+	bw_one_pole_lanes_mode_sym_sticky_abs,
+	bw_one_pole_lanes_mode_sym_sticky_rel,
+	bw_one_pole_lanes_mode_asym,
+	bw_one_pole_lanes_mode_asym_sticky_abs,
+	bw_one_pole_lanes_mode_asym_sticky_rel
+};
+
+// Processes up to BW_ONE_POLE_N_LANES channels at once. Input samples are
+// transposed in blocks to a structure-of-arrays layout so that the inner loops
+// run over a fixed number of independent lanes and can be vectorized by the
+// compiler, then outputs are transposed back. Unused lanes are zero-padded.
+static inline void bw_one_pole_process_lanes(
+		const bw_one_pole_coeffs * BW_RESTRICT              coeffs,
+		bw_one_pole_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float * const *                               x,
+		float * const *                                     y,
+		size_t                                              n_lanes,
+		size_t                                              n_samples,
+		enum bw_one_pole_lanes_mode                         mode) {
+	float y_z1[BW_ONE_POLE_N_LANES];
+	float xb[BW_ONE_POLE_LANE_BLOCK][BW_ONE_POLE_N_LANES];
+	float yb[BW_ONE_POLE_LANE_BLOCK][BW_ONE_POLE_N_LANES];
+	const float mA1u = coeffs->mA1u;
+	const float mA1d = coeffs->mA1d;
+	const float st2 = coeffs->st2;
+
+	for (size_t k = 0; k < n_lanes; k++)
+		y_z1[k] = state[k]->y_z1;
+	for (size_t k = n_lanes; k < BW_ONE_POLE_N_LANES; k++) {
+		y_z1[k] = 0.f;
+		for (size_t m = 0; m < BW_ONE_POLE_LANE_BLOCK; m++)
+			xb[m][k] = 0.f;
+	}
+
+	for (size_t i = 0; i < n_samples; i += BW_ONE_POLE_LANE_BLOCK) {
+		const size_t n = n_samples - i < BW_ONE_POLE_LANE_BLOCK ? n_samples - i : BW_ONE_POLE_LANE_BLOCK;
+
+		for (size_t k = 0; k < n_lanes; k++)
+			for (size_t m = 0; m < n; m++)
+				xb[m][k] = x[k][i + m];
+
+		switch (mode) {
+		case bw_one_pole_lanes_mode_sym:
+			for (size_t m = 0; m < n; m++)
+				for (size_t k = 0; k < BW_ONE_POLE_N_LANES; k++) {
+					const float v = xb[m][k] + mA1u * (y_z1[k] - xb[m][k]);
+					y_z1[k] = v;
+					yb[m][k] = v;
+				}
+			break;
+		case bw_one_pole_lanes_mode_sym_sticky_abs:
+			for (size_t m = 0; m < n; m++)
+				for (size_t k = 0; k < BW_ONE_POLE_N_LANES; k++) {
+					const float xv = xb[m][k];
+					const float v = xv + mA1u * (y_z1[k] - xv);
+					const float d = v - xv;
+					const float o = d * d <= st2 ? xv : v;
+					y_z1[k] = o;
+					yb[m][k] = o;
+				}
+			break;
+		case bw_one_pole_lanes_mode_sym_sticky_rel:
+			for (size_t m = 0; m < n; m++)
+				for (size_t k = 0; k < BW_ONE_POLE_N_LANES; k++) {
+					const float xv = xb[m][k];
+					const float v = xv + mA1u * (y_z1[k] - xv);
+					const float d = v - xv;
+					const float o = d * d <= st2 * xv * xv ? xv : v;
+					y_z1[k] = o;
+					yb[m][k] = o;
+				}
+			break;
+		case bw_one_pole_lanes_mode_asym:
+			for (size_t m = 0; m < n; m++)
+				for (size_t k = 0; k < BW_ONE_POLE_N_LANES; k++) {
+					const float xv = xb[m][k];
+					const float v = xv + (xv >= y_z1[k] ? mA1u : mA1d) * (y_z1[k] - xv);
+					y_z1[k] = v;
+					yb[m][k] = v;
+				}
+			break;
+		case bw_one_pole_lanes_mode_asym_sticky_abs:
+			for (size_t m = 0; m < n; m++)
+				for (size_t k = 0; k < BW_ONE_POLE_N_LANES; k++) {
+					const float xv = xb[m][k];
+					const float v = xv + (xv >= y_z1[k] ? mA1u : mA1d) * (y_z1[k] - xv);
+					const float d = v - xv;
+					const float o = d * d <= st2 ? xv : v;
+					y_z1[k] = o;
+					yb[m][k] = o;
+				}
+			break;
+		default:
+			for (size_t m = 0; m < n; m++)
+				for (size_t k = 0; k < BW_ONE_POLE_N_LANES; k++) {
+					const float xv = xb[m][k];
+					const float v = xv + (xv >= y_z1[k] ? mA1u : mA1d) * (y_z1[k] - xv);
+					const float d = v - xv;
+					const float o = d * d <= st2 * xv * xv ? xv : v;
+					y_z1[k] = o;
+					yb[m][k] = o;
+				}
+			break;
+		}
+
+		if (y != BW_NULL)
+			for (size_t k = 0; k < n_lanes; k++)
+				if (y[k] != BW_NULL)
+					for (size_t m = 0; m < n; m++)
+						y[k][i + m] = yb[m][k];
+	}
+
+	for (size_t k = 0; k < n_lanes; k++)
+		state[k]->y_z1 = y_z1[k];
+}
+
 static inline void bw_one_pole_process_multi(
 		bw_one_pole_coeffs * BW_RESTRICT                    coeffs,
 		bw_one_pole_state * BW_RESTRICT const * BW_RESTRICT state,
@@ -901,9 +1067,39 @@ static inline void bw_one_pole_process_multi(
 			for (size_t j = i + 1; j < n_channels; j++)
 				BW_ASSERT(y[i] == BW_NULL || y[j] == BW_NULL || y[i] != y[j]);
 #endif
+#ifdef BW_DEBUG_DEEP
+	for (size_t i = 0; i < n_channels; i++) {
+		BW_ASSERT_DEEP(bw_one_pole_state_is_valid(coeffs, state[i]));
+		BW_ASSERT_DEEP(bw_has_only_finite(x[i], n_samples));
+	}
+#endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_one_pole_update_coeffs_ctrl(coeffs);
-	if (y != BW_NULL) {
+	// transposition overhead only pays off with enough work per call
+	if (n_samples >= 16 && n_channels * n_samples >= 256) {
+		enum bw_one_pole_lanes_mode mode;
+		if (coeffs->mA1u != coeffs->mA1d) {
+			if (coeffs->st2 != 0.f)
+				mode = coeffs->sticky_mode == bw_one_pole_sticky_mode_abs
+					? bw_one_pole_lanes_mode_asym_sticky_abs : bw_one_pole_lanes_mode_asym_sticky_rel;
+			else
+				mode = bw_one_pole_lanes_mode_asym;
+		} else {
+			if (coeffs->st2 != 0.f)
+				mode = coeffs->sticky_mode == bw_one_pole_sticky_mode_abs
+					? bw_one_pole_lanes_mode_sym_sticky_abs : bw_one_pole_lanes_mode_sym_sticky_rel;
+			else
+				mode = bw_one_pole_lanes_mode_sym;
+		}
+		size_t j = 0;
+		for (; j + 1 < n_channels; j += BW_ONE_POLE_N_LANES) {
+			const size_t n_lanes = n_channels - j < BW_ONE_POLE_N_LANES ? n_channels - j : BW_ONE_POLE_N_LANES;
+			bw_one_pole_process_lanes(coeffs, state + j, x + j, y != BW_NULL ? y + j : BW_NULL, n_lanes, n_samples, mode);
+		}
+		if (j < n_channels)
+			bw_one_pole_process(coeffs, state[j], x[j], y != BW_NULL ? y[j] : BW_NULL, n_samples);
+	} else if (y != BW_NULL) {
 		if (coeffs->mA1u != coeffs->mA1d) {
 			if (coeffs->st2 != 0.f) {
 				if (coeffs->sticky_mode == bw_one_pole_sticky_mode_abs)
@@ -1000,8 +1196,20 @@ static inline void bw_one_pole_process_multi(
 		}
 	}
 
+#ifdef BW_FLUSH_DENORMALS
+	for (size_t i = 0; i < n_channels; i++)
+		bw_one_pole_flush_denormals(coeffs, state[i]);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
 	BW_ASSERT_DEEP(bw_one_pole_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_one_pole_coeffs_state_reset_coeffs);
+#ifdef BW_DEBUG_DEEP
+	for (size_t i = 0; i < n_channels; i++) {
+		BW_ASSERT_DEEP(bw_one_pole_state_is_valid(coeffs, state[i]));
+		BW_ASSERT_DEEP(y != BW_NULL && y[i] != BW_NULL ? bw_has_only_finite(y[i], n_samples) : 1);
+	}
+#endif
 }
 
 static inline void bw_one_pole_set_cutoff(
@@ -1153,6 +1361,39 @@ static inline float bw_one_pole_get_y_z1(
 	return state->y_z1;
 }
 
+static inline void bw_one_pole_flush_denormals(
+		const bw_one_pole_coeffs * BW_RESTRICT coeffs,
+		bw_one_pole_state * BW_RESTRICT        state) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_one_pole_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_one_pole_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_one_pole_state_is_valid(coeffs, state));
+
+	(void)coeffs;
+	state->y_z1 = bw_flush_denormal(state->y_z1);
+
+	BW_ASSERT_DEEP(bw_one_pole_state_is_valid(coeffs, state));
+}
+
+static inline void bw_one_pole_set_profile_stats(
+		bw_one_pole_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *               stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_one_pole_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_one_pole_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_one_pole_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_one_pole_coeffs_state_init);
+}
+
 static inline char bw_one_pole_coeffs_is_valid(
 		const bw_one_pole_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -1213,6 +1454,8 @@ static inline char bw_one_pole_state_is_valid(
 #undef BW_ONE_POLE_PARAM_CUTOFF_UP
 #undef BW_ONE_POLE_PARAM_CUTOFF_DOWN
 #undef BW_ONE_POLE_PARAM_STICKY_THRESH
+#undef BW_ONE_POLE_N_LANES
+#undef BW_ONE_POLE_LANE_BLOCK
 
 #ifdef __cplusplus
 }
@@ -1286,6 +1529,9 @@ public:
 
 	float getYZ1(
 		size_t channel);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -1420,6 +1666,12 @@ inline float OnePole<N_CHANNELS>::getYZ1(
 	return bw_one_pole_get_y_z1(states + channel);
 }
 
+template<size_t N_CHANNELS>
+inline void OnePole<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_one_pole_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
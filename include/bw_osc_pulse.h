@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Pulse oscillator waveshaper with variable pulse width (actually, duty
@@ -37,8 +37,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_osc_pulse_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -234,6 +237,19 @@ static inline void bw_osc_pulse_set_pulse_width(
  *
  *    Default value: `0.5f`.
  *
+ *    #### bw_osc_pulse_set_profile_stats()
+ *  ```>>> */
+static inline void bw_osc_pulse_set_profile_stats(
+	bw_osc_pulse_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_osc_pulse_process()` and
+ *    `bw_osc_pulse_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_osc_pulse_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_osc_pulse_coeffs_is_valid(
@@ -277,6 +293,9 @@ struct bw_osc_pulse_coeffs {
 	uint32_t			hash;
 	enum bw_osc_pulse_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -296,6 +315,9 @@ static inline void bw_osc_pulse_init(
 	coeffs->antialiasing = 0;
 	coeffs->pulse_width = 0.5f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_osc_pulse_coeffs");
 	coeffs->state = bw_osc_pulse_coeffs_state_init;
@@ -439,6 +461,7 @@ static inline void bw_osc_pulse_process(
 	BW_ASSERT_DEEP(coeffs->antialiasing ? bw_has_only_finite(x_inc, n_samples) : 1);
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->antialiasing)
 		for (size_t i = 0; i < n_samples; i++) {
 			bw_osc_pulse_update_coeffs_audio(coeffs);
@@ -449,6 +472,7 @@ static inline void bw_osc_pulse_process(
 			bw_osc_pulse_update_coeffs_audio(coeffs);
 			y[i] = bw_osc_pulse_process1(coeffs, x[i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_osc_pulse_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_osc_pulse_coeffs_state_reset_coeffs);
@@ -473,6 +497,7 @@ static inline void bw_osc_pulse_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->antialiasing)
 		for (size_t i = 0; i < n_samples; i++) {
 			bw_osc_pulse_update_coeffs_audio(coeffs);
@@ -485,6 +510,7 @@ static inline void bw_osc_pulse_process_multi(
 			for (size_t j = 0; j < n_channels; j++)
 				y[j][i] = bw_osc_pulse_process1(coeffs, x[j][i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_osc_pulse_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_osc_pulse_coeffs_state_reset_coeffs);
@@ -518,6 +544,24 @@ static inline void bw_osc_pulse_set_pulse_width(
 	BW_ASSERT_DEEP(coeffs->state >= bw_osc_pulse_coeffs_state_init);
 }
 
+static inline void bw_osc_pulse_set_profile_stats(
+		bw_osc_pulse_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_osc_pulse_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_osc_pulse_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_osc_pulse_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_osc_pulse_coeffs_state_init);
+}
+
 static inline char bw_osc_pulse_coeffs_is_valid(
 		const bw_osc_pulse_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -571,6 +615,9 @@ public:
 
 	void setPulseWidth(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -631,6 +678,12 @@ inline void OscPulse<N_CHANNELS>::setPulseWidth(
 	bw_osc_pulse_set_pulse_width(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void OscPulse<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_osc_pulse_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    Sawtooth oscillator waveshaper with PolyBLEP antialiasing.
@@ -36,8 +36,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_osc_saw_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -224,6 +227,19 @@ static inline void bw_osc_saw_set_antialiasing(
  *
  *    Default value: `0` (off).
  *
+ *    #### bw_osc_saw_set_profile_stats()
+ *  ```>>> */
+static inline void bw_osc_saw_set_profile_stats(
+	bw_osc_saw_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *              stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_osc_saw_process()` and
+ *    `bw_osc_saw_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_osc_saw_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_osc_saw_coeffs_is_valid(
@@ -266,6 +282,9 @@ struct bw_osc_saw_coeffs {
 	uint32_t			hash;
 	enum bw_osc_saw_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Parameters
 	char				antialiasing;
@@ -277,6 +296,9 @@ static inline void bw_osc_saw_init(
 
 	coeffs->antialiasing = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_osc_saw_coeffs");
 	coeffs->state = bw_osc_saw_coeffs_state_init;
@@ -410,12 +432,14 @@ static inline void bw_osc_saw_process(
 	BW_ASSERT_DEEP(coeffs->antialiasing ? bw_has_only_finite(x_inc, n_samples) : 1);
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->antialiasing)
 		for (size_t i = 0; i < n_samples; i++)
 			y[i] = bw_osc_saw_process1_antialias(coeffs, x[i], x_inc[i]);
 	else
 		for (size_t i = 0; i < n_samples; i++)
 			y[i] = bw_osc_saw_process1(coeffs, x[i]);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_osc_saw_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_osc_saw_coeffs_state_reset_coeffs);
@@ -440,12 +464,14 @@ static inline void bw_osc_saw_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (x_inc != BW_NULL)
 		for (size_t i = 0; i < n_channels; i++)
 			bw_osc_saw_process(coeffs, x[i], x_inc[i], y[i], n_samples);
 	else
 		for (size_t i = 0; i < n_channels; i++)
 			bw_osc_saw_process(coeffs, x[i], BW_NULL, y[i], n_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_osc_saw_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_osc_saw_coeffs_state_reset_coeffs);
@@ -464,6 +490,24 @@ static inline void bw_osc_saw_set_antialiasing(
 	BW_ASSERT_DEEP(coeffs->state >= bw_osc_saw_coeffs_state_init);
 }
 
+static inline void bw_osc_saw_set_profile_stats(
+		bw_osc_saw_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *              stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_osc_saw_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_osc_saw_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_osc_saw_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_osc_saw_coeffs_state_init);
+}
+
 static inline char bw_osc_saw_coeffs_is_valid(
 		const bw_osc_saw_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -515,6 +559,9 @@ public:
 		size_t                                nSamples);
 	
 	void setAntialiasing(bool value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -569,6 +616,12 @@ inline void OscSaw<N_CHANNELS>::setAntialiasing(
 	bw_osc_saw_set_antialiasing(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void OscSaw<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_osc_saw_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
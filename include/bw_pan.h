@@ -20,15 +20,23 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_one_pole }}}
  *  description {{{
  *    Stereo panner with -3 dB center pan law.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_pan_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_pan_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li><code>bw_pan_process()</code> and
+ *              <code>bw_pan_process_multi()</code> now use a faster code
+ *              path when gain smoothing has settled.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -162,6 +170,21 @@ static inline void bw_pan_process_multi(
  *    (left) and `y_r` (right), while using and updating the common `coeffs`
  *    (control and audio rate).
  *
+ *    #### bw_pan_process_interleaved()
+ *  ```>>> */
+static inline void bw_pan_process_interleaved(
+	bw_pan_coeffs * BW_RESTRICT coeffs,
+	const float *               x,
+	float *                     y_l,
+	float *                     y_r,
+	size_t                      n_channels,
+	size_t                      n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffers
+ *    `y_l` (left) and `y_r` (right), all made of `n_channels` channels, while
+ *    using and updating the common `coeffs` (control and audio rate).
+ *
  *    #### bw_pan_set_pan()
  *  ```>>> */
 static inline void bw_pan_set_pan(
@@ -175,6 +198,19 @@ static inline void bw_pan_set_pan(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_pan_set_profile_stats()
+ *  ```>>> */
+static inline void bw_pan_set_profile_stats(
+	bw_pan_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_pan_process()`,
+ *    `bw_pan_process_multi()`, and `bw_pan_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_pan_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_pan_coeffs_is_valid(
@@ -218,11 +254,17 @@ struct bw_pan_coeffs {
 	uint32_t			hash;
 	enum bw_pan_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_gain_coeffs			l_coeffs;
 	bw_gain_coeffs			r_coeffs;
 
+	// Coefficients
+	char				settled;
+
 	// Parameters
 	float				pan;
 	float				pan_prev;
@@ -236,6 +278,9 @@ static inline void bw_pan_init(
 	bw_gain_init(&coeffs->r_coeffs);
 	coeffs->pan = 0.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_pan_coeffs");
 	coeffs->state = bw_pan_coeffs_state_init;
@@ -282,6 +327,7 @@ static inline void bw_pan_reset_coeffs(
 	bw_pan_do_update_coeffs(coeffs, 1);
 	bw_gain_reset_coeffs(&coeffs->l_coeffs);
 	bw_gain_reset_coeffs(&coeffs->r_coeffs);
+	coeffs->settled = 1;
 
 #ifdef BW_DEBUG_DEEP
 	coeffs->state = bw_pan_coeffs_state_reset_coeffs;
@@ -299,6 +345,10 @@ static inline void bw_pan_update_coeffs_ctrl(
 	bw_pan_do_update_coeffs(coeffs, 0);
 	bw_gain_update_coeffs_ctrl(&coeffs->l_coeffs);
 	bw_gain_update_coeffs_ctrl(&coeffs->r_coeffs);
+	// once both gains have reached their targets, update_coeffs_audio() is a
+	// no-op until the pan is changed again
+	coeffs->settled = bw_gain_get_gain_cur(&coeffs->l_coeffs) == bw_gain_get_gain_lin(&coeffs->l_coeffs)
+		&& bw_gain_get_gain_cur(&coeffs->r_coeffs) == bw_gain_get_gain_lin(&coeffs->r_coeffs);
 
 	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_reset_coeffs);
@@ -354,11 +404,22 @@ static inline void bw_pan_process(
 	BW_ASSERT(y_r != BW_NULL);
 	BW_ASSERT(y_l != y_r);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_pan_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_pan_update_coeffs_audio(coeffs);
-		bw_pan_process1(coeffs, x[i], y_l + i, y_r + i);
-	}
+	if (coeffs->settled) {
+		const float g_l = bw_gain_get_gain_cur(&coeffs->l_coeffs);
+		const float g_r = bw_gain_get_gain_cur(&coeffs->r_coeffs);
+		for (size_t i = 0; i < n_samples; i++) {
+			const float v = x[i];
+			y_l[i] = g_l * v;
+			y_r[i] = g_r * v;
+		}
+	} else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_pan_update_coeffs_audio(coeffs);
+			bw_pan_process1(coeffs, x[i], y_l + i, y_r + i);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_reset_coeffs);
@@ -391,15 +452,68 @@ static inline void bw_pan_process_multi(
 			BW_ASSERT(y_l[i] != y_r[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_pan_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_pan_update_coeffs_audio(coeffs);
+	if (coeffs->settled) {
+		const float g_l = bw_gain_get_gain_cur(&coeffs->l_coeffs);
+		const float g_r = bw_gain_get_gain_cur(&coeffs->r_coeffs);
 		for (size_t j = 0; j < n_channels; j++)
-			bw_pan_process1(coeffs, x[j][i], y_l[j] + i, y_r[j] + i);
-	}
+			for (size_t i = 0; i < n_samples; i++) {
+				const float v = x[j][i];
+				y_l[j][i] = g_l * v;
+				y_r[j][i] = g_r * v;
+			}
+	} else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_pan_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++)
+				bw_pan_process1(coeffs, x[j][i], y_l[j] + i, y_r[j] + i);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_pan_process_interleaved(
+		bw_pan_coeffs * BW_RESTRICT coeffs,
+		const float *               x,
+		float *                     y_l,
+		float *                     y_r,
+		size_t                      n_channels,
+		size_t                      n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_reset_coeffs);
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y_l != BW_NULL);
+	BW_ASSERT(y_r != BW_NULL);
+	BW_ASSERT(y_l != y_r);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_pan_update_coeffs_ctrl(coeffs);
+	if (coeffs->settled) {
+		const float g_l = bw_gain_get_gain_cur(&coeffs->l_coeffs);
+		const float g_r = bw_gain_get_gain_cur(&coeffs->r_coeffs);
+		const size_t n = n_channels * n_frames;
+		for (size_t i = 0; i < n; i++) {
+			const float v = x[i];
+			y_l[i] = g_l * v;
+			y_r[i] = g_r * v;
+		}
+	} else
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_pan_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				bw_pan_process1(coeffs, x[k], y_l + k, y_r + k);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
 
 	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y_l, n_channels * n_frames));
+	BW_ASSERT_DEEP(bw_has_only_finite(y_r, n_channels * n_frames));
 }
 
 static inline void bw_pan_set_pan(
@@ -417,6 +531,24 @@ static inline void bw_pan_set_pan(
 	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_init);
 }
 
+static inline void bw_pan_set_profile_stats(
+		bw_pan_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_pan_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_pan_coeffs_state_init);
+}
+
 static inline char bw_pan_coeffs_is_valid(
 		const bw_pan_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -475,8 +607,17 @@ public:
 		std::array<float *, N_CHANNELS>       yR,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       yL,
+		float *       yR,
+		size_t        nFrames);
+
 	void setPan(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -525,12 +666,27 @@ inline void Pan<N_CHANNELS>::process(
 	process(x.data(), yL.data(), yR.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void Pan<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       yL,
+		float *       yR,
+		size_t        nFrames) {
+	bw_pan_process_interleaved(&coeffs, x, yL, yR, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void Pan<N_CHANNELS>::setPan(
 		float value) {
 	bw_pan_set_pan(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Pan<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_pan_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
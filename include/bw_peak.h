@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_gain bw_math bw_mm2 bw_one_pole bw_svf }}}
  *  description {{{
  *    Second-order peak filter with unitary gain at DC and asymptotically
@@ -35,8 +35,15 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_peak_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_peak_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li>Added <code>bw_peak_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -216,6 +223,22 @@ static inline void bw_peak_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_peak_process_interleaved()
+ *  ```>>> */
+static inline void bw_peak_process_interleaved(
+	bw_peak_coeffs * BW_RESTRICT                    coeffs,
+	bw_peak_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                   x,
+	float *                                         y,
+	size_t                                          n_channels,
+	size_t                                          n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_peak_set_cutoff()
  *  ```>>> */
 static inline void bw_peak_set_cutoff(
@@ -335,6 +358,34 @@ static inline void bw_peak_set_use_bandwidth(
  *
  *    Default value: non-`0` (use bandwidth parameter).
  *
+ *    #### bw_peak_set_interp_period()
+ *  ```>>> */
+static inline void bw_peak_set_interp_period(
+	bw_peak_coeffs * BW_RESTRICT coeffs,
+	size_t                       value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    See `bw_mm2_set_interp_period()` for details.
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_peak_set_profile_stats()
+ *  ```>>> */
+static inline void bw_peak_set_profile_stats(
+	bw_peak_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *           stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_peak_process()`,
+ *    `bw_peak_process_multi()`, and `bw_peak_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_peak_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_peak_coeffs_is_valid(
@@ -395,6 +446,9 @@ struct bw_peak_coeffs {
 	enum bw_peak_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_mm2_coeffs			mm2_coeffs;
@@ -434,6 +488,9 @@ static inline void bw_peak_init(
 	coeffs->bandwidth = 2.543106606327224f;
 	coeffs->use_bandwidth = 1;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_peak_coeffs");
 	coeffs->state = bw_peak_coeffs_state_init;
@@ -634,11 +691,13 @@ static inline void bw_peak_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_peak_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_peak_update_coeffs_audio(coeffs);
 		y[i] = bw_peak_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_reset_coeffs);
@@ -675,17 +734,58 @@ static inline void bw_peak_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_peak_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_peak_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_peak_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_peak_process_interleaved(
+		bw_peak_coeffs * BW_RESTRICT                    coeffs,
+		bw_peak_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                   x,
+		float *                                         y,
+		size_t                                          n_channels,
+		size_t                                          n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(coeffs->use_bandwidth
+		? bw_sqrtf(bw_pow2f(coeffs->bandwidth) * coeffs->peak_gain) * bw_rcpf(bw_pow2f(coeffs->bandwidth) - 1.f) >= 1e-6f
+			&& bw_sqrtf(bw_pow2f(coeffs->bandwidth) * coeffs->peak_gain) * bw_rcpf(bw_pow2f(coeffs->bandwidth) - 1.f) <= 1e6f
+		: 1);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_peak_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_peak_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++)
+			y[k] = bw_peak_process1(coeffs, state[j], x[k]);
+	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
+}
+
 static inline void bw_peak_set_cutoff(
 		bw_peak_coeffs * BW_RESTRICT coeffs,
 		float                        value) {
@@ -826,6 +926,38 @@ static inline void bw_peak_set_use_bandwidth(
 	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_init);
 }
 
+static inline void bw_peak_set_interp_period(
+		bw_peak_coeffs * BW_RESTRICT coeffs,
+		size_t                       value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	bw_mm2_set_interp_period(&coeffs->mm2_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_init);
+}
+
+static inline void bw_peak_set_profile_stats(
+		bw_peak_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *           stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_peak_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_peak_coeffs_state_init);
+}
+
 static inline char bw_peak_coeffs_is_valid(
 		const bw_peak_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -920,6 +1052,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -943,6 +1080,12 @@ public:
 
 	void setUseBandwidth(
 		bool value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -1023,6 +1166,14 @@ inline void Peak<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void Peak<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_peak_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void Peak<N_CHANNELS>::setCutoff(
 		float value) {
@@ -1071,6 +1222,18 @@ inline void Peak<N_CHANNELS>::setUseBandwidth(
 	bw_peak_set_use_bandwidth(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Peak<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_peak_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Peak<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_peak_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
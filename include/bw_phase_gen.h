@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Phase generator with portamento and exponential frequency modulation.
@@ -29,8 +29,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_phase_gen_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Fixed rounding bug when frequency is tiny and negative.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
@@ -274,6 +277,19 @@ static inline void bw_phase_gen_set_portamento_tau(
  *
  *    Default value: `0.f`.
  *
+ *    #### bw_phase_gen_set_profile_stats()
+ *  ```>>> */
+static inline void bw_phase_gen_set_profile_stats(
+	bw_phase_gen_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_phase_gen_process()` and
+ *    `bw_phase_gen_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_phase_gen_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_phase_gen_coeffs_is_valid(
@@ -334,6 +350,9 @@ struct bw_phase_gen_coeffs {
 	enum bw_phase_gen_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		portamento_coeffs;
@@ -366,6 +385,9 @@ static inline void bw_phase_gen_init(
 	bw_one_pole_init(&coeffs->portamento_coeffs);
 	coeffs->frequency = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_phase_gen_coeffs");
 	coeffs->state = bw_phase_gen_coeffs_state_init;
@@ -598,6 +620,7 @@ static inline void bw_phase_gen_process(
 	BW_ASSERT_DEEP(x_mod != BW_NULL ? bw_has_only_finite(x_mod, n_samples) : 1);
 	BW_ASSERT(y != BW_NULL && y_inc != BW_NULL ? y != y_inc : 1);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_phase_gen_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL) {
 		if (x_mod != BW_NULL) {
@@ -654,6 +677,7 @@ static inline void bw_phase_gen_process(
 				}
 		}
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_phase_gen_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_phase_gen_coeffs_state_reset_coeffs);
@@ -692,6 +716,7 @@ static inline void bw_phase_gen_process_multi(
 				BW_ASSERT(y[i] != y_inc[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_phase_gen_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL) {
 		if (x_mod != BW_NULL) {
@@ -794,6 +819,7 @@ static inline void bw_phase_gen_process_multi(
 				}
 		}
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_phase_gen_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_phase_gen_coeffs_state_reset_coeffs);
@@ -828,6 +854,24 @@ static inline void bw_phase_gen_set_portamento_tau(
 	BW_ASSERT_DEEP(coeffs->state >= bw_phase_gen_coeffs_state_init);
 }
 
+static inline void bw_phase_gen_set_profile_stats(
+		bw_phase_gen_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_phase_gen_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_phase_gen_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_phase_gen_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_phase_gen_coeffs_state_init);
+}
+
 static inline char bw_phase_gen_coeffs_is_valid(
 		const bw_phase_gen_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -940,6 +984,9 @@ public:
 
 	void setPortamentoTau(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -1055,6 +1102,12 @@ inline void PhaseGen<N_CHANNELS>::setPortamentoTau(
 	bw_phase_gen_set_portamento_tau(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void PhaseGen<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_phase_gen_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{
  *    bw_ap1 bw_common bw_lp1 bw_math bw_one_pole bw_osc_sin bw_phase_gen
  *  }}}
@@ -30,8 +30,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_phaser_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -250,6 +253,19 @@ static inline void bw_phaser_set_amount(
  *
  *    Default value: `1.f`.
  *
+ *    #### bw_phaser_set_profile_stats()
+ *  ```>>> */
+static inline void bw_phaser_set_profile_stats(
+	bw_phaser_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *             stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_phaser_process()` and
+ *    `bw_phaser_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_phaser_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_phaser_coeffs_is_valid(
@@ -312,6 +328,9 @@ struct bw_phaser_coeffs {
 	enum bw_phaser_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_phase_gen_coeffs		phase_gen_coeffs;
@@ -342,6 +361,9 @@ static inline void bw_phaser_init(
 	coeffs->center = 1e3f;
 	coeffs->amount = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_phaser_coeffs");
 	coeffs->state = bw_phaser_coeffs_state_init;
@@ -519,11 +541,13 @@ static inline void bw_phaser_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_phaser_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_phaser_update_coeffs_audio(coeffs);
 		y[i] = bw_phaser_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_phaser_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_phaser_coeffs_state_reset_coeffs);
@@ -556,12 +580,14 @@ static inline void bw_phaser_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_phaser_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_phaser_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_phaser_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_phaser_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_phaser_coeffs_state_reset_coeffs);
@@ -611,6 +637,24 @@ static inline void bw_phaser_set_amount(
 	BW_ASSERT_DEEP(coeffs->state >= bw_phaser_coeffs_state_init);
 }
 
+static inline void bw_phaser_set_profile_stats(
+		bw_phaser_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *             stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_phaser_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_phaser_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_phaser_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_phaser_coeffs_state_init);
+}
+
 static inline char bw_phaser_coeffs_is_valid(
 		const bw_phaser_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -711,6 +755,9 @@ public:
 
 	void setAmount(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -809,6 +856,12 @@ inline void Phaser<N_CHANNELS>::setAmount(
 	bw_phaser_set_amount(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Phaser<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_phaser_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
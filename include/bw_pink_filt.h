@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common }}}
  *  description {{{
  *    Pinking filter.
@@ -40,8 +40,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_pink_filt_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -273,6 +276,19 @@ static inline float bw_pink_filt_get_scaling_k(
  *
  *    `coeffs` must be at least in the "sample-rate-set" state.
  *
+ *    #### bw_pink_filt_set_profile_stats()
+ *  ```>>> */
+static inline void bw_pink_filt_set_profile_stats(
+	bw_pink_filt_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_pink_filt_process()` and
+ *    `bw_pink_filt_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_pink_filt_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_pink_filt_coeffs_is_valid(
@@ -330,6 +346,9 @@ struct bw_pink_filt_coeffs {
 	enum bw_pink_filt_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	float				scaling_k;
@@ -357,6 +376,9 @@ static inline void bw_pink_filt_init(
 
 	coeffs->sample_rate_scaling = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_pink_filt_coeffs");
 	coeffs->state = bw_pink_filt_coeffs_state_init;
@@ -540,12 +562,14 @@ static inline void bw_pink_filt_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->sample_rate_scaling)
 		for (size_t i = 0; i < n_samples; i++)
 			y[i] = bw_pink_filt_process1_scaling(coeffs, state, x[i]);
 	else
 		for (size_t i = 0; i < n_samples; i++)
 			y[i] = bw_pink_filt_process1(coeffs, state, x[i]);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_pink_filt_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_pink_filt_coeffs_state_reset_coeffs);
@@ -577,8 +601,10 @@ static inline void bw_pink_filt_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_channels; i++)
 		bw_pink_filt_process(coeffs, state[i], x[i], y[i], n_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_pink_filt_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_pink_filt_coeffs_state_reset_coeffs);
@@ -606,6 +632,24 @@ static inline float bw_pink_filt_get_scaling_k(
 	return coeffs->scaling_k;
 }
 
+static inline void bw_pink_filt_set_profile_stats(
+		bw_pink_filt_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_pink_filt_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_pink_filt_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_pink_filt_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_pink_filt_coeffs_state_init);
+}
+
 static inline char bw_pink_filt_coeffs_is_valid(
 		const bw_pink_filt_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -693,6 +737,9 @@ public:
 		bool value);
 
 	float getScalingK();
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -784,6 +831,12 @@ inline float PinkFilt<N_CHANNELS>::getScalingK() {
 	return bw_pink_filt_get_scaling_k(&coeffs);
 }
 
+template<size_t N_CHANNELS>
+inline void PinkFilt<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_pink_filt_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
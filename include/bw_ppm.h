@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_env_follow bw_math bw_one_pole }}}
  *  description {{{
  *    Digital peak programme meter with adjustable integration time constant.
@@ -30,8 +30,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_ppm_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -231,6 +234,19 @@ static inline float bw_ppm_get_y_z1(
 /*! <<<```
  *    Returns the last output sample as stored in `state`.
  *
+ *    #### bw_ppm_set_profile_stats()
+ *  ```>>> */
+static inline void bw_ppm_set_profile_stats(
+	bw_ppm_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_ppm_process()` and
+ *    `bw_ppm_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_ppm_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_ppm_coeffs_is_valid(
@@ -289,6 +305,9 @@ struct bw_ppm_coeffs {
 	uint32_t			hash;
 	enum bw_ppm_coeffs_state	state;
 	uint32_t			reset_id;
+#endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
 #endif
 	// Sub-components
 	bw_env_follow_coeffs		env_follow_coeffs;
@@ -314,6 +333,9 @@ static inline void bw_ppm_init(
 	bw_env_follow_init(&coeffs->env_follow_coeffs);
 	bw_env_follow_set_release_tau(&coeffs->env_follow_coeffs, 0.738300619235528f);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_ppm_coeffs");
 	coeffs->state = bw_ppm_coeffs_state_init;
@@ -472,6 +494,7 @@ static inline void bw_ppm_process(
 	BW_ASSERT(x != BW_NULL);
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_ppm_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL)
 		for (size_t i = 0; i < n_samples; i++) {
@@ -483,6 +506,7 @@ static inline void bw_ppm_process(
 			bw_ppm_update_coeffs_audio(coeffs);
 			bw_ppm_process1(coeffs, state, x[i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_ppm_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ppm_coeffs_state_reset_coeffs);
@@ -514,6 +538,7 @@ static inline void bw_ppm_process_multi(
 				BW_ASSERT(y[i] == BW_NULL || y[j] == BW_NULL || y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_ppm_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL)
 		for (size_t i = 0; i < n_samples; i++) {
@@ -530,6 +555,7 @@ static inline void bw_ppm_process_multi(
 			for (size_t j = 0; j < n_channels; j++)
 				bw_ppm_process1(coeffs, state[j], x[j][i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_ppm_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ppm_coeffs_state_reset_coeffs);
@@ -557,6 +583,24 @@ static inline float bw_ppm_get_y_z1(const bw_ppm_state *BW_RESTRICT state) {
 	return state->y_z1;
 }
 
+static inline void bw_ppm_set_profile_stats(
+		bw_ppm_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ppm_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ppm_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_ppm_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ppm_coeffs_state_init);
+}
+
 static inline char bw_ppm_coeffs_is_valid(
 		const bw_ppm_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -641,6 +685,9 @@ public:
 
 	float getYZ1(
 		size_t channel);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -733,6 +780,12 @@ inline float PPM<N_CHANNELS>::getYZ1(
 	return bw_ppm_get_y_z1(states + channel);
 }
 
+template<size_t N_CHANNELS>
+inline void PPM<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_ppm_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
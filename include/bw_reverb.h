@@ -20,10 +20,10 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{
- *    bw_buf bw_common bw_delay bw_dry_wet bw_gain bw_lp1 bw_math bw_one_pole
- *    bw_osc_sin bw_phase_gen
+ *    bw_arena bw_buf bw_common bw_delay bw_dry_wet bw_gain bw_lp1 bw_math
+ *    bw_one_pole bw_osc_sin bw_phase_gen
  *  }}}
  *  description {{{
  *    Stereo reverb.
@@ -35,8 +35,31 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_reverb_mem_req_max()</code>.</li>
+ *          <li>C++ API now only reallocates memory in
+ *              <code>setSampleRate()</code> when needed.</li>
+ *          <li>Added <code>getMemReq()</code> and <code>setMemory()</code> to
+ *              C++ API, which now also aligns the memory of each channel to
+ *              <code>BW_ARENA_ALIGN</code> bytes.</li>
+ *          <li><code>setSampleRate()</code> in C++ API now returns whether
+ *              it succeeded.</li>
+ *          <li>Added <code>bw_reverb_set_mod_ctrl_rate()</code> and updated
+ *              C++ API in this regard.</li>
+ *          <li>Added <code>bw_reverb_set_block_processing()</code> and updated
+ *              C++ API in this regard.</li>
+ *          <li>Fixed second half of the tank writing into the wrong diffusion
+ *              delay line.</li>
+ *          <li>Added <code>bw_reverb_set_pow2_length()</code> and updated C++
+ *              API in this regard.</li>
+ *          <li>Added <code>bw_reverb_set_lazy_reset()</code> and updated C++
+ *              API in this regard.</li>
+ *          <li>Added <code>bw_reverb_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_reverb_flush_denormals()</code> and support for
+ *              <code>BW_FLUSH_DENORMALS</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -124,6 +147,25 @@ static inline size_t bw_reverb_mem_req(
  *    Returns the size, in bytes, of contiguous memory to be supplied to
  *    `bw_reverb_mem_set()` using `coeffs`.
  *
+ *    #### bw_reverb_mem_req_max()
+ *  ```>>> */
+static inline size_t bw_reverb_mem_req_max(
+	const bw_reverb_coeffs * BW_RESTRICT coeffs,
+	float                                max_sample_rate);
+/*! <<<```
+ *    Returns the size, in bytes, of contiguous memory to be supplied to
+ *    `bw_reverb_mem_set()` using `coeffs` so that it can be reused at any
+ *    sample rate up to `max_sample_rate` (Hz).
+ *
+ *    After `bw_reverb_set_sample_rate()` is called with a `sample_rate` not
+ *    greater than `max_sample_rate`, the same memory block can be associated
+ *    again by calling `bw_reverb_mem_set()`, which neither allocates nor
+ *    touches the memory, and then `bw_reverb_reset_state()` as usual.
+ *
+ *    It can be called any time after `bw_reverb_init()`.
+ *
+ *    `max_sample_rate` must be finite and positive.
+ *
  *    #### bw_reverb_mem_set()
  *  ```>>> */
 static inline void bw_reverb_mem_set(
@@ -299,6 +341,111 @@ static inline void bw_reverb_set_wet(
  *
  *    Default value: `0.5f`.
  *
+ *    #### bw_reverb_flush_denormals()
+ *  ```>>> */
+static inline void bw_reverb_flush_denormals(
+	const bw_reverb_coeffs * BW_RESTRICT coeffs,
+	bw_reverb_state * BW_RESTRICT        state);
+/*! <<<```
+ *    Sets the values in `state` whose absolute value is lower than 2^-80 to
+ *    `0.f` (see `bw_flush_denormal()`).
+ *
+ *    If `BW_FLUSH_DENORMALS` is defined, this is automatically called at the
+ *    end of `bw_reverb_process()` and `bw_reverb_process_multi()`.
+ *
+ *    Delay line contents are not affected. However, if `BW_FLUSH_DENORMALS` is
+ *    defined, the values that are written into the reverb tank by
+ *    `bw_reverb_process1()` are flushed likewise.
+ *
+ *    #### bw_reverb_set_lazy_reset()
+ *  ```>>> */
+static inline void bw_reverb_set_lazy_reset(
+	bw_reverb_coeffs * BW_RESTRICT coeffs,
+	char                           value);
+/*! <<<```
+ *    Sets whether the internal delay lines should be cleared lazily when
+ *    resetting (`value` non-`0`) or not (`0`) in `coeffs`. See
+ *    `bw_delay_set_lazy_reset()` in [bw_delay](bw_delay) for more details.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_reverb_set_pow2_length()
+ *  ```>>> */
+static inline void bw_reverb_set_pow2_length(
+	bw_reverb_coeffs * BW_RESTRICT coeffs,
+	char                           value);
+/*! <<<```
+ *    Sets whether the lengths of the internal delay lines should be rounded
+ *    up to powers of `2` (`value` non-`0`) or not (`0`) in `coeffs`. See
+ *    `bw_delay_set_pow2_length()` in [bw_delay](bw_delay) for more details.
+ *
+ *    Changes only take effect at the next `bw_reverb_set_sample_rate()` call.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_reverb_set_block_processing()
+ *  ```>>> */
+static inline void bw_reverb_set_block_processing(
+	bw_reverb_coeffs * BW_RESTRICT coeffs,
+	char                           value);
+/*! <<<```
+ *    Sets whether `bw_reverb_process()` and `bw_reverb_process_multi()` should
+ *    process audio in blocks (`value` non-`0`) or one sample at a time (`0`)
+ *    in `coeffs`.
+ *
+ *    In block mode, input is split into chunks of up to `32` samples, which
+ *    are shorter than all delays in the reverb tank. Each chunk is processed
+ *    in stages: the input diffusers and all fixed-length delay reads and
+ *    writes are performed using contiguous block transfers (see
+ *    `bw_delay_read_block()` and `bw_delay_write_block()` in
+ *    [bw_delay](bw_delay)), while the remaining per-sample computations of
+ *    both halves of the tank happen in a single loop. This is plain scalar
+ *    code, not SIMD processing, as the two halves share sub-component
+ *    coefficients and call the same per-sample functions. Output is
+ *    bit-identical to that of the one sample at a time mode, unless the
+ *    compiler is allowed to contract floating point operations (e.g., into
+ *    fused multiply-adds), in which case differences are in the order of the
+ *    rounding error (around 1e-7 absolute with full-scale input). Block mode
+ *    uses around 4 kiB of stack.
+ *
+ *    Block mode is not used when processing less than `4` samples at a time,
+ *    where it would be slower, nor at sample rates lower than around `370.f`
+ *    Hz.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_reverb_set_mod_ctrl_rate()
+ *  ```>>> */
+static inline void bw_reverb_set_mod_ctrl_rate(
+	bw_reverb_coeffs * BW_RESTRICT coeffs,
+	char                           value);
+/*! <<<```
+ *    Sets whether the internal modulation of the tank allpass delays should be
+ *    computed at control rate (`value` non-`0`) or at audio rate (`0`) in
+ *    `coeffs`.
+ *
+ *    At control rate, the modulating oscillator is evaluated once every `16`
+ *    samples and delay times are linearly interpolated in between. The
+ *    resulting modulation is not identical to the audio rate one, as
+ *    oscillator phase accumulates differently and slowly drifts apart.
+ *
+ *    Changes only take effect at the next `bw_reverb_set_sample_rate()` call.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_reverb_set_profile_stats()
+ *  ```>>> */
+static inline void bw_reverb_set_profile_stats(
+	bw_reverb_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *             stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_reverb_process()` and
+ *    `bw_reverb_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_reverb_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_reverb_coeffs_is_valid(
@@ -373,6 +520,9 @@ struct bw_reverb_coeffs {
 	enum bw_reverb_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_delay_coeffs			predelay_coeffs;
@@ -424,12 +574,22 @@ struct bw_reverb_coeffs {
 	size_t				dr5;
 	size_t				dr6;
 	size_t				dr7;
+	size_t				block_len;
+	size_t				mod_period;
 
 	float				s;
+	size_t				dd1i;
+	size_t				dd3i;
+	float				dd1f;
+	float				dd3f;
+	float				dd_inc;
+	size_t				mod_count;
 	float				diff2;
 
 	// Parameters
 	float				predelay;
+	char				block_processing;
+	char				mod_ctrl_rate;
 };
 
 struct bw_reverb_state {
@@ -490,7 +650,12 @@ static inline void bw_reverb_init(
 	bw_one_pole_set_sticky_thresh(&coeffs->smooth_coeffs, 1e-6f);
 
 	coeffs->predelay = 0.f;
+	coeffs->block_processing = 0;
+	coeffs->mod_ctrl_rate = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_reverb_coeffs");
 	coeffs->state = bw_reverb_coeffs_state_init;
@@ -523,7 +688,8 @@ static inline void bw_reverb_set_sample_rate(
 	bw_delay_set_sample_rate(&coeffs->delay_d3_coeffs, sample_rate);
 	bw_delay_set_sample_rate(&coeffs->delay_d4_coeffs, sample_rate);
 	bw_gain_set_sample_rate(&coeffs->decay_coeffs, sample_rate);
-	bw_phase_gen_set_sample_rate(&coeffs->phase_gen_coeffs, sample_rate);
+	coeffs->mod_period = coeffs->mod_ctrl_rate ? 16 : 1;
+	bw_phase_gen_set_sample_rate(&coeffs->phase_gen_coeffs, sample_rate / (float)coeffs->mod_period);
 	bw_lp1_set_sample_rate(&coeffs->damping_coeffs, sample_rate);
 	bw_dry_wet_set_sample_rate(&coeffs->dry_wet_coeffs, sample_rate);
 	bw_one_pole_set_sample_rate(&coeffs->smooth_coeffs, sample_rate);
@@ -554,6 +720,10 @@ static inline void bw_reverb_set_sample_rate(
 	coeffs->dr5 = (size_t)bw_roundf(coeffs->fs * (2111.f / 29761.f));
 	coeffs->dr6 = (size_t)bw_roundf(coeffs->fs * (335.f / 29761.f));
 	coeffs->dr7 = (size_t)bw_roundf(coeffs->fs * (121.f / 29761.f));
+	// id2 and dr7 are the shortest delay and output tap, respectively
+	coeffs->block_len = coeffs->id2 + 1 < coeffs->dr7 ? coeffs->id2 + 1 : coeffs->dr7;
+	coeffs->block_len = coeffs->block_len < 32 ? coeffs->block_len : 32;
+	coeffs->block_len = coeffs->block_len >= 2 ? coeffs->block_len : 0;
 
 #ifdef BW_DEBUG_DEEP
 	coeffs->state = bw_reverb_coeffs_state_set_sample_rate;
@@ -583,6 +753,29 @@ static inline size_t bw_reverb_mem_req(
 		+ bw_delay_mem_req(&coeffs->delay_d4_coeffs);
 }
 
+static inline size_t bw_reverb_mem_req_max(
+		const bw_reverb_coeffs * BW_RESTRICT coeffs,
+		float                                max_sample_rate) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(max_sample_rate) && max_sample_rate > 0.f);
+
+	return bw_delay_mem_req_max(&coeffs->predelay_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_id1_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_id2_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_id3_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_id4_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_dd1_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_dd2_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_dd3_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_dd4_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_d1_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_d2_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_d3_coeffs, max_sample_rate)
+		+ bw_delay_mem_req_max(&coeffs->delay_d4_coeffs, max_sample_rate);
+}
+
 static inline void bw_reverb_mem_set(
 		const bw_reverb_coeffs * BW_RESTRICT coeffs,
 		bw_reverb_state * BW_RESTRICT        state,
@@ -630,6 +823,33 @@ static inline void bw_reverb_mem_set(
 	BW_ASSERT_DEEP(state->state == bw_reverb_state_state_mem_set);
 }
 
+static inline void bw_reverb_do_update_mod_delays(
+		bw_reverb_coeffs * BW_RESTRICT coeffs) {
+	float dd1if, dd3if;
+	bw_intfracf(coeffs->fs * ((672.f / 29761.f) + coeffs->s), &dd1if, &coeffs->dd1f);
+	bw_intfracf(coeffs->fs * ((908.f / 29761.f) + coeffs->s), &dd3if, &coeffs->dd3f);
+	coeffs->dd1i = (size_t)dd1if;
+	coeffs->dd3i = (size_t)dd3if;
+}
+
+static inline void bw_reverb_do_step_mod_delay(
+		size_t * BW_RESTRICT di,
+		float * BW_RESTRICT  df,
+		float                inc) {
+	float f = *df + inc;
+	if (f >= 1.f) {
+		f -= 1.f;
+		(*di)++;
+	} else if (f < 0.f) {
+		f += 1.f;
+		if (f < 1.f)
+			(*di)--;
+		else
+			f = 0.f;
+	}
+	*df = f;
+}
+
 static inline void bw_reverb_reset_coeffs(
 		bw_reverb_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -655,6 +875,9 @@ static inline void bw_reverb_reset_coeffs(
 	float p, pi;
 	bw_phase_gen_reset_state(&coeffs->phase_gen_coeffs, &coeffs->phase_gen_state, 0.f, &p, &pi);
 	coeffs->s = (8.f / 29761.f) * bw_osc_sin_process1(p);
+	bw_reverb_do_update_mod_delays(coeffs);
+	coeffs->dd_inc = 0.f;
+	coeffs->mod_count = 0;
 	bw_lp1_reset_coeffs(&coeffs->damping_coeffs);
 	coeffs->diff2 = bw_clipf(bw_gain_get_gain_lin(&coeffs->decay_coeffs) + 0.15f, 0.25f, 0.5f);
 	bw_dry_wet_reset_coeffs(&coeffs->dry_wet_coeffs);
@@ -800,31 +1023,69 @@ static inline void bw_reverb_update_coeffs_ctrl(
 	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
 }
 
-static inline void bw_reverb_update_coeffs_audio(
+// predelay and bandwidth
+static inline void bw_reverb_do_update_coeffs_audio_input(
 		bw_reverb_coeffs * BW_RESTRICT coeffs) {
-	BW_ASSERT(coeffs != BW_NULL);
-	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
-	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
-
 	bw_delay_update_coeffs_audio(&coeffs->predelay_coeffs);
 	bw_lp1_update_coeffs_audio(&coeffs->bandwidth_coeffs);
 	const float pd = bw_one_pole_process1_sticky_abs(&coeffs->smooth_coeffs, &coeffs->smooth_predelay_state, coeffs->predelay);
 	bw_delay_set_delay(&coeffs->predelay_coeffs, pd);
 	bw_delay_update_coeffs_ctrl(&coeffs->predelay_coeffs);
 	bw_delay_update_coeffs_audio(&coeffs->predelay_coeffs);
+}
+
+// everything else, independent of the above
+static inline void bw_reverb_do_update_coeffs_audio_tank(
+		bw_reverb_coeffs * BW_RESTRICT coeffs) {
 	bw_gain_update_coeffs_audio(&coeffs->decay_coeffs);
-	bw_phase_gen_update_coeffs_audio(&coeffs->phase_gen_coeffs);
-	float p, pi;
-	bw_phase_gen_process1(&coeffs->phase_gen_coeffs, &coeffs->phase_gen_state, &p, &pi);
-	coeffs->s = (8.f / 29761.f) * bw_osc_sin_process1(p);
+	if (coeffs->mod_count == 0) {
+		const float s_prev = coeffs->s;
+		bw_phase_gen_update_coeffs_audio(&coeffs->phase_gen_coeffs);
+		float p, pi;
+		bw_phase_gen_process1(&coeffs->phase_gen_coeffs, &coeffs->phase_gen_state, &p, &pi);
+		coeffs->s = (8.f / 29761.f) * bw_osc_sin_process1(p);
+		if (coeffs->mod_period != 1) {
+			// ramp from previous to current value over mod_period samples
+			const float s = coeffs->s;
+			coeffs->s = s_prev;
+			bw_reverb_do_update_mod_delays(coeffs);
+			coeffs->s = s;
+			coeffs->dd_inc = coeffs->fs * (s - s_prev) / (float)coeffs->mod_period;
+		} else
+			bw_reverb_do_update_mod_delays(coeffs);
+	}
+	if (coeffs->mod_period != 1) {
+		bw_reverb_do_step_mod_delay(&coeffs->dd1i, &coeffs->dd1f, coeffs->dd_inc);
+		bw_reverb_do_step_mod_delay(&coeffs->dd3i, &coeffs->dd3f, coeffs->dd_inc);
+		coeffs->mod_count = coeffs->mod_count + 1 == coeffs->mod_period ? 0 : coeffs->mod_count + 1;
+	}
 	bw_lp1_update_coeffs_audio(&coeffs->damping_coeffs);
 	coeffs->diff2 = bw_clipf(bw_gain_get_gain_cur(&coeffs->decay_coeffs) + 0.15f, 0.25f, 0.5f);
 	bw_dry_wet_update_coeffs_audio(&coeffs->dry_wet_coeffs);
+}
+
+static inline void bw_reverb_update_coeffs_audio(
+		bw_reverb_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
+
+	bw_reverb_do_update_coeffs_audio_input(coeffs);
+	bw_reverb_do_update_coeffs_audio_tank(coeffs);
 
 	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
 }
 
+static inline float bw_reverb_do_flush_denormal(
+		float x) {
+#ifdef BW_FLUSH_DENORMALS
+	return bw_flush_denormal(x);
+#else
+	return x;
+#endif
+}
+
 static inline void bw_reverb_process1(
 		const bw_reverb_coeffs * BW_RESTRICT coeffs,
 		bw_reverb_state * BW_RESTRICT        state,
@@ -851,44 +1112,37 @@ static inline void bw_reverb_process1(
 	const float n14 = bw_delay_read(&coeffs->delay_id1_coeffs, &state->delay_id1_state, coeffs->id1, 0.f);
 	const float n13 = bw - 0.75f * n14;
 	const float id1 = n14 + 0.75f * n13;
-	bw_delay_write(&coeffs->delay_id1_coeffs, &state->delay_id1_state, n13);
+	bw_delay_write(&coeffs->delay_id1_coeffs, &state->delay_id1_state, bw_reverb_do_flush_denormal(n13));
 	const float n20 = bw_delay_read(&coeffs->delay_id2_coeffs, &state->delay_id2_state, coeffs->id2, 0.f);
 	const float n19 = id1 - 0.75f * n20;
 	const float id2 = n20 + 0.75f * n19;
-	bw_delay_write(&coeffs->delay_id2_coeffs, &state->delay_id2_state, n19);
+	bw_delay_write(&coeffs->delay_id2_coeffs, &state->delay_id2_state, bw_reverb_do_flush_denormal(n19));
 	const float n16 = bw_delay_read(&coeffs->delay_id3_coeffs, &state->delay_id3_state, coeffs->id3, 0.f);
 	const float n15 = id2 - 0.625f * n16;
 	const float id3 = n16 + 0.625f * n15;
-	bw_delay_write(&coeffs->delay_id3_coeffs, &state->delay_id3_state, n15);
+	bw_delay_write(&coeffs->delay_id3_coeffs, &state->delay_id3_state, bw_reverb_do_flush_denormal(n15));
 	const float n22 = bw_delay_read(&coeffs->delay_id4_coeffs, &state->delay_id4_state, coeffs->id4, 0.f);
 	const float n21 = id3 - 0.625f * n22;
 	const float id4 = n22 + 0.625f * n21;
-	bw_delay_write(&coeffs->delay_id4_coeffs, &state->delay_id4_state, n21);
+	bw_delay_write(&coeffs->delay_id4_coeffs, &state->delay_id4_state, bw_reverb_do_flush_denormal(n21));
 
 	const float n39 = bw_delay_read(&coeffs->delay_d2_coeffs, &state->delay_d2_state, coeffs->d2, 0.f);
 	const float n63 = bw_delay_read(&coeffs->delay_d4_coeffs, &state->delay_d4_state, coeffs->d4, 0.f);
 	const float s1 = id4 + bw_gain_process1(&coeffs->decay_coeffs, n63);
 	const float s2 = id4 + bw_gain_process1(&coeffs->decay_coeffs, n39);
 
-	float dd1if, dd1f;
-	bw_intfracf(coeffs->fs * ((672.f / 29761.f) + coeffs->s), &dd1if, &dd1f);
-	const size_t dd1i = (size_t)dd1if;
-	float dd3if, dd3f;
-	bw_intfracf(coeffs->fs * ((908.f / 29761.f) + coeffs->s), &dd3if, &dd3f);
-	const size_t dd3i = (size_t)dd3if;
-
-	const float n24 = bw_delay_read(&coeffs->delay_dd1_coeffs, &state->delay_dd1_state, dd1i, dd1f);
+	const float n24 = bw_delay_read(&coeffs->delay_dd1_coeffs, &state->delay_dd1_state, coeffs->dd1i, coeffs->dd1f);
 	const float n23 = s1 + 0.7f * n24;
 	const float dd1 = n24 - 0.7f * n23;
-	bw_delay_write(&coeffs->delay_dd1_coeffs, &state->delay_dd1_state, n23);
-	const float n48 = bw_delay_read(&coeffs->delay_dd3_coeffs, &state->delay_dd3_state, dd3i, dd3f);
+	bw_delay_write(&coeffs->delay_dd1_coeffs, &state->delay_dd1_state, bw_reverb_do_flush_denormal(n23));
+	const float n48 = bw_delay_read(&coeffs->delay_dd3_coeffs, &state->delay_dd3_state, coeffs->dd3i, coeffs->dd3f);
 	const float n46 = s2 + 0.7f * n48;
 	const float dd3 = n48 - 0.7f * n46;
-	bw_delay_write(&coeffs->delay_dd3_coeffs, &state->delay_dd3_state, n46);
+	bw_delay_write(&coeffs->delay_dd3_coeffs, &state->delay_dd3_state, bw_reverb_do_flush_denormal(n46));
 	const float n30 = bw_delay_read(&coeffs->delay_d1_coeffs, &state->delay_d1_state, coeffs->d1, 0.f);
-	bw_delay_write(&coeffs->delay_d1_coeffs, &state->delay_d1_state, dd1);
+	bw_delay_write(&coeffs->delay_d1_coeffs, &state->delay_d1_state, bw_reverb_do_flush_denormal(dd1));
 	const float n54 = bw_delay_read(&coeffs->delay_d3_coeffs, &state->delay_d3_state, coeffs->d3, 0.f);
-	bw_delay_write(&coeffs->delay_d3_coeffs, &state->delay_d3_state, dd3);
+	bw_delay_write(&coeffs->delay_d3_coeffs, &state->delay_d3_state, bw_reverb_do_flush_denormal(dd3));
 	const float damp1 = bw_lp1_process1(&coeffs->damping_coeffs, &state->damping_1_state, n30);
 	const float damp2 = bw_lp1_process1(&coeffs->damping_coeffs, &state->damping_2_state, n54);
 	const float decay1 = bw_gain_process1(&coeffs->decay_coeffs, damp1);
@@ -896,13 +1150,13 @@ static inline void bw_reverb_process1(
 	const float n33 = bw_delay_read(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, coeffs->dd2, 0.f);
 	const float n31 = decay1 - coeffs->diff2 * n33;
 	const float dd2 = n33 + coeffs->diff2 * n31;
-	bw_delay_write(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, n31);
+	bw_delay_write(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, bw_reverb_do_flush_denormal(n31));
 	const float n59 = bw_delay_read(&coeffs->delay_dd4_coeffs, &state->delay_dd4_state, coeffs->dd4, 0.f);
 	const float n55 = decay2 - coeffs->diff2 * n59;
 	const float dd4 = n59 + coeffs->diff2 * n55;
-	bw_delay_write(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, n55);
-	bw_delay_write(&coeffs->delay_d2_coeffs, &state->delay_d2_state, dd2);
-	bw_delay_write(&coeffs->delay_d4_coeffs, &state->delay_d4_state, dd4);
+	bw_delay_write(&coeffs->delay_dd4_coeffs, &state->delay_dd4_state, bw_reverb_do_flush_denormal(n55));
+	bw_delay_write(&coeffs->delay_d2_coeffs, &state->delay_d2_state, bw_reverb_do_flush_denormal(dd2));
+	bw_delay_write(&coeffs->delay_d4_coeffs, &state->delay_d4_state, bw_reverb_do_flush_denormal(dd4));
 
 	*y_l = 0.6f * (
 			bw_delay_read(&coeffs->delay_d3_coeffs, &state->delay_d3_state, coeffs->dl1, 0.f)
@@ -933,6 +1187,125 @@ static inline void bw_reverb_process1(
 	BW_ASSERT(bw_is_finite(*y_r));
 }
 
+// allpass on a delay line, di >= n_samples - 1
+static inline void bw_reverb_do_diffuse_block(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		bw_delay_state * BW_RESTRICT        state,
+		size_t                              di,
+		float                               g,
+		float * BW_RESTRICT                 x,
+		size_t                              n_samples) {
+	float r[32], w[32];
+	bw_delay_read_block(coeffs, state, di - (n_samples - 1), 0.f, r, n_samples);
+	for (size_t i = 0; i < n_samples; i++) {
+		const float v = x[i] - g * r[i];
+		x[i] = r[i] + g * v;
+		w[i] = bw_reverb_do_flush_denormal(v);
+	}
+	bw_delay_write_block(coeffs, state, w, n_samples);
+}
+
+// output tap as read after the writes of the current block, di >= n_samples
+static inline void bw_reverb_do_tap_block(
+		const bw_delay_coeffs * BW_RESTRICT coeffs,
+		const bw_delay_state * BW_RESTRICT  state,
+		size_t                              di,
+		float                               sign,
+		float * BW_RESTRICT                 y,
+		size_t                              n_samples) {
+	float r[32];
+	bw_delay_read_block(coeffs, state, di - n_samples, 0.f, r, n_samples);
+	for (size_t i = 0; i < n_samples; i++)
+		y[i] += sign * r[i];
+}
+
+// Same as calling bw_reverb_update_coeffs_audio() and bw_reverb_process1()
+// n_samples <= coeffs->block_len times. All delay reads happen before writes,
+// which is possible since the block is shorter than any delay.
+static inline void bw_reverb_do_process_block(
+		bw_reverb_coeffs * BW_RESTRICT coeffs,
+		bw_reverb_state * BW_RESTRICT  state,
+		const float *                  x_l,
+		const float *                  x_r,
+		float *                        y_l,
+		float *                        y_r,
+		size_t                         n_samples) {
+	const size_t n1 = n_samples - 1;
+
+	float x[32];
+	for (size_t i = 0; i < n_samples; i++) {
+		bw_reverb_do_update_coeffs_audio_input(coeffs);
+		const float pd = bw_delay_process1(&coeffs->predelay_coeffs, &state->predelay_state, 0.5f * (x_l[i] + x_r[i]));
+		x[i] = bw_lp1_process1(&coeffs->bandwidth_coeffs, &state->bandwidth_state, pd);
+	}
+
+	bw_reverb_do_diffuse_block(&coeffs->delay_id1_coeffs, &state->delay_id1_state, coeffs->id1, 0.75f, x, n_samples);
+	bw_reverb_do_diffuse_block(&coeffs->delay_id2_coeffs, &state->delay_id2_state, coeffs->id2, 0.75f, x, n_samples);
+	bw_reverb_do_diffuse_block(&coeffs->delay_id3_coeffs, &state->delay_id3_state, coeffs->id3, 0.625f, x, n_samples);
+	bw_reverb_do_diffuse_block(&coeffs->delay_id4_coeffs, &state->delay_id4_state, coeffs->id4, 0.625f, x, n_samples);
+
+	// tank half 0: dd1 -> d1 -> damping_1 -> dd2 -> d2
+	// tank half 1: dd3 -> d3 -> damping_2 -> dd4 -> d4
+	float fb[2][32], dl[2][32], ap[2][32];
+	bw_delay_read_block(&coeffs->delay_d4_coeffs, &state->delay_d4_state, coeffs->d4 - n1, 0.f, fb[0], n_samples);
+	bw_delay_read_block(&coeffs->delay_d2_coeffs, &state->delay_d2_state, coeffs->d2 - n1, 0.f, fb[1], n_samples);
+	bw_delay_read_block(&coeffs->delay_d1_coeffs, &state->delay_d1_state, coeffs->d1 - n1, 0.f, dl[0], n_samples);
+	bw_delay_read_block(&coeffs->delay_d3_coeffs, &state->delay_d3_state, coeffs->d3 - n1, 0.f, dl[1], n_samples);
+	bw_delay_read_block(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, coeffs->dd2 - n1, 0.f, ap[0], n_samples);
+	bw_delay_read_block(&coeffs->delay_dd4_coeffs, &state->delay_dd4_state, coeffs->dd4 - n1, 0.f, ap[1], n_samples);
+
+	float o_l[32], o_r[32];
+	bw_delay_read_block(&coeffs->delay_d3_coeffs, &state->delay_d3_state, coeffs->dl1 - n_samples, 0.f, o_l, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d3_coeffs, &state->delay_d3_state, coeffs->dl2, 1.f, o_l, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_dd4_coeffs, &state->delay_dd4_state, coeffs->dl3, -1.f, o_l, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d4_coeffs, &state->delay_d4_state, coeffs->dl4, 1.f, o_l, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d1_coeffs, &state->delay_d1_state, coeffs->dl5, -1.f, o_l, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, coeffs->dl6, -1.f, o_l, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d2_coeffs, &state->delay_d2_state, coeffs->dl7, -1.f, o_l, n_samples);
+	bw_delay_read_block(&coeffs->delay_d1_coeffs, &state->delay_d1_state, coeffs->dr1 - n_samples, 0.f, o_r, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d1_coeffs, &state->delay_d1_state, coeffs->dr2, 1.f, o_r, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, coeffs->dr3, -1.f, o_r, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d2_coeffs, &state->delay_d2_state, coeffs->dr4, 1.f, o_r, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d3_coeffs, &state->delay_d3_state, coeffs->dr5, -1.f, o_r, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_dd4_coeffs, &state->delay_dd4_state, coeffs->dr6, -1.f, o_r, n_samples);
+	bw_reverb_do_tap_block(&coeffs->delay_d4_coeffs, &state->delay_d4_state, coeffs->dr7, -1.f, o_r, n_samples);
+
+	const bw_delay_coeffs * const dd_coeffs[2] = { &coeffs->delay_dd1_coeffs, &coeffs->delay_dd3_coeffs };
+	const bw_delay_state * const dd_state[2] = { &state->delay_dd1_state, &state->delay_dd3_state };
+	bw_lp1_state * const damping_state[2] = { &state->damping_1_state, &state->damping_2_state };
+	float dd_w[2][32], d_w[2][32], ap_w[2][32], o_w[2][32];
+	for (size_t i = 0; i < n_samples; i++) {
+		bw_reverb_do_update_coeffs_audio_tank(coeffs);
+		const size_t ddi[2] = { coeffs->dd1i, coeffs->dd3i };
+		const float ddf[2] = { coeffs->dd1f, coeffs->dd3f };
+		for (size_t j = 0; j < 2; j++) {
+			const float s = x[i] + bw_gain_process1(&coeffs->decay_coeffs, fb[j][i]);
+			const float r = bw_delay_read(dd_coeffs[j], dd_state[j], ddi[j] - i, ddf[j]);
+			const float v = s + 0.7f * r;
+			dd_w[j][i] = bw_reverb_do_flush_denormal(v);
+			d_w[j][i] = bw_reverb_do_flush_denormal(r - 0.7f * v);
+			const float damp = bw_lp1_process1(&coeffs->damping_coeffs, damping_state[j], dl[j][i]);
+			const float decay = bw_gain_process1(&coeffs->decay_coeffs, damp);
+			const float w = decay - coeffs->diff2 * ap[j][i];
+			ap_w[j][i] = bw_reverb_do_flush_denormal(w);
+			o_w[j][i] = bw_reverb_do_flush_denormal(ap[j][i] + coeffs->diff2 * w);
+		}
+		const float yl = bw_dry_wet_process1(&coeffs->dry_wet_coeffs, x_l[i], 0.6f * o_l[i]);
+		const float yr = bw_dry_wet_process1(&coeffs->dry_wet_coeffs, x_r[i], 0.6f * o_r[i]);
+		y_l[i] = yl;
+		y_r[i] = yr;
+	}
+
+	bw_delay_write_block(&coeffs->delay_dd1_coeffs, &state->delay_dd1_state, dd_w[0], n_samples);
+	bw_delay_write_block(&coeffs->delay_dd3_coeffs, &state->delay_dd3_state, dd_w[1], n_samples);
+	bw_delay_write_block(&coeffs->delay_d1_coeffs, &state->delay_d1_state, d_w[0], n_samples);
+	bw_delay_write_block(&coeffs->delay_d3_coeffs, &state->delay_d3_state, d_w[1], n_samples);
+	bw_delay_write_block(&coeffs->delay_dd2_coeffs, &state->delay_dd2_state, ap_w[0], n_samples);
+	bw_delay_write_block(&coeffs->delay_dd4_coeffs, &state->delay_dd4_state, ap_w[1], n_samples);
+	bw_delay_write_block(&coeffs->delay_d2_coeffs, &state->delay_d2_state, o_w[0], n_samples);
+	bw_delay_write_block(&coeffs->delay_d4_coeffs, &state->delay_d4_state, o_w[1], n_samples);
+}
+
 static inline void bw_reverb_process(
 		bw_reverb_coeffs * BW_RESTRICT coeffs,
 		bw_reverb_state * BW_RESTRICT  state,
@@ -955,11 +1328,24 @@ static inline void bw_reverb_process(
 	BW_ASSERT(y_r != BW_NULL);
 	BW_ASSERT(y_l != y_r);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_reverb_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_reverb_update_coeffs_audio(coeffs);
-		bw_reverb_process1(coeffs, state, x_l[i], x_r[i], y_l + i, y_r + i);
-	}
+	if (coeffs->block_processing && coeffs->block_len != 0 && n_samples >= 4)
+		for (size_t i = 0; i < n_samples; ) {
+			const size_t n = n_samples - i < coeffs->block_len ? n_samples - i : coeffs->block_len;
+			bw_reverb_do_process_block(coeffs, state, x_l + i, x_r + i, y_l + i, y_r + i, n);
+			i += n;
+		}
+	else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_reverb_update_coeffs_audio(coeffs);
+			bw_reverb_process1(coeffs, state, x_l[i], x_r[i], y_l + i, y_r + i);
+		}
+
+#ifdef BW_FLUSH_DENORMALS
+	bw_reverb_flush_denormals(coeffs, state);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
@@ -1003,12 +1389,32 @@ static inline void bw_reverb_process_multi(
 			BW_ASSERT(y_l[i] != y_r[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_reverb_update_coeffs_ctrl(coeffs);
-	for (size_t i = 0; i < n_samples; i++) {
-		bw_reverb_update_coeffs_audio(coeffs);
-		for (size_t j = 0; j < n_channels; j++)
-			bw_reverb_process1(coeffs, state[j], x_l[j][i], x_r[j][i], y_l[j] + i, y_r[j] + i);
-	}
+	if (coeffs->block_processing && coeffs->block_len != 0 && n_channels != 0 && n_samples >= 4)
+		for (size_t i = 0; i < n_samples; ) {
+			const size_t n = n_samples - i < coeffs->block_len ? n_samples - i : coeffs->block_len;
+			// coefficients evolve independently of states, hence each
+			// channel but the first can use its own copy
+			for (size_t j = 1; j < n_channels; j++) {
+				bw_reverb_coeffs c = *coeffs;
+				bw_reverb_do_process_block(&c, state[j], x_l[j] + i, x_r[j] + i, y_l[j] + i, y_r[j] + i, n);
+			}
+			bw_reverb_do_process_block(coeffs, state[0], x_l[0] + i, x_r[0] + i, y_l[0] + i, y_r[0] + i, n);
+			i += n;
+		}
+	else
+		for (size_t i = 0; i < n_samples; i++) {
+			bw_reverb_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++)
+				bw_reverb_process1(coeffs, state[j], x_l[j][i], x_r[j][i], y_l[j] + i, y_r[j] + i);
+		}
+
+#ifdef BW_FLUSH_DENORMALS
+	for (size_t i = 0; i < n_channels; i++)
+		bw_reverb_flush_denormals(coeffs, state[i]);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
@@ -1089,6 +1495,118 @@ static inline void bw_reverb_set_wet(
 	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
 }
 
+static inline void bw_reverb_flush_denormals(
+		const bw_reverb_coeffs * BW_RESTRICT coeffs,
+		bw_reverb_state * BW_RESTRICT        state) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_reverb_state_state_reset_state);
+
+	bw_lp1_flush_denormals(&coeffs->bandwidth_coeffs, &state->bandwidth_state);
+	bw_lp1_flush_denormals(&coeffs->damping_coeffs, &state->damping_1_state);
+	bw_lp1_flush_denormals(&coeffs->damping_coeffs, &state->damping_2_state);
+
+	BW_ASSERT_DEEP(bw_reverb_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_reverb_state_state_reset_state);
+}
+
+static inline void bw_reverb_set_lazy_reset(
+		bw_reverb_coeffs * BW_RESTRICT coeffs,
+		char                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+
+	bw_delay_set_lazy_reset(&coeffs->predelay_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_id1_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_id2_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_id3_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_id4_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_dd1_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_dd2_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_dd3_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_dd4_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_d1_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_d2_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_d3_coeffs, value);
+	bw_delay_set_lazy_reset(&coeffs->delay_d4_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+}
+
+static inline void bw_reverb_set_pow2_length(
+		bw_reverb_coeffs * BW_RESTRICT coeffs,
+		char                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+
+	bw_delay_set_pow2_length(&coeffs->predelay_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_id1_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_id2_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_id3_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_id4_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_dd1_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_dd2_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_dd3_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_dd4_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_d1_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_d2_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_d3_coeffs, value);
+	bw_delay_set_pow2_length(&coeffs->delay_d4_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+}
+
+static inline void bw_reverb_set_block_processing(
+		bw_reverb_coeffs * BW_RESTRICT coeffs,
+		char                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+
+	coeffs->block_processing = value;
+
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+}
+
+static inline void bw_reverb_set_mod_ctrl_rate(
+		bw_reverb_coeffs * BW_RESTRICT coeffs,
+		char                           value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+
+	coeffs->mod_ctrl_rate = value;
+
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+}
+
+static inline void bw_reverb_set_profile_stats(
+		bw_reverb_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *             stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_reverb_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_reverb_coeffs_state_init);
+}
+
 static inline char bw_reverb_coeffs_is_valid(
 		const bw_reverb_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -1119,6 +1637,12 @@ static inline char bw_reverb_coeffs_is_valid(
 	if (coeffs->state >= bw_reverb_coeffs_state_reset_coeffs) {
 		if (!bw_is_finite(coeffs->s) || coeffs->s < -8.f / 29761.f || coeffs->s > 8.f / 29761.f)
 			return 0;
+		if (!bw_is_finite(coeffs->dd1f) || coeffs->dd1f < 0.f || coeffs->dd1f >= 1.f)
+			return 0;
+		if (!bw_is_finite(coeffs->dd3f) || coeffs->dd3f < 0.f || coeffs->dd3f >= 1.f)
+			return 0;
+		if (coeffs->mod_count >= coeffs->mod_period)
+			return 0;
 		if (!bw_is_finite(coeffs->diff2) || coeffs->diff2 < 0.25f || coeffs->s > 0.5f)
 			return 0;
 
@@ -1188,6 +1712,7 @@ static inline char bw_reverb_state_is_valid(
 }
 
 #include <array>
+#include <bw_arena.h>
 
 namespace Brickworks {
 
@@ -1203,9 +1728,16 @@ public:
 
 	~Reverb();
 
-	void setSampleRate(
+	bool setSampleRate(
 		float sampleRate);
 
+	size_t getMemReq(
+		float sampleRate);
+
+	void setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size);
+
 	void reset(
 		float               xL0 = 0.f,
 		float               xR0 = 0.f,
@@ -1258,9 +1790,49 @@ public:
 
 	void setWet(
 		float value);
+
+	void setLazyReset(
+		bool value);
+
+	void setPow2Length(
+		bool value);
+
+	void setBlockProcessing(
+		bool value);
+
+	void setModCtrlRate(
+		bool value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
+ *
+ *    By default, `setSampleRate()` allocates the memory needed by all
+ *    channels, which is owned and later released by the object. It only
+ *    reallocates when the owned block is too small, hence going back to a
+ *    lower or previously used sample rate does not allocate. After
+ *    `setMemory()` is called, `setSampleRate()` uses the caller-owned
+ *    `memory` block of `size` bytes instead and never allocates, so that it
+ *    can be called from a realtime thread. Passing `nullptr` restores the
+ *    default behavior.
+ *
+ *    `setMemory()` only takes effect at the next successful `setSampleRate()`
+ *    call, until which the object keeps using its current memory. If the
+ *    object owned a memory block, such call releases it, hence, to avoid
+ *    deallocating on a realtime thread, either call `setMemory()` before
+ *    the first `setSampleRate()` or make the first `setSampleRate()` after
+ *    `setMemory()` on a non-realtime thread.
+ *
+ *    `setSampleRate()` returns `false` and leaves the object unchanged if
+ *    `size` is too small for the new sample rate, `true` otherwise.
+ *
+ *    `getMemReq()` returns the minimum `size` needed to use any sample rate
+ *    up to `sampleRate`.
+ *
+ *    In both cases, the memory of each channel is aligned to
+ *    `BW_ARENA_ALIGN` bytes (see [bw_arena](bw_arena)).
  *  }}} */
 
 /*** Implementation ***/
@@ -1273,6 +1845,9 @@ private:
 	bw_reverb_state			states[N_CHANNELS];
 	bw_reverb_state * BW_RESTRICT	statesP[N_CHANNELS];
 	void * BW_RESTRICT		mem;
+	size_t				memSize;
+	void * BW_RESTRICT		userMem;
+	size_t				userMemSize;
 };
 
 template<size_t N_CHANNELS>
@@ -1281,6 +1856,9 @@ inline Reverb<N_CHANNELS>::Reverb() {
 	for (size_t i = 0; i < N_CHANNELS; i++)
 		statesP[i] = states + i;
 	mem = nullptr;
+	memSize = 0;
+	userMem = nullptr;
+	userMemSize = 0;
 }
 
 template<size_t N_CHANNELS>
@@ -1290,16 +1868,59 @@ inline Reverb<N_CHANNELS>::~Reverb() {
 }
 
 template<size_t N_CHANNELS>
-inline void Reverb<N_CHANNELS>::setSampleRate(
+inline bool Reverb<N_CHANNELS>::setSampleRate(
 		float sampleRate) {
-	bw_reverb_set_sample_rate(&coeffs, sampleRate);
-	size_t req = bw_reverb_mem_req(&coeffs);
-	if (mem != nullptr)
+	bw_reverb_coeffs c = coeffs;
+	bw_reverb_set_sample_rate(&c, sampleRate);
+	const size_t req = bw_reverb_mem_req(&c);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	const size_t size = bw_arena_get_mem_req(&arena);
+	if (userMem != nullptr) {
+		if (size > userMemSize)
+			return false;
+		bw_arena_mem_set(&arena, userMem);
+	} else {
+		if (size > memSize) {
+			if (mem != nullptr)
+				operator delete(mem);
+			mem = operator new(size);
+			memSize = size;
+		}
+		bw_arena_mem_set(&arena, mem);
+	}
+	coeffs = c;
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_reverb_mem_set(&coeffs, states + i, bw_arena_alloc(&arena, req));
+	if (userMem != nullptr && mem != nullptr) {
+		// states do not point into the owned block anymore
 		operator delete(mem);
-	mem = operator new(req * N_CHANNELS);
-	void *m = mem;
-	for (size_t i = 0; i < N_CHANNELS; i++, m = static_cast<char *>(m) + req)
-		bw_reverb_mem_set(&coeffs, states + i, m);
+		mem = nullptr;
+		memSize = 0;
+	}
+	return true;
+}
+
+template<size_t N_CHANNELS>
+inline size_t Reverb<N_CHANNELS>::getMemReq(
+		float sampleRate) {
+	const size_t req = bw_reverb_mem_req_max(&coeffs, sampleRate);
+	bw_arena arena;
+	bw_arena_init(&arena);
+	for (size_t i = 0; i < N_CHANNELS; i++)
+		bw_arena_plan(&arena, req);
+	return bw_arena_get_mem_req(&arena);
+}
+
+template<size_t N_CHANNELS>
+inline void Reverb<N_CHANNELS>::setMemory(
+		void * BW_RESTRICT memory,
+		size_t             size) {
+	BW_ASSERT(memory != nullptr || size == 0);
+	userMem = memory;
+	userMemSize = size;
 }
 
 template<size_t N_CHANNELS>
@@ -1409,6 +2030,36 @@ inline void Reverb<N_CHANNELS>::setWet(
 	bw_reverb_set_wet(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Reverb<N_CHANNELS>::setLazyReset(
+		bool value) {
+	bw_reverb_set_lazy_reset(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Reverb<N_CHANNELS>::setPow2Length(
+		bool value) {
+	bw_reverb_set_pow2_length(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Reverb<N_CHANNELS>::setBlockProcessing(
+		bool value) {
+	bw_reverb_set_block_processing(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Reverb<N_CHANNELS>::setModCtrlRate(
+		bool value) {
+	bw_reverb_set_mod_ctrl_rate(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Reverb<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_reverb_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
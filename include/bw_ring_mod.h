@@ -20,15 +20,18 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Ring modulator with variable modulation amount.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_ring_mod_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -177,6 +180,19 @@ static inline void bw_ring_mod_set_amount(
  *
  *    Default value: `1.f`.
  *
+ *    #### bw_ring_mod_set_profile_stats()
+ *  ```>>> */
+static inline void bw_ring_mod_set_profile_stats(
+	bw_ring_mod_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *               stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_ring_mod_process()` and
+ *    `bw_ring_mod_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_ring_mod_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_ring_mod_coeffs_is_valid(
@@ -220,6 +236,9 @@ struct bw_ring_mod_coeffs {
 	uint32_t			hash;
 	enum bw_ring_mod_coeffs_state	state;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -237,6 +256,9 @@ static inline void bw_ring_mod_init(
 	bw_one_pole_set_tau(&coeffs->smooth_coeffs, 0.05f);
 	coeffs->mod_amount = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_ring_mod_coeffs");
 	coeffs->state = bw_ring_mod_coeffs_state_init;
@@ -334,10 +356,12 @@ static inline void bw_ring_mod_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x_car, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_ring_mod_update_coeffs_audio(coeffs);
 		y[i] = bw_ring_mod_process1(coeffs, x_mod[i], x_car[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_ring_mod_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ring_mod_coeffs_state_reset_coeffs);
@@ -363,11 +387,13 @@ static inline void bw_ring_mod_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_ring_mod_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_ring_mod_process1(coeffs, x_mod[j][i], x_car[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_ring_mod_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_ring_mod_coeffs_state_reset_coeffs);
@@ -388,6 +414,24 @@ static inline void bw_ring_mod_set_amount(
 	BW_ASSERT_DEEP(coeffs->state >= bw_ring_mod_coeffs_state_init);
 }
 
+static inline void bw_ring_mod_set_profile_stats(
+		bw_ring_mod_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *               stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_ring_mod_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ring_mod_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_ring_mod_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_ring_mod_coeffs_state_init);
+}
+
 static inline char bw_ring_mod_coeffs_is_valid(
 		const bw_ring_mod_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -448,6 +492,9 @@ public:
 		size_t                                nSamples);
 
 	void setAmount(float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -502,6 +549,12 @@ inline void RingMod<N_CHANNELS>::setAmount(
 	bw_ring_mod_set_amount(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void RingMod<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_ring_mod_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
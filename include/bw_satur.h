@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    Antialiased tanh-based saturation with parametric bias and gain
@@ -45,8 +45,13 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_satur_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_satur_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -236,6 +241,22 @@ static inline void bw_satur_process_multi(
  *    using and updating both the common `coeffs` and each of the `n_channels`
  *    `state`s (control and audio rate).
  *
+ *    #### bw_satur_process_interleaved()
+ *  ```>>> */
+static inline void bw_satur_process_interleaved(
+	bw_satur_coeffs * BW_RESTRICT                    coeffs,
+	bw_satur_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                    x,
+	float *                                          y,
+	size_t                                           n_channels,
+	size_t                                           n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved output buffer
+ *    `y`, both made of `n_channels` channels, while using and updating both
+ *    the common `coeffs` and each of the `n_channels` `state`s (control and
+ *    audio rate).
+ *
  *    #### bw_satur_set_bias()
  *  ```>>> */
 static inline void bw_satur_set_bias(
@@ -271,6 +292,20 @@ static inline void bw_satur_set_gain_compensation(
  *
  *    Default value: `0` (off).
  *
+ *    #### bw_satur_set_profile_stats()
+ *  ```>>> */
+static inline void bw_satur_set_profile_stats(
+	bw_satur_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *            stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_satur_process()`,
+ *    `bw_satur_process_multi()`, and `bw_satur_process_interleaved()` update
+ *    when using `coeffs` if `BW_PROFILE` is defined (see
+ *    [bw_common](bw_common)). If `stats` is `BW_NULL`, no profiling takes
+ *    place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_satur_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_satur_coeffs_is_valid(
@@ -331,6 +366,9 @@ struct bw_satur_coeffs {
 	enum bw_satur_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -376,6 +414,9 @@ static inline void bw_satur_init(
 	coeffs->gain = 1.f;
 	coeffs->gain_compensation = 0;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_satur_coeffs");
 	coeffs->state = bw_satur_coeffs_state_init;
@@ -580,6 +621,7 @@ static inline void bw_satur_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (coeffs->gain_compensation)
 		for (size_t i = 0; i < n_samples; i++) {
 			bw_satur_update_coeffs_audio(coeffs);
@@ -590,6 +632,7 @@ static inline void bw_satur_process(
 			bw_satur_update_coeffs_audio(coeffs);
 			y[i] = bw_satur_process1(coeffs, state, x[i]);
 		}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_satur_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_reset_coeffs);
@@ -621,15 +664,58 @@ static inline void bw_satur_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_satur_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_satur_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_satur_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
+	BW_ASSERT_DEEP(bw_satur_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_satur_process_interleaved(
+		bw_satur_coeffs * BW_RESTRICT                    coeffs,
+		bw_satur_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                    x,
+		float *                                          y,
+		size_t                                           n_channels,
+		size_t                                           n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_satur_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y != BW_NULL);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_satur_update_coeffs_ctrl(coeffs);
+	if (coeffs->gain_compensation)
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_satur_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				y[k] = bw_satur_process1_comp(coeffs, state[j], x[k]);
+		}
+	else
+		for (size_t i = 0, k = 0; i < n_frames; i++) {
+			bw_satur_update_coeffs_audio(coeffs);
+			for (size_t j = 0; j < n_channels; j++, k++)
+				y[k] = bw_satur_process1(coeffs, state[j], x[k]);
+		}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
 
 	BW_ASSERT_DEEP(bw_satur_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_channels * n_frames));
 }
 
 static inline void bw_satur_set_bias(
@@ -675,6 +761,24 @@ static inline void bw_satur_set_gain_compensation(
 	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_init);
 }
 
+static inline void bw_satur_set_profile_stats(
+		bw_satur_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *            stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_satur_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_satur_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_satur_coeffs_state_init);
+}
+
 static inline char bw_satur_coeffs_is_valid(
 		const bw_satur_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -775,6 +879,11 @@ public:
 		std::array<float *, N_CHANNELS>       y,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames);
+
 	void setBias(
 		float value);
 
@@ -783,6 +892,9 @@ public:
 
 	void setGainCompensation(
 		bool value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -863,6 +975,14 @@ inline void Satur<N_CHANNELS>::process(
 	process(x.data(), y.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void Satur<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       y,
+		size_t        nFrames) {
+	bw_satur_process_interleaved(&coeffs, statesP, x, y, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void Satur<N_CHANNELS>::setBias(
 		float value) {
@@ -881,6 +1001,12 @@ inline void Satur<N_CHANNELS>::setGainCompensation(
 	bw_satur_set_gain_compensation(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Satur<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_satur_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,15 +20,18 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    Slew-rate limiter with separate maximum increasing and decreasing rates.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_slew_lim_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -299,6 +302,19 @@ static inline float bw_slew_lim_get_y_z1(
 /*! <<<```
  *    Returns the last output sample as stored in `state`.
  *
+ *    #### bw_slew_lim_set_profile_stats()
+ *  ```>>> */
+static inline void bw_slew_lim_set_profile_stats(
+	bw_slew_lim_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *               stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_slew_lim_process()` and
+ *    `bw_slew_lim_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_slew_lim_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_slew_lim_coeffs_is_valid(
@@ -358,6 +374,9 @@ struct bw_slew_lim_coeffs {
 	enum bw_slew_lim_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	float				T;
@@ -387,6 +406,9 @@ static inline void bw_slew_lim_init(
 	coeffs->max_rate_up = INFINITY;
 	coeffs->max_rate_down = INFINITY;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_slew_lim_coeffs");
 	coeffs->state = bw_slew_lim_coeffs_state_init;
@@ -616,6 +638,7 @@ static inline void bw_slew_lim_process(
 	BW_ASSERT(x != BW_NULL);
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_slew_lim_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL) {
 		if (coeffs->max_rate_up != INFINITY) {
@@ -651,6 +674,7 @@ static inline void bw_slew_lim_process(
 				state->y_z1 = x[n_samples - 1];
 		}
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_slew_lim_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_slew_lim_coeffs_state_reset_coeffs);
@@ -682,6 +706,7 @@ static inline void bw_slew_lim_process_multi(
 				BW_ASSERT(y[i] == BW_NULL || y[j] == BW_NULL || y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_slew_lim_update_coeffs_ctrl(coeffs);
 	if (y != BW_NULL) {
 		if (coeffs->max_rate_up != INFINITY) {
@@ -753,6 +778,7 @@ static inline void bw_slew_lim_process_multi(
 				}
 		}
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_slew_lim_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_slew_lim_coeffs_state_reset_coeffs);
@@ -812,6 +838,24 @@ static inline float bw_slew_lim_get_y_z1(
 	return state->y_z1;
 }
 
+static inline void bw_slew_lim_set_profile_stats(
+		bw_slew_lim_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *               stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_slew_lim_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_slew_lim_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_slew_lim_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_slew_lim_coeffs_state_init);
+}
+
 static inline char bw_slew_lim_coeffs_is_valid(
 		const bw_slew_lim_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -920,6 +964,9 @@ public:
 
 	float getYZ1(
 		size_t channel);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -1024,6 +1071,12 @@ inline float SlewLim<N_CHANNELS>::getYZ1(
 	return bw_slew_lim_get_y_z1(states + channel);
 }
 
+template<size_t N_CHANNELS>
+inline void SlewLim<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_slew_lim_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
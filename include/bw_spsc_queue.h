@@ -0,0 +1,416 @@
+/*
+ * Brickworks
+ *
+ * Copyright (C) 2024 Orastron Srl unipersonale
+ *
+ * Brickworks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Brickworks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Brickworks.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File author: agent
+ */
+
+/*!
+ *  module_type {{{ utility }}}
+ *  version {{{ 1.1.0 }}}
+ *  requires {{{ bw_common }}}
+ *  description {{{
+ *    Wait-free single-producer/single-consumer message queue, meant to pass
+ *    note events and parameter changes from a user interface or MIDI thread
+ *    to the audio thread without locks.
+ *
+ *    Exactly one thread (the producer) may push messages and exactly one
+ *    thread (the consumer) may pop them at any given time. Neither operation
+ *    ever blocks or allocates: pushing to a full queue and popping from an
+ *    empty queue simply fail.
+ *
+ *    Indices owned by the producer and by the consumer are kept on separate
+ *    cache lines to avoid false sharing.
+ *
+ *    Typical consumer code, at the beginning of each audio block:
+ *
+ *    ```
+ *    bw_spsc_queue_msg msg;
+ *    while (bw_spsc_queue_pop(&queue, &msg))
+ *        switch (msg.type) {
+ *        case bw_spsc_queue_type_note_on:
+ *            bw_note_queue_add(&note_queue, msg.index, 1, msg.value, 0);
+ *            break;
+ *        case bw_spsc_queue_type_note_off:
+ *            bw_note_queue_add(&note_queue, msg.index, 0, 0.f, 0);
+ *            break;
+ *        case bw_spsc_queue_type_parameter:
+ *            set_parameter(msg.index, msg.value);
+ *            break;
+ *        default:
+ *            break;
+ *        }
+ *    ```
+ *
+ *    Memory ordering is implemented using GCC/Clang atomic builtins, MSVC
+ *    intrinsics, or C11 atomic fences, whichever is available. Otherwise
+ *    only volatile accesses are used, which is only safe when producer and
+ *    consumer run on the same core (e.g., main loop and audio interrupt on a
+ *    microcontroller).
+ *  }}}
+ *  changelog {{{
+ *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>First release.</li>
+ *        </ul>
+ *      </li>
+ *    </ul>
+ *  }}}
+ */
+
+#ifndef BW_SPSC_QUEUE_H
+#define BW_SPSC_QUEUE_H
+
+#include <bw_common.h>
+
+/*! ...
+ *
+ *    #### BW_SPSC_QUEUE_CAPACITY
+ *
+ *    `BW_SPSC_QUEUE_CAPACITY` is the maximum number of messages that a
+ *    `bw_spsc_queue` can hold. It must be a power of `2`.
+ *
+ *    If it is not defined already, then it gets defined as `256`.
+ *
+ *  >>> */
+#ifndef BW_SPSC_QUEUE_CAPACITY
+# define BW_SPSC_QUEUE_CAPACITY 256
+#endif
+/*! ...
+ *
+ *    #### BW_SPSC_QUEUE_CACHE_LINE
+ *
+ *    `BW_SPSC_QUEUE_CACHE_LINE` is the assumed cache line size (bytes), used
+ *    to keep producer and consumer indices apart.
+ *
+ *    If it is not defined already, then it gets defined as `64`.
+ *
+ *  >>> */
+#ifndef BW_SPSC_QUEUE_CACHE_LINE
+# define BW_SPSC_QUEUE_CACHE_LINE 64
+#endif
+
+#if (BW_SPSC_QUEUE_CAPACITY & (BW_SPSC_QUEUE_CAPACITY - 1)) != 0
+# error BW_SPSC_QUEUE_CAPACITY must be a power of 2
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*** Public API ***/
+
+/*! api {{{
+ *    #### bw_spsc_queue_type
+ *  ```>>> */
+typedef enum {
+	bw_spsc_queue_type_note_on,
+	bw_spsc_queue_type_note_off,
+	bw_spsc_queue_type_parameter,
+	bw_spsc_queue_type_pitch_bend,
+	bw_spsc_queue_type_mod_wheel
+} bw_spsc_queue_type;
+/*! <<<```
+ *    Message type:
+ *     * `bw_spsc_queue_type_note_on`: note on, `index` is the note number
+ *       and `value` is the velocity;
+ *     * `bw_spsc_queue_type_note_off`: note off, `index` is the note number
+ *       and `value` is the velocity;
+ *     * `bw_spsc_queue_type_parameter`: parameter change, `index` is the
+ *       parameter index and `value` is the new value;
+ *     * `bw_spsc_queue_type_pitch_bend`: pitch bend, `index` is unused and
+ *       `value` is the new pitch bend value;
+ *     * `bw_spsc_queue_type_mod_wheel`: modulation wheel, `index` is unused
+ *       and `value` is the new modulation wheel value.
+ *
+ *    The meaning and range of values is up to the user.
+ *
+ *    #### bw_spsc_queue_msg
+ *  ```>>> */
+typedef struct {
+	bw_spsc_queue_type type;
+	uint32_t           index;
+	float              value;
+} bw_spsc_queue_msg;
+/*! <<<```
+ *    Message:
+ *     * `type`: message type;
+ *     * `index`: note number or parameter index, depending on `type`;
+ *     * `value`: velocity or parameter value, depending on `type`.
+ *
+ *    #### bw_spsc_queue
+ *  ```>>> */
+typedef struct bw_spsc_queue bw_spsc_queue;
+/*! <<<```
+ *    Message queue object.
+ *
+ *    #### bw_spsc_queue_reset()
+ *  ```>>> */
+static inline void bw_spsc_queue_reset(
+	bw_spsc_queue * BW_RESTRICT queue);
+/*! <<<```
+ *    Empties `queue`.
+ *
+ *    This is not thread-safe: neither the producer nor the consumer must be
+ *    using `queue` at the same time.
+ *
+ *    #### bw_spsc_queue_push()
+ *  ```>>> */
+static inline char bw_spsc_queue_push(
+	bw_spsc_queue *    BW_RESTRICT queue,
+	bw_spsc_queue_type             type,
+	uint32_t                       index,
+	float                          value);
+/*! <<<```
+ *    Appends a message with the given `type`, `index`, and `value` to
+ *    `queue` and returns non-`0` on success or `0` if `queue` is full, in
+ *    which case the message is discarded.
+ *
+ *    Only to be called by the producer.
+ *
+ *    #### bw_spsc_queue_pop()
+ *  ```>>> */
+static inline char bw_spsc_queue_pop(
+	bw_spsc_queue *     BW_RESTRICT queue,
+	bw_spsc_queue_msg * BW_RESTRICT msg);
+/*! <<<```
+ *    Removes the oldest message from `queue`, copies it into `msg`, and
+ *    returns non-`0`, or returns `0` if `queue` is empty.
+ *
+ *    Only to be called by the consumer.
+ *
+ *    #### bw_spsc_queue_is_valid()
+ *  ```>>> */
+static inline char bw_spsc_queue_is_valid(
+	const bw_spsc_queue * BW_RESTRICT queue);
+/*! <<<```
+ *    Tries to determine whether `queue` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    `queue` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_spsc_queue`.
+ *  }}} */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+#if defined(__GNUC__) || defined(__clang__)
+# define BW_SPSC_QUEUE_ATOMICS_GNUC
+#elif defined(_MSC_VER)
+# include <intrin.h>
+# define BW_SPSC_QUEUE_ATOMICS_MSVC
+#elif !defined(__cplusplus) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+# include <stdatomic.h>
+# define BW_SPSC_QUEUE_ATOMICS_C11
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// indices are free-running and wrap around at 2^32
+struct bw_spsc_queue {
+	char              pad_front[BW_SPSC_QUEUE_CACHE_LINE];
+
+	// producer side
+	uint32_t          write_index;
+	uint32_t          read_index_cache;
+	char              pad_producer[BW_SPSC_QUEUE_CACHE_LINE - 2 * sizeof(uint32_t)];
+
+	// consumer side
+	uint32_t          read_index;
+	uint32_t          write_index_cache;
+	char              pad_consumer[BW_SPSC_QUEUE_CACHE_LINE - 2 * sizeof(uint32_t)];
+
+	bw_spsc_queue_msg msgs[BW_SPSC_QUEUE_CAPACITY];
+};
+
+static inline uint32_t bw_spsc_queue_load_acquire(
+		const uint32_t * BW_RESTRICT p) {
+#if defined(BW_SPSC_QUEUE_ATOMICS_GNUC)
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#elif defined(BW_SPSC_QUEUE_ATOMICS_MSVC)
+	const uint32_t v = *(const volatile uint32_t *)p;
+# if defined(_M_ARM) || defined(_M_ARM64)
+	__dmb(0xb); // ISH
+# else
+	_ReadWriteBarrier();
+# endif
+	return v;
+#elif defined(BW_SPSC_QUEUE_ATOMICS_C11)
+	const uint32_t v = *(const volatile uint32_t *)p;
+	atomic_thread_fence(memory_order_acquire);
+	return v;
+#else
+	return *(const volatile uint32_t *)p;
+#endif
+}
+
+static inline void bw_spsc_queue_store_release(
+		uint32_t * BW_RESTRICT p,
+		uint32_t               v) {
+#if defined(BW_SPSC_QUEUE_ATOMICS_GNUC)
+	__atomic_store_n(p, v, __ATOMIC_RELEASE);
+#elif defined(BW_SPSC_QUEUE_ATOMICS_MSVC)
+# if defined(_M_ARM) || defined(_M_ARM64)
+	__dmb(0xb); // ISH
+# else
+	_ReadWriteBarrier();
+# endif
+	*(volatile uint32_t *)p = v;
+#elif defined(BW_SPSC_QUEUE_ATOMICS_C11)
+	atomic_thread_fence(memory_order_release);
+	*(volatile uint32_t *)p = v;
+#else
+	*(volatile uint32_t *)p = v;
+#endif
+}
+
+static inline void bw_spsc_queue_reset(
+		bw_spsc_queue * BW_RESTRICT queue) {
+	BW_ASSERT(queue != BW_NULL);
+
+	queue->write_index = 0;
+	queue->read_index_cache = 0;
+	queue->read_index = 0;
+	queue->write_index_cache = 0;
+
+	BW_ASSERT_DEEP(bw_spsc_queue_is_valid(queue));
+}
+
+static inline char bw_spsc_queue_push(
+		bw_spsc_queue *    BW_RESTRICT queue,
+		bw_spsc_queue_type             type,
+		uint32_t                       index,
+		float                          value) {
+	BW_ASSERT(queue != BW_NULL);
+	BW_ASSERT(type >= bw_spsc_queue_type_note_on && type <= bw_spsc_queue_type_mod_wheel);
+	BW_ASSERT(bw_is_finite(value));
+
+	const uint32_t w = queue->write_index;
+	if (w - queue->read_index_cache == BW_SPSC_QUEUE_CAPACITY) {
+		// only touch the consumer's cache line when the queue looks full
+		queue->read_index_cache = bw_spsc_queue_load_acquire(&queue->read_index);
+		if (w - queue->read_index_cache == BW_SPSC_QUEUE_CAPACITY)
+			return 0;
+	}
+	bw_spsc_queue_msg *msg = queue->msgs + (w & (BW_SPSC_QUEUE_CAPACITY - 1));
+	msg->type = type;
+	msg->index = index;
+	msg->value = value;
+	bw_spsc_queue_store_release(&queue->write_index, w + 1);
+	return 1;
+}
+
+static inline char bw_spsc_queue_pop(
+		bw_spsc_queue *     BW_RESTRICT queue,
+		bw_spsc_queue_msg * BW_RESTRICT msg) {
+	BW_ASSERT(queue != BW_NULL);
+	BW_ASSERT(msg != BW_NULL);
+
+	const uint32_t r = queue->read_index;
+	if (r == queue->write_index_cache) {
+		// only touch the producer's cache line when the queue looks empty
+		queue->write_index_cache = bw_spsc_queue_load_acquire(&queue->write_index);
+		if (r == queue->write_index_cache)
+			return 0;
+	}
+	*msg = queue->msgs[r & (BW_SPSC_QUEUE_CAPACITY - 1)];
+	bw_spsc_queue_store_release(&queue->read_index, r + 1);
+
+	BW_ASSERT(msg->type >= bw_spsc_queue_type_note_on && msg->type <= bw_spsc_queue_type_mod_wheel);
+	BW_ASSERT(bw_is_finite(msg->value));
+	return 1;
+}
+
+static inline char bw_spsc_queue_is_valid(
+		const bw_spsc_queue * BW_RESTRICT queue) {
+	BW_ASSERT(queue != BW_NULL);
+
+	// the other side may be running, hence the atomic loads
+	const uint32_t r = bw_spsc_queue_load_acquire(&queue->read_index);
+	const uint32_t w = bw_spsc_queue_load_acquire(&queue->write_index);
+	return w - r <= BW_SPSC_QUEUE_CAPACITY;
+}
+
+#ifdef __cplusplus
+}
+
+/*** Public C++ API ***/
+
+namespace Brickworks {
+
+/*! api_cpp {{{
+ *    ##### Brickworks::SPSCQueue
+ *  ```>>> */
+class SPSCQueue {
+public:
+	SPSCQueue();
+
+	void reset();
+
+	bool push(
+		bw_spsc_queue_type type,
+		uint32_t           index,
+		float              value);
+
+	bool pop(
+		bw_spsc_queue_msg & msg);
+
+	bw_spsc_queue queue;
+};
+/*! <<<```
+ *    `push()` must only be called by the producer and `pop()` by the
+ *    consumer.
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+inline SPSCQueue::SPSCQueue() {
+	bw_spsc_queue_reset(&queue);
+}
+
+inline void SPSCQueue::reset() {
+	bw_spsc_queue_reset(&queue);
+}
+
+inline bool SPSCQueue::push(
+		bw_spsc_queue_type type,
+		uint32_t           index,
+		float              value) {
+	return bw_spsc_queue_push(&queue, type, index, value);
+}
+
+inline bool SPSCQueue::pop(
+		bw_spsc_queue_msg & msg) {
+	return bw_spsc_queue_pop(&queue, &msg);
+}
+
+}
+#endif
+
+#endif
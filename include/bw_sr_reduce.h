@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    Sample rate reducer.
@@ -31,8 +31,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_sr_reduce_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -223,6 +226,19 @@ static inline void bw_sr_reduce_set_ratio(
  *
  *    Default value: `1.f`.
  *
+ *    #### bw_sr_reduce_set_profile_stats()
+ *  ```>>> */
+static inline void bw_sr_reduce_set_profile_stats(
+	bw_sr_reduce_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_sr_reduce_process()` and
+ *    `bw_sr_reduce_process_multi()` update when using `coeffs` if `BW_PROFILE`
+ *    is defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
 *    #### bw_sr_reduce_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_sr_reduce_coeffs_is_valid(
@@ -282,6 +298,9 @@ struct bw_sr_reduce_coeffs {
 	enum bw_sr_reduce_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Parameters
 	float				ratio;
@@ -304,6 +323,9 @@ static inline void bw_sr_reduce_init(
 
 	coeffs->ratio = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_sr_reduce_coeffs");
 	coeffs->state = bw_sr_reduce_coeffs_state_init;
@@ -462,8 +484,10 @@ static inline void bw_sr_reduce_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_samples; i++)
 		y[i] = bw_sr_reduce_process1(coeffs, state, x[i]);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_sr_reduce_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_sr_reduce_coeffs_state_reset_coeffs);
@@ -495,8 +519,10 @@ static inline void bw_sr_reduce_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_channels; i++)
 		bw_sr_reduce_process(coeffs, state[i], x[i], y[i], n_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_sr_reduce_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_sr_reduce_coeffs_state_reset_coeffs);
@@ -517,6 +543,24 @@ static inline void bw_sr_reduce_set_ratio(
 	BW_ASSERT_DEEP(coeffs->state >= bw_sr_reduce_coeffs_state_init);
 }
 
+static inline void bw_sr_reduce_set_profile_stats(
+		bw_sr_reduce_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_sr_reduce_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_sr_reduce_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_sr_reduce_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_sr_reduce_coeffs_state_init);
+}
+
 static inline char bw_sr_reduce_coeffs_is_valid(
 		const bw_sr_reduce_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -597,6 +641,9 @@ public:
 
 	void setRatio(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -682,6 +729,12 @@ inline void SRReduce<N_CHANNELS>::setRatio(float value) {
 	bw_sr_reduce_set_ratio(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void SRReduce<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_sr_reduce_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,16 +20,21 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    Aribtrary-ratio IIR sample rate converter.
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_src_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
+ *          <li>Fixed C++ <code>process()</code> passing <code>coeffs</code>
+ *              by value.</li>
  *        </ul>
  *      </li>
  *      <li>Version <strong>1.0.0</strong>:
@@ -183,6 +188,19 @@ static inline void bw_src_process_multi(
  *    `n_in_samples` and `n_out_samples` must point to non-overlapping memory
  *    areas.
  *
+ *    #### bw_src_set_profile_stats()
+ *  ```>>> */
+static inline void bw_src_set_profile_stats(
+	bw_src_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_src_process()` and
+ *    `bw_src_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_src_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_src_coeffs_is_valid(
@@ -232,6 +250,9 @@ struct bw_src_coeffs {
 	uint32_t	hash;
 	uint32_t	reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *	profile_stats;
+#endif
 
 	// Coefficients
 	float		k;
@@ -277,6 +298,9 @@ static inline void bw_src_init(
 	coeffs->ma3 = k * (T * (T2 * (5.226251859505504f - 4.f * T) - 5.226251859505504f) + 4.f);
 	coeffs->ma4 = k * (T * (T * ((2.613125929752753f - T) * T - 3.414213562373095f) + 2.613125929752753f) - 1.f);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_src_coeffs");
 	coeffs->reset_id = coeffs->hash + 1;
@@ -370,6 +394,7 @@ static inline void bw_src_process(
 	BW_ASSERT(y != BW_NULL);
 	BW_ASSERT(x != y);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	size_t i = 0;
 	size_t j = 0;
 	if (coeffs->k < 0.f) {
@@ -435,6 +460,7 @@ static inline void bw_src_process(
 	}
 	*n_in_samples = i;
 	*n_out_samples = j;
+	BW_PROFILE_END(coeffs->profile_stats, *n_in_samples);
 
 	BW_ASSERT_DEEP(bw_src_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(bw_src_state_is_valid(coeffs, state));
@@ -472,8 +498,31 @@ static inline void bw_src_process_multi(
 	BW_ASSERT(n_out_samples != BW_NULL);
 	BW_ASSERT(n_in_samples != n_out_samples);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	for (size_t i = 0; i < n_channels; i++)
 		bw_src_process(coeffs, state[i], x[i], y[i], n_in_samples + i, n_out_samples + i);
+#ifdef BW_PROFILE
+	size_t n_profile = 0;
+	for (size_t i = 0; i < n_channels; i++)
+		n_profile += n_in_samples[i];
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_profile);
+
+	BW_ASSERT_DEEP(bw_src_coeffs_is_valid(coeffs));
+}
+
+static inline void bw_src_set_profile_stats(
+		bw_src_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_src_coeffs_is_valid(coeffs));
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
 
 	BW_ASSERT_DEEP(bw_src_coeffs_is_valid(coeffs));
 }
@@ -565,6 +614,9 @@ public:
 		std::array<float * BW_RESTRICT, N_CHANNELS>       y,
 		std::array<size_t, N_CHANNELS> &                  nInSamples,
 		std::array<size_t, N_CHANNELS> &                  nOutSamples);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -628,7 +680,7 @@ inline void SRC<N_CHANNELS>::process(
 		float * BW_RESTRICT const * BW_RESTRICT       y,
 		size_t * BW_RESTRICT                          nInSamples,
 		size_t * BW_RESTRICT                          nOutSamples) {
-	bw_src_process_multi(coeffs, statesP, x, y, N_CHANNELS, nInSamples, nOutSamples);
+	bw_src_process_multi(&coeffs, statesP, x, y, N_CHANNELS, nInSamples, nOutSamples);
 }
 
 template<size_t N_CHANNELS>
@@ -640,6 +692,12 @@ inline void SRC<N_CHANNELS>::process(
 	process(x.data(), y.data(), nInSamples.data(), nOutSamples.data());
 }
 
+template<size_t N_CHANNELS>
+inline void SRC<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_src_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
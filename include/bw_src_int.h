@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math }}}
  *  description {{{
  *    Integer-ratio IIR sample rate converter.
@@ -33,8 +33,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_src_int_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -191,6 +194,19 @@ static inline void bw_src_int_process_multi(
  *    `n_out_samples` is filled with the number of generated output samples for
  *    each output buffer, if not `BW_NULL`.
  *
+ *    #### bw_src_int_set_profile_stats()
+ *  ```>>> */
+static inline void bw_src_int_set_profile_stats(
+	bw_src_int_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *              stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_src_int_process()` and
+ *    `bw_src_int_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_src_int_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_src_int_coeffs_is_valid(
@@ -240,6 +256,9 @@ struct bw_src_int_coeffs {
 	uint32_t			hash;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Coefficients
 	int				ratio;
@@ -282,6 +301,9 @@ static inline void bw_src_int_init(
 	coeffs->ma3 = k * (T * (T2 * (5.226251859505504f - 4.f * T) - 5.226251859505504f) + 4.f);
 	coeffs->ma4 = k * (T * (T * ((2.613125929752753f - T) * T - 3.414213562373095f) + 2.613125929752753f) - 1.f);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_src_int_coeffs");
 	coeffs->reset_id = coeffs->hash + 1;
@@ -368,6 +390,7 @@ static inline size_t bw_src_int_process(
 	BW_ASSERT(y != BW_NULL);
 	BW_ASSERT(x != y);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	size_t n = 0;
 	if (coeffs->ratio < 0) {
 		for (size_t i = 0; i < n_in_samples; i++) {
@@ -409,6 +432,7 @@ static inline size_t bw_src_int_process(
 			}
 		}
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_in_samples);
 
 	BW_ASSERT_DEEP(bw_src_int_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(bw_src_int_state_is_valid(coeffs, state));
@@ -445,12 +469,30 @@ static inline void bw_src_int_process_multi(
 			BW_ASSERT((void *)x[i] != (void *)y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	if (n_out_samples != BW_NULL)
 		for (size_t i = 0; i < n_channels; i++)
 			n_out_samples[i] = bw_src_int_process(coeffs, state[i], x[i], y[i], n_in_samples);
 	else
 		for (size_t i = 0; i < n_channels; i++)
 			bw_src_int_process(coeffs, state[i], x[i], y[i], n_in_samples);
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_in_samples);
+
+	BW_ASSERT_DEEP(bw_src_int_coeffs_is_valid(coeffs));
+}
+
+static inline void bw_src_int_set_profile_stats(
+		bw_src_int_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *              stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_src_int_coeffs_is_valid(coeffs));
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
 
 	BW_ASSERT_DEEP(bw_src_int_coeffs_is_valid(coeffs));
 }
@@ -540,6 +582,9 @@ public:
 		std::array<float * BW_RESTRICT, N_CHANNELS>       y,
 		size_t                                            nInSamples,
 		std::array<size_t, N_CHANNELS> * BW_RESTRICT      nOutSamples = nullptr);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -615,6 +660,12 @@ inline void SRCInt<N_CHANNELS>::process(
 	process(x.data(), y.data(), nInSamples, nOutSamples ? nOutSamples->data() : nullptr);
 }
 
+template<size_t N_CHANNELS>
+inline void SRCInt<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_src_int_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole }}}
  *  description {{{
  *    State variable filter (2nd order, 12 dB/oct) model with separated lowpass,
@@ -28,8 +28,21 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_svf_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_svf_flush_denormals()</code> and support for
+ *              <code>BW_FLUSH_DENORMALS</code>.</li>
+ *          <li>Added <code>bw_svf_process_interleaved()</code> and
+ *              <code>processInterleaved()</code>.</li>
+ *          <li>Added <code>bw_svf_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code> to optionally interpolate
+ *              coefficients linearly between exact computations.</li>
+ *          <li><code>bw_svf_process()</code> and
+ *              <code>bw_svf_process_multi()</code> now use a faster code
+ *              path when parameter smoothing has settled.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -245,6 +258,27 @@ static inline void bw_svf_process_multi(
  * 
  *    `y_lp`, `y_bp`, and `y_hp`, or any of their elements may be `BW_NULL`.
  *
+ *    #### bw_svf_process_interleaved()
+ *  ```>>> */
+static inline void bw_svf_process_interleaved(
+	bw_svf_coeffs * BW_RESTRICT                    coeffs,
+	bw_svf_state * BW_RESTRICT const * BW_RESTRICT state,
+	const float *                                  x,
+	float *                                        y_lp,
+	float *                                        y_bp,
+	float *                                        y_hp,
+	size_t                                         n_channels,
+	size_t                                         n_frames);
+/*! <<<```
+ *    Processes the first `n_frames` frames of the interleaved input buffer `x`
+ *    and fills the first `n_frames` frames of the interleaved lowpass,
+ *    bandpass, and highpass output buffers `y_lp`, `y_bp`, and `y_hp`,
+ *    respectively, all made of `n_channels` channels, while using and updating
+ *    both the common `coeffs` and each of the `n_channels` `state`s (control
+ *    and audio rate).
+ *
+ *    `y_lp`, `y_bp`, and `y_hp` may be `BW_NULL`.
+ *
  *    #### bw_svf_set_cutoff()
  *  ```>>> */
 static inline void bw_svf_set_cutoff(
@@ -295,6 +329,60 @@ static inline void bw_svf_set_prewarp_freq(
  *
  *    Default value: `1e3f`.
  *
+ *    #### bw_svf_set_interp_period()
+ *  ```>>> */
+static inline void bw_svf_set_interp_period(
+	bw_svf_coeffs * BW_RESTRICT coeffs,
+	size_t                      value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    If `value` is `1`, coefficients are exactly computed at every sample.
+ *    Otherwise, while internal parameter smoothing is not settled, they are
+ *    exactly computed only once every `value` samples and linearly
+ *    interpolated in between, thus avoiding most tangent and reciprocal
+ *    computations. Parameter changes are then followed with up to
+ *    `value` - `1` samples of extra latency.
+ *
+ *    The interpolation error on each coefficient is bounded by `value`^2 / 8
+ *    times the maximum absolute second-order difference of its exactly
+ *    computed per-sample trajectory within the interpolation period. Given
+ *    the internal parameter smoothing (5 ms time constant), this is roughly
+ *    `value`^2 / (8 * (0.005 * sample_rate)^2) times the total coefficient
+ *    excursion after a parameter step (e.g., about 0.06% with `value` = `16`
+ *    at 48 kHz).
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_svf_flush_denormals()
+ *  ```>>> */
+static inline void bw_svf_flush_denormals(
+	const bw_svf_coeffs * BW_RESTRICT coeffs,
+	bw_svf_state * BW_RESTRICT        state);
+/*! <<<```
+ *    Sets the values in `state` whose absolute value is lower than 2^-80 to
+ *    `0.f` (see `bw_flush_denormal()`).
+ *
+ *    If `BW_FLUSH_DENORMALS` is defined, this is automatically called at the
+ *    end of `bw_svf_process()`, `bw_svf_process_multi()`, and
+ *    `bw_svf_process_interleaved()`.
+ *
+ *    #### bw_svf_set_profile_stats()
+ *  ```>>> */
+static inline void bw_svf_set_profile_stats(
+	bw_svf_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_svf_process()`,
+ *    `bw_svf_process_multi()`, and `bw_svf_process_interleaved()` update when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)). If
+ *    `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_svf_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_svf_coeffs_is_valid(
@@ -355,6 +443,9 @@ struct bw_svf_coeffs {
 	enum bw_svf_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_one_pole_coeffs		smooth_coeffs;
@@ -372,12 +463,31 @@ struct bw_svf_coeffs {
 	float				k;
 	float				hp_hb;
 	float				hp_x;
+	float				cutoff_cur;
+
+	float				interp_k;
+	size_t				interp_left;
+	float				kf_tgt;
+	float				kbl_tgt;
+	float				k_tgt;
+	float				hp_hb_tgt;
+	float				hp_x_tgt;
+	float				cutoff_tgt;
+	float				kf_inc;
+	float				kbl_inc;
+	float				k_inc;
+	float				hp_hb_inc;
+	float				hp_x_inc;
+	float				cutoff_inc;
+
+	char				settled;
 
 	// Parameters
 	float				cutoff;
 	float				Q;
 	float				prewarp_k;
 	float				prewarp_freq;
+	size_t				interp_period;
 };
 
 struct bw_svf_state {
@@ -404,7 +514,12 @@ static inline void bw_svf_init(
 	coeffs->Q = 0.5f;
 	coeffs->prewarp_freq = 1e3f;
 	coeffs->prewarp_k = 1.f;
+	coeffs->interp_period = 1;
+	coeffs->interp_k = 1.f;
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_svf_coeffs");
 	coeffs->state = bw_svf_coeffs_state_init;
@@ -434,9 +549,10 @@ static inline void bw_svf_set_sample_rate(
 	BW_ASSERT_DEEP(coeffs->state == bw_svf_coeffs_state_set_sample_rate);
 }
 
-static inline void bw_svf_do_update_coeffs(
+static inline char bw_svf_do_update_coeffs(
 		bw_svf_coeffs * BW_RESTRICT coeffs,
-		char                        force) {
+		char                        force,
+		size_t                      n_steps) {
 	const float prewarp_freq = coeffs->prewarp_freq + coeffs->prewarp_k * (coeffs->cutoff - coeffs->prewarp_freq);
 	float cutoff_cur = bw_one_pole_get_y_z1(&coeffs->smooth_cutoff_state);
 	float prewarp_freq_cur = bw_one_pole_get_y_z1(&coeffs->smooth_prewarp_freq_state);
@@ -446,10 +562,14 @@ static inline void bw_svf_do_update_coeffs(
 	const char Q_changed = force || coeffs->Q != Q_cur;
 	if (cutoff_changed || prewarp_freq_changed || Q_changed) {
 		if (cutoff_changed || prewarp_freq_changed) {
-			if (cutoff_changed)
-				cutoff_cur = bw_one_pole_process1_sticky_rel(&coeffs->smooth_coeffs, &coeffs->smooth_cutoff_state, coeffs->cutoff);
+			if (cutoff_changed) {
+				for (size_t i = 0; i < n_steps; i++)
+					cutoff_cur = bw_one_pole_process1_sticky_rel(&coeffs->smooth_coeffs, &coeffs->smooth_cutoff_state, coeffs->cutoff);
+				coeffs->cutoff_cur = cutoff_cur;
+			}
 			if (prewarp_freq_changed) {
-				prewarp_freq_cur = bw_one_pole_process1_sticky_rel(&coeffs->smooth_coeffs, &coeffs->smooth_prewarp_freq_state, prewarp_freq);
+				for (size_t i = 0; i < n_steps; i++)
+					prewarp_freq_cur = bw_one_pole_process1_sticky_rel(&coeffs->smooth_coeffs, &coeffs->smooth_prewarp_freq_state, prewarp_freq);
 				const float f = bw_minf(prewarp_freq_cur, coeffs->prewarp_freq_max);
 				coeffs->t = bw_tanf(coeffs->t_k * f);
 				coeffs->kf = coeffs->t * bw_rcpf(f);
@@ -457,12 +577,71 @@ static inline void bw_svf_do_update_coeffs(
 			coeffs->kbl = coeffs->kf * cutoff_cur;
 		}
 		if (Q_changed) {
-			Q_cur = bw_one_pole_process1_sticky_abs(&coeffs->smooth_coeffs, &coeffs->smooth_Q_state, coeffs->Q);
+			for (size_t i = 0; i < n_steps; i++)
+				Q_cur = bw_one_pole_process1_sticky_abs(&coeffs->smooth_coeffs, &coeffs->smooth_Q_state, coeffs->Q);
 			coeffs->k = bw_rcpf(Q_cur);
 		}
 		coeffs->hp_hb = coeffs->k + coeffs->kbl;
 		coeffs->hp_x = bw_rcpf(1.f + coeffs->kbl * coeffs->hp_hb);
+		return 1;
+	}
+	return 0;
+}
+
+static inline void bw_svf_do_update_coeffs_interp(
+		bw_svf_coeffs * BW_RESTRICT coeffs) {
+	if (coeffs->interp_left != 0) {
+		coeffs->interp_left--;
+		if (coeffs->interp_left == 0) {
+			coeffs->kf = coeffs->kf_tgt;
+			coeffs->kbl = coeffs->kbl_tgt;
+			coeffs->k = coeffs->k_tgt;
+			coeffs->hp_hb = coeffs->hp_hb_tgt;
+			coeffs->hp_x = coeffs->hp_x_tgt;
+			coeffs->cutoff_cur = coeffs->cutoff_tgt;
+		} else {
+			coeffs->kf += coeffs->kf_inc;
+			coeffs->kbl += coeffs->kbl_inc;
+			coeffs->k += coeffs->k_inc;
+			coeffs->hp_hb += coeffs->hp_hb_inc;
+			coeffs->hp_x += coeffs->hp_x_inc;
+			coeffs->cutoff_cur += coeffs->cutoff_inc;
+		}
+		return;
+	}
+	if (coeffs->interp_period == 1) {
+		bw_svf_do_update_coeffs(coeffs, 0, 1);
+		return;
 	}
+
+	// exact coefficients interp_period samples ahead, then ramp towards them
+	const float kf = coeffs->kf;
+	const float kbl = coeffs->kbl;
+	const float k = coeffs->k;
+	const float hp_hb = coeffs->hp_hb;
+	const float hp_x = coeffs->hp_x;
+	const float cutoff_cur = coeffs->cutoff_cur;
+	if (!bw_svf_do_update_coeffs(coeffs, 0, coeffs->interp_period))
+		return;
+	coeffs->kf_tgt = coeffs->kf;
+	coeffs->kbl_tgt = coeffs->kbl;
+	coeffs->k_tgt = coeffs->k;
+	coeffs->hp_hb_tgt = coeffs->hp_hb;
+	coeffs->hp_x_tgt = coeffs->hp_x;
+	coeffs->cutoff_tgt = coeffs->cutoff_cur;
+	coeffs->kf_inc = coeffs->interp_k * (coeffs->kf_tgt - kf);
+	coeffs->kbl_inc = coeffs->interp_k * (coeffs->kbl_tgt - kbl);
+	coeffs->k_inc = coeffs->interp_k * (coeffs->k_tgt - k);
+	coeffs->hp_hb_inc = coeffs->interp_k * (coeffs->hp_hb_tgt - hp_hb);
+	coeffs->hp_x_inc = coeffs->interp_k * (coeffs->hp_x_tgt - hp_x);
+	coeffs->cutoff_inc = coeffs->interp_k * (coeffs->cutoff_tgt - cutoff_cur);
+	coeffs->kf = kf + coeffs->kf_inc;
+	coeffs->kbl = kbl + coeffs->kbl_inc;
+	coeffs->k = k + coeffs->k_inc;
+	coeffs->hp_hb = hp_hb + coeffs->hp_hb_inc;
+	coeffs->hp_x = hp_x + coeffs->hp_x_inc;
+	coeffs->cutoff_cur = cutoff_cur + coeffs->cutoff_inc;
+	coeffs->interp_left = coeffs->interp_period - 1;
 }
 
 static inline void bw_svf_reset_coeffs(
@@ -474,7 +653,9 @@ static inline void bw_svf_reset_coeffs(
 	bw_one_pole_reset_state(&coeffs->smooth_coeffs, &coeffs->smooth_cutoff_state, coeffs->cutoff);
 	bw_one_pole_reset_state(&coeffs->smooth_coeffs, &coeffs->smooth_Q_state, coeffs->Q);
 	bw_one_pole_reset_state(&coeffs->smooth_coeffs, &coeffs->smooth_prewarp_freq_state, coeffs->prewarp_freq + coeffs->prewarp_k * (coeffs->cutoff - coeffs->prewarp_freq));
-	bw_svf_do_update_coeffs(coeffs, 1);
+	bw_svf_do_update_coeffs(coeffs, 1, 1);
+	coeffs->interp_left = 0;
+	coeffs->settled = 1;
 
 #ifdef BW_DEBUG_DEEP
 	coeffs->state = bw_svf_coeffs_state_reset_coeffs;
@@ -607,7 +788,15 @@ static inline void bw_svf_update_coeffs_ctrl(
 	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
 
-	(void)coeffs;
+	// once all smoothers have reached their targets and no interpolation is
+	// pending, update_coeffs_audio() is a no-op until a parameter is changed
+	coeffs->settled = coeffs->interp_left == 0
+		&& coeffs->cutoff == bw_one_pole_get_y_z1(&coeffs->smooth_cutoff_state)
+		&& coeffs->Q == bw_one_pole_get_y_z1(&coeffs->smooth_Q_state)
+		&& coeffs->prewarp_freq + coeffs->prewarp_k * (coeffs->cutoff - coeffs->prewarp_freq) == bw_one_pole_get_y_z1(&coeffs->smooth_prewarp_freq_state);
+
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
 }
 
 static inline void bw_svf_update_coeffs_audio(
@@ -616,7 +805,7 @@ static inline void bw_svf_update_coeffs_audio(
 	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
 
-	bw_svf_do_update_coeffs(coeffs, 0);
+	bw_svf_do_update_coeffs_interp(coeffs);
 
 	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
@@ -651,7 +840,7 @@ static inline void bw_svf_process1(
 	state->hp_z1 = *y_hp;
 	state->lp_z1 = *y_lp;
 	state->bp_z1 = *y_bp;
-	state->cutoff_z1 = bw_one_pole_get_y_z1(&coeffs->smooth_cutoff_state);
+	state->cutoff_z1 = coeffs->cutoff_cur;
 
 	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
@@ -661,6 +850,45 @@ static inline void bw_svf_process1(
 	BW_ASSERT(bw_is_finite(*y_hp));
 }
 
+static inline void bw_svf_do_process_settled(
+		const bw_svf_coeffs * BW_RESTRICT coeffs,
+		bw_svf_state * BW_RESTRICT        state,
+		const float *                     x,
+		float *                           y_lp,
+		float *                           y_bp,
+		float *                           y_hp,
+		size_t                            n_samples) {
+	// same as bw_svf_process1() with coefficients and state kept in locals
+	if (n_samples == 0)
+		return;
+	const float kk_cur = coeffs->kf * coeffs->cutoff_cur;
+	const float kbl = coeffs->kbl;
+	const float hp_hb = coeffs->hp_hb;
+	const float hp_x = coeffs->hp_x;
+	float kk = coeffs->kf * state->cutoff_z1;
+	float hp_z1 = state->hp_z1;
+	float lp_z1 = state->lp_z1;
+	float bp_z1 = state->bp_z1;
+	for (size_t i = 0; i < n_samples; i++) {
+		const float lp_xz1 = lp_z1 + kk * bp_z1;
+		const float bp_xz1 = bp_z1 + kk * hp_z1;
+		hp_z1 = hp_x * (x[i] - hp_hb * bp_xz1 - lp_xz1);
+		bp_z1 = bp_xz1 + kbl * hp_z1;
+		lp_z1 = lp_xz1 + kbl * bp_z1;
+		if (y_lp != BW_NULL)
+			y_lp[i] = lp_z1;
+		if (y_bp != BW_NULL)
+			y_bp[i] = bp_z1;
+		if (y_hp != BW_NULL)
+			y_hp[i] = hp_z1;
+		kk = kk_cur;
+	}
+	state->hp_z1 = hp_z1;
+	state->lp_z1 = lp_z1;
+	state->bp_z1 = bp_z1;
+	state->cutoff_z1 = coeffs->cutoff_cur;
+}
+
 static inline void bw_svf_process(
 		bw_svf_coeffs * BW_RESTRICT coeffs,
 		bw_svf_state * BW_RESTRICT  state,
@@ -680,7 +908,11 @@ static inline void bw_svf_process(
 	BW_ASSERT(y_lp == BW_NULL || y_hp == BW_NULL || y_lp != y_hp);
 	BW_ASSERT(y_bp == BW_NULL || y_hp == BW_NULL || y_bp != y_hp);
 
-	if (y_lp != BW_NULL) {
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_svf_update_coeffs_ctrl(coeffs);
+	if (coeffs->settled)
+		bw_svf_do_process_settled(coeffs, state, x, y_lp, y_bp, y_hp, n_samples);
+	else if (y_lp != BW_NULL) {
 		if (y_bp != BW_NULL) {
 			if (y_hp != BW_NULL) {
 				for (size_t i = 0; i < n_samples; i++) {
@@ -741,6 +973,11 @@ static inline void bw_svf_process(
 		}
 	}
 
+#ifdef BW_FLUSH_DENORMALS
+	bw_svf_flush_denormals(coeffs, state);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
+
 	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
 	BW_ASSERT_DEEP(bw_svf_state_is_valid(coeffs, state));
@@ -798,7 +1035,16 @@ static inline void bw_svf_process_multi(
 				BW_ASSERT(y_bp[i] == BW_NULL || y_hp[j] == BW_NULL || y_bp[i] != y_hp[j]);
 #endif
 
-	if (y_lp != BW_NULL) {
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_svf_update_coeffs_ctrl(coeffs);
+	if (coeffs->settled)
+		for (size_t i = 0; i < n_channels; i++)
+			bw_svf_do_process_settled(coeffs, state[i], x[i],
+				y_lp != BW_NULL ? y_lp[i] : BW_NULL,
+				y_bp != BW_NULL ? y_bp[i] : BW_NULL,
+				y_hp != BW_NULL ? y_hp[i] : BW_NULL,
+				n_samples);
+	else if (y_lp != BW_NULL) {
 		if (y_bp != BW_NULL) {
 			if (y_hp != BW_NULL) {
 				for (size_t i = 0; i < n_samples; i++) {
@@ -900,10 +1146,69 @@ static inline void bw_svf_process_multi(
 		}
 	}
 
+#ifdef BW_FLUSH_DENORMALS
+	for (size_t i = 0; i < n_channels; i++)
+		bw_svf_flush_denormals(coeffs, state[i]);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
+
 	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
 }
 
+static inline void bw_svf_process_interleaved(
+		bw_svf_coeffs * BW_RESTRICT                    coeffs,
+		bw_svf_state * BW_RESTRICT const * BW_RESTRICT state,
+		const float *                                  x,
+		float *                                        y_lp,
+		float *                                        y_bp,
+		float *                                        y_hp,
+		size_t                                         n_channels,
+		size_t                                         n_frames) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+#ifndef BW_NO_DEBUG
+	for (size_t i = 0; i < n_channels; i++)
+		for (size_t j = i + 1; j < n_channels; j++)
+			BW_ASSERT(state[i] != state[j]);
+#endif
+	BW_ASSERT(x != BW_NULL);
+	BW_ASSERT_DEEP(bw_has_only_finite(x, n_channels * n_frames));
+	BW_ASSERT(y_lp == BW_NULL || y_bp == BW_NULL || y_lp != y_bp);
+	BW_ASSERT(y_lp == BW_NULL || y_hp == BW_NULL || y_lp != y_hp);
+	BW_ASSERT(y_bp == BW_NULL || y_hp == BW_NULL || y_bp != y_hp);
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_svf_update_coeffs_ctrl(coeffs);
+	for (size_t i = 0, k = 0; i < n_frames; i++) {
+		bw_svf_update_coeffs_audio(coeffs);
+		for (size_t j = 0; j < n_channels; j++, k++) {
+			float v_lp, v_bp, v_hp;
+			bw_svf_process1(coeffs, state[j], x[k], &v_lp, &v_bp, &v_hp);
+			if (y_lp != BW_NULL)
+				y_lp[k] = v_lp;
+			if (y_bp != BW_NULL)
+				y_bp[k] = v_bp;
+			if (y_hp != BW_NULL)
+				y_hp[k] = v_hp;
+		}
+	}
+
+#ifdef BW_FLUSH_DENORMALS
+	for (size_t i = 0; i < n_channels; i++)
+		bw_svf_flush_denormals(coeffs, state[i]);
+#endif
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_frames);
+
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(y_lp != BW_NULL ? bw_has_only_finite(y_lp, n_channels * n_frames) : 1);
+	BW_ASSERT_DEEP(y_bp != BW_NULL ? bw_has_only_finite(y_bp, n_channels * n_frames) : 1);
+	BW_ASSERT_DEEP(y_hp != BW_NULL ? bw_has_only_finite(y_hp, n_channels * n_frames) : 1);
+}
+
 static inline void bw_svf_set_cutoff(
 		bw_svf_coeffs * BW_RESTRICT coeffs,
 		float                       value) {
@@ -962,6 +1267,56 @@ static inline void bw_svf_set_prewarp_freq(
 	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_init);
 }
 
+static inline void bw_svf_set_interp_period(
+		bw_svf_coeffs * BW_RESTRICT coeffs,
+		size_t                      value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	coeffs->interp_period = value;
+	coeffs->interp_k = bw_rcpf((float)value);
+
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_init);
+}
+
+static inline void bw_svf_flush_denormals(
+		const bw_svf_coeffs * BW_RESTRICT coeffs,
+		bw_svf_state * BW_RESTRICT        state) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_svf_state_is_valid(coeffs, state));
+
+	(void)coeffs;
+	state->hp_z1 = bw_flush_denormal(state->hp_z1);
+	state->lp_z1 = bw_flush_denormal(state->lp_z1);
+	state->bp_z1 = bw_flush_denormal(state->bp_z1);
+
+	BW_ASSERT_DEEP(bw_svf_state_is_valid(coeffs, state));
+}
+
+static inline void bw_svf_set_profile_stats(
+		bw_svf_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_svf_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_svf_coeffs_state_init);
+}
+
 static inline char bw_svf_coeffs_is_valid(
 		const bw_svf_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -981,6 +1336,8 @@ static inline char bw_svf_coeffs_is_valid(
 		return 0;
 	if (!bw_is_finite(coeffs->prewarp_freq) || coeffs->prewarp_freq < 1e-6f || coeffs->prewarp_freq > 1e12f)
 		return 0;
+	if (coeffs->interp_period < 1)
+		return 0;
 
 	if (!bw_one_pole_coeffs_is_valid(&coeffs->smooth_coeffs))
 		return 0;
@@ -1006,6 +1363,8 @@ static inline char bw_svf_coeffs_is_valid(
 			return 0;
 		if (!bw_is_finite(coeffs->hp_x) || coeffs->hp_x <= 0.f || coeffs->hp_x >= 1.f)
 			return 0;
+		if (!bw_is_finite(coeffs->cutoff_cur) || coeffs->cutoff_cur < 1e-6f || coeffs->cutoff_cur > 1e12f)
+			return 0;
 
 		if (!bw_one_pole_state_is_valid(&coeffs->smooth_coeffs, &coeffs->smooth_cutoff_state))
 			return 0;
@@ -1104,6 +1463,13 @@ public:
 		std::array<float *, N_CHANNELS>       yHp,
 		size_t                                nSamples);
 
+	void processInterleaved(
+		const float * x,
+		float *       yLp,
+		float *       yBp,
+		float *       yHp,
+		size_t        nFrames);
+
 	void setCutoff(
 		float value);
 
@@ -1115,6 +1481,12 @@ public:
 
 	void setPrewarpFreq(
 		float value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -1252,6 +1624,16 @@ inline void SVF<N_CHANNELS>::process(
 	process(x.data(), yLp.data(), yBp.data(), yHp.data(), nSamples);
 }
 
+template<size_t N_CHANNELS>
+inline void SVF<N_CHANNELS>::processInterleaved(
+		const float * x,
+		float *       yLp,
+		float *       yBp,
+		float *       yHp,
+		size_t        nFrames) {
+	bw_svf_process_interleaved(&coeffs, statesP, x, yLp, yBp, yHp, N_CHANNELS, nFrames);
+}
+
 template<size_t N_CHANNELS>
 inline void SVF<N_CHANNELS>::setCutoff(
 		float value) {
@@ -1276,6 +1658,18 @@ inline void SVF<N_CHANNELS>::setPrewarpFreq(
 	bw_svf_set_prewarp_freq(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void SVF<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_svf_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void SVF<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_svf_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{
  *    bw_common bw_math bw_one_pole bw_osc_sin bw_phase_gen bw_ring_mod
  *  }}}
@@ -29,8 +29,11 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_trem_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -227,6 +230,19 @@ static inline void bw_trem_set_amount(
  *
  *    Default value: `1.f`.
  *
+ *    #### bw_trem_set_profile_stats()
+ *  ```>>> */
+static inline void bw_trem_set_profile_stats(
+	bw_trem_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *           stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_trem_process()` and
+ *    `bw_trem_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_trem_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_trem_coeffs_is_valid(
@@ -288,6 +304,9 @@ struct bw_trem_coeffs {
 	enum bw_trem_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_phase_gen_coeffs		phase_gen_coeffs;
@@ -311,6 +330,9 @@ static inline void bw_trem_init(
 	bw_phase_gen_init(&coeffs->phase_gen_coeffs);
 	bw_ring_mod_init(&coeffs->ring_mod_coeffs);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_trem_coeffs");
 	coeffs->state = bw_trem_coeffs_state_init;
@@ -476,11 +498,13 @@ static inline void bw_trem_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_trem_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_trem_update_coeffs_audio(coeffs);
 		y[i] = bw_trem_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_trem_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_trem_coeffs_state_reset_coeffs);
@@ -512,12 +536,14 @@ static inline void bw_trem_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_trem_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_trem_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_trem_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_trem_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_trem_coeffs_state_reset_coeffs);
@@ -552,6 +578,24 @@ static inline void bw_trem_set_amount(
 	BW_ASSERT_DEEP(coeffs->state >= bw_trem_coeffs_state_init);
 }
 
+static inline void bw_trem_set_profile_stats(
+		bw_trem_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *           stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_trem_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_trem_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_trem_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_trem_coeffs_state_init);
+}
+
 static inline char bw_trem_coeffs_is_valid(
 		const bw_trem_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -633,6 +677,9 @@ public:
 
 	void setAmount(
 		float value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -725,6 +772,12 @@ inline void Trem<N_CHANNELS>::setAmount(
 	bw_trem_set_amount(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Trem<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_trem_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -20,13 +20,41 @@
 
 /*!
  *  module_type {{{ utility }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_note_queue }}}
  *  description {{{
  *    Basic voice allocator with low/high note priority.
+ *
+ *    Two flavors are available:
+ *     * `bw_voice_alloc()` queries voice status through callbacks every time
+ *       it is called, hence its cost grows with both the number of events and
+ *       the number of voices;
+ *     * `bw_voice_alloc_process()` keeps track of voice status in a
+ *       `bw_voice_alloc_state` by means of bitsets and a note-to-voice map,
+ *       so that each event takes constant time, but it needs to be told when
+ *       a voice becomes free via `bw_voice_alloc_set_voice_free()`.
+ *
+ *    Both implement the same allocation policy.
  *  }}}
  *  changelog {{{
  *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>Added <code>bw_voice_alloc_get_active()</code>.</li>
+ *          <li>Added <code>bw_voice_alloc_state</code>,
+ *              <code>BW_VOICE_ALLOC_MAX_VOICES</code>,
+ *              <code>bw_voice_alloc_reset_state()</code>,
+ *              <code>bw_voice_alloc_process()</code>,
+ *              <code>bw_voice_alloc_set_voice_free()</code>,
+ *              <code>bw_voice_alloc_is_voice_free()</code>,
+ *              <code>bw_voice_alloc_get_voice_note()</code>,
+ *              <code>bw_voice_alloc_get_active_voices()</code>, and
+ *              <code>bw_voice_alloc_state_is_valid()</code>.</li>
+ *          <li>Added C++ API.</li>
+ *          <li><code>bw_voice_alloc()</code> is now
+ *              <code>static inline</code>.</li>
+ *        </ul>
+ *      </li>
  *      <li>Version <strong>1.0.1</strong>:
  *        <ul>
  *          <li>Now using <code>BW_NULL</code>.</li>
@@ -68,6 +96,21 @@
 #include <bw_common.h>
 #include <bw_note_queue.h>
 
+/*! ...
+ *
+ *    #### BW_VOICE_ALLOC_MAX_VOICES
+ *
+ *    `BW_VOICE_ALLOC_MAX_VOICES` is the maximum number of voices that a
+ *    `bw_voice_alloc_state` can keep track of.
+ *
+ *    If it is not defined already, then it gets defined as `64`, so that
+ *    free voices fit in one 64-bit word.
+ *
+ *  >>> */
+#ifndef BW_VOICE_ALLOC_MAX_VOICES
+# define BW_VOICE_ALLOC_MAX_VOICES 64
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -123,7 +166,7 @@ typedef struct {
  *
  *    #### bw_voice_alloc()
  *  ```>>> */
-void bw_voice_alloc(
+static inline void bw_voice_alloc(
 	const bw_voice_alloc_opts * BW_RESTRICT opts,
 	bw_note_queue * BW_RESTRICT             queue,
 	void * BW_RESTRICT const * BW_RESTRICT  voices,
@@ -134,6 +177,122 @@ void bw_voice_alloc(
  *
  *    `voices` is the array of opaque voice pointers and `n_voices` indicates
  *    the number of elements in `voices`.
+ *
+ *    #### bw_voice_alloc_get_active()
+ *  ```>>> */
+static inline size_t bw_voice_alloc_get_active(
+	const bw_voice_alloc_opts * BW_RESTRICT opts,
+	void * BW_RESTRICT const * BW_RESTRICT  voices,
+	size_t                                  n_voices,
+	size_t * BW_RESTRICT                    active);
+/*! <<<```
+ *    Fills `active` with the indices of the voices in `voices` that are not
+ *    free according to `opts->is_free`, in increasing order, and returns
+ *    their number.
+ *
+ *    `voices` is the array of opaque voice pointers and `n_voices` indicates
+ *    the number of elements in `voices`. `active` must have room for
+ *    `n_voices` elements.
+ *
+ *    It is meant to be called after `bw_voice_alloc()`, so that pointers to
+ *    per-voice buffers and states can be gathered for active voices only and
+ *    passed to `*_process_multi()` functions along with the returned count,
+ *    hence free voices cost nothing. States of free voices are simply left
+ *    untouched until they are used again.
+ *
+ *    #### bw_voice_alloc_state
+ *  ```>>> */
+typedef struct bw_voice_alloc_state bw_voice_alloc_state;
+/*! <<<```
+ *    Voice allocation state, tracking which voices are free and which notes
+ *    are associated to busy voices.
+ *
+ *    #### bw_voice_alloc_reset_state()
+ *  ```>>> */
+static inline void bw_voice_alloc_reset_state(
+	bw_voice_alloc_state * BW_RESTRICT state,
+	size_t                             n_voices);
+/*! <<<```
+ *    Resets the given `state` so that it handles `n_voices` voices, all of
+ *    which are free.
+ *
+ *    `n_voices` must be in [`1`, `BW_VOICE_ALLOC_MAX_VOICES`].
+ *
+ *    #### bw_voice_alloc_process()
+ *  ```>>> */
+static inline void bw_voice_alloc_process(
+	const bw_voice_alloc_opts * BW_RESTRICT   opts,
+	bw_voice_alloc_state * BW_RESTRICT        state,
+	const bw_note_queue * BW_RESTRICT         queue,
+	void * BW_RESTRICT const * BW_RESTRICT    voices);
+/*! <<<```
+ *    It performs voice allocation according to `opts` and using the events in
+ *    `queue`, just like `bw_voice_alloc()`, but voice status is taken from and
+ *    updated in `state`, so that only the `note_on` and `note_off` callbacks
+ *    in `opts` are used (`get_note` and `is_free` can be `BW_NULL`) and
+ *    at most once per event.
+ *
+ *    `voices` is the array of opaque voice pointers, which must contain as
+ *    many elements as the number of voices `state` was reset with.
+ *
+ *    Voices that get a note on become busy and stay busy until
+ *    `bw_voice_alloc_set_voice_free()` is called on them.
+ *
+ *    #### bw_voice_alloc_set_voice_free()
+ *  ```>>> */
+static inline void bw_voice_alloc_set_voice_free(
+	bw_voice_alloc_state * BW_RESTRICT state,
+	size_t                             voice);
+/*! <<<```
+ *    Notifies `state` that the given `voice` is free (e.g., its envelope
+ *    reached the off phase after the note was released), so that it can be
+ *    used for new notes.
+ *
+ *    Calling it on an already free voice has no effect.
+ *
+ *    #### bw_voice_alloc_is_voice_free()
+ *  ```>>> */
+static inline char bw_voice_alloc_is_voice_free(
+	const bw_voice_alloc_state * BW_RESTRICT state,
+	size_t                                   voice);
+/*! <<<```
+ *    Returns whether the given `voice` is free (non-`0`) or not (`0`)
+ *    according to `state`.
+ *
+ *    #### bw_voice_alloc_get_voice_note()
+ *  ```>>> */
+static inline unsigned char bw_voice_alloc_get_voice_note(
+	const bw_voice_alloc_state * BW_RESTRICT state,
+	size_t                                   voice);
+/*! <<<```
+ *    Returns the note number last associated to the given `voice` in
+ *    `state`, or `0` if no note was ever associated to it since the last
+ *    reset.
+ *
+ *    #### bw_voice_alloc_get_active_voices()
+ *  ```>>> */
+static inline size_t bw_voice_alloc_get_active_voices(
+	const bw_voice_alloc_state * BW_RESTRICT state,
+	size_t * BW_RESTRICT                     active);
+/*! <<<```
+ *    Fills `active` with the indices of busy voices according to `state`, in
+ *    increasing order, and returns their number.
+ *
+ *    `active` must have room for as many elements as the number of voices
+ *    `state` was reset with. The cost is proportional to the number of busy
+ *    voices.
+ *
+ *    #### bw_voice_alloc_state_is_valid()
+ *  ```>>> */
+static inline char bw_voice_alloc_state_is_valid(
+	const bw_voice_alloc_state * BW_RESTRICT state);
+/*! <<<```
+ *    Tries to determine whether `state` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    `state` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_voice_alloc_state`.
  *  }}} */
 
 #ifdef __cplusplus
@@ -149,7 +308,7 @@ void bw_voice_alloc(
 extern "C" {
 #endif
 
-void bw_voice_alloc(
+static inline void bw_voice_alloc(
 		const bw_voice_alloc_opts * BW_RESTRICT opts,
 		bw_note_queue * BW_RESTRICT             queue,
 		void * BW_RESTRICT const * BW_RESTRICT  voices,
@@ -209,7 +368,443 @@ void bw_voice_alloc(
 	}
 }
 
+static inline size_t bw_voice_alloc_get_active(
+		const bw_voice_alloc_opts * BW_RESTRICT opts,
+		void * BW_RESTRICT const * BW_RESTRICT  voices,
+		size_t                                  n_voices,
+		size_t * BW_RESTRICT                    active) {
+	BW_ASSERT(opts != BW_NULL);
+	BW_ASSERT(n_voices == 0 || opts->is_free != BW_NULL);
+	BW_ASSERT(n_voices == 0 || voices != BW_NULL);
+	BW_ASSERT(n_voices == 0 || active != BW_NULL);
+
+	size_t n = 0;
+	for (size_t i = 0; i < n_voices; i++)
+		if (!opts->is_free(voices[i])) {
+			active[n] = i;
+			n++;
+		}
+	return n;
+}
+
+#define BW_VOICE_ALLOC_N_WORDS	((BW_VOICE_ALLOC_MAX_VOICES + 63) >> 6)
+
+struct bw_voice_alloc_state {
+#ifdef BW_DEBUG_DEEP
+	uint32_t	hash;
+#endif
+
+	// voices: bit set = free
+	uint64_t	free[BW_VOICE_ALLOC_N_WORDS];
+	size_t		n_voices;
+	unsigned char	voice_note[BW_VOICE_ALLOC_MAX_VOICES];
+
+	// notes: bit set = associated to a busy voice, which is note_voice[note]
+	uint64_t	busy_notes[2];
+	size_t		note_voice[128];
+};
+
+// index of lowest/highest set bit, x != 0
+static inline size_t bw_voice_alloc_lsb(
+		uint64_t x) {
+#if defined(__GNUC__)
+	return (size_t)__builtin_ctzll(x);
+#else
+	size_t i = 0;
+	if (!(x & 0xffffffffu)) { x >>= 32; i += 32; }
+	if (!(x & 0xffffu)) { x >>= 16; i += 16; }
+	if (!(x & 0xffu)) { x >>= 8; i += 8; }
+	if (!(x & 0xfu)) { x >>= 4; i += 4; }
+	if (!(x & 0x3u)) { x >>= 2; i += 2; }
+	if (!(x & 0x1u)) i += 1;
+	return i;
+#endif
+}
+
+static inline size_t bw_voice_alloc_msb(
+		uint64_t x) {
+#if defined(__GNUC__)
+	return 63 - (size_t)__builtin_clzll(x);
+#else
+	size_t i = 0;
+	if (x >> 32) { x >>= 32; i += 32; }
+	if (x >> 16) { x >>= 16; i += 16; }
+	if (x >> 8) { x >>= 8; i += 8; }
+	if (x >> 4) { x >>= 4; i += 4; }
+	if (x >> 2) { x >>= 2; i += 2; }
+	if (x >> 1) i += 1;
+	return i;
+#endif
+}
+
+// highest (low priority) or lowest (high priority) note in 128-bit set s,
+// which must not be empty
+static inline unsigned char bw_voice_alloc_pick_note(
+		bw_voice_alloc_priority priority,
+		const uint64_t *        s) {
+	if (priority == bw_voice_alloc_priority_low)
+		return (unsigned char)(s[1] ? 64 + bw_voice_alloc_msb(s[1]) : bw_voice_alloc_msb(s[0]));
+	return (unsigned char)(s[0] ? bw_voice_alloc_lsb(s[0]) : 64 + bw_voice_alloc_lsb(s[1]));
+}
+
+static inline void bw_voice_alloc_do_get_pressed(
+		const bw_note_queue * BW_RESTRICT queue,
+		uint64_t * BW_RESTRICT            pressed) {
+	pressed[0] = 0;
+	pressed[1] = 0;
+	for (size_t i = 0; i < 128; i++)
+		pressed[i >> 6] |= (uint64_t)(queue->status[i].pressed != 0) << (i & 63);
+}
+
+static inline void bw_voice_alloc_do_assign(
+		bw_voice_alloc_state * BW_RESTRICT state,
+		size_t                             voice,
+		unsigned char                      note) {
+	state->voice_note[voice] = note;
+	state->note_voice[note] = voice;
+	state->busy_notes[note >> 6] |= (uint64_t)1 << (note & 63);
+}
+
+// returns the voice the event applies to, or state->n_voices if none, and
+// whether note off and/or note on should be triggered on it
+static inline size_t bw_voice_alloc_do_event(
+		bw_voice_alloc_state * BW_RESTRICT        state,
+		bw_voice_alloc_priority                   priority,
+		const uint64_t * BW_RESTRICT              pressed,
+		const bw_note_queue_event * BW_RESTRICT   ev,
+		const bw_note_queue_status * BW_RESTRICT  st,
+		char * BW_RESTRICT                        note_off,
+		char * BW_RESTRICT                        note_on) {
+	const unsigned char note = ev->note;
+	const size_t w = note >> 6;
+	const uint64_t b = (uint64_t)1 << (note & 63);
+
+	// note already associated to a busy voice
+	if (state->busy_notes[w] & b) {
+		*note_off = !st->pressed || ev->went_off;
+		*note_on = st->pressed;
+		return state->note_voice[note];
+	}
+
+	*note_off = 0;
+	*note_on = st->pressed;
+	if (!st->pressed)
+		return state->n_voices;
+
+	// first free voice
+	for (size_t i = 0; i < BW_VOICE_ALLOC_N_WORDS; i++)
+		if (state->free[i]) {
+			const size_t k = (i << 6) + bw_voice_alloc_lsb(state->free[i]);
+			state->free[i] &= state->free[i] - 1;
+			bw_voice_alloc_do_assign(state, k, note);
+			return k;
+		}
+
+	// steal voice playing a released note, otherwise playing the farthest
+	// note in the priority direction if it beats the new one
+	uint64_t s[2];
+	s[0] = state->busy_notes[0] & ~pressed[0];
+	s[1] = state->busy_notes[1] & ~pressed[1];
+	unsigned char n;
+	if (s[0] | s[1])
+		n = bw_voice_alloc_pick_note(priority, s);
+	else {
+		n = bw_voice_alloc_pick_note(priority, state->busy_notes);
+		if (priority == bw_voice_alloc_priority_low ? n <= note : n >= note) {
+			*note_on = 0;
+			return state->n_voices;
+		}
+	}
+	const size_t k = state->note_voice[n];
+	state->busy_notes[n >> 6] &= ~((uint64_t)1 << (n & 63));
+	bw_voice_alloc_do_assign(state, k, note);
+	return k;
+}
+
+static inline void bw_voice_alloc_reset_state(
+		bw_voice_alloc_state * BW_RESTRICT state,
+		size_t                             n_voices) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT(n_voices >= 1 && n_voices <= BW_VOICE_ALLOC_MAX_VOICES);
+
+	for (size_t i = 0; i < BW_VOICE_ALLOC_N_WORDS; i++) {
+		const size_t n = i << 6;
+		state->free[i] = n_voices <= n ? 0 : (n_voices - n >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << (n_voices - n)) - 1);
+	}
+	state->n_voices = n_voices;
+	for (size_t i = 0; i < n_voices; i++)
+		state->voice_note[i] = 0;
+	state->busy_notes[0] = 0;
+	state->busy_notes[1] = 0;
+	for (size_t i = 0; i < 128; i++)
+		state->note_voice[i] = 0;
+
+#ifdef BW_DEBUG_DEEP
+	state->hash = bw_hash_sdbm("bw_voice_alloc_state");
+#endif
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+}
+
+static inline void bw_voice_alloc_process(
+		const bw_voice_alloc_opts * BW_RESTRICT opts,
+		bw_voice_alloc_state * BW_RESTRICT      state,
+		const bw_note_queue * BW_RESTRICT       queue,
+		void * BW_RESTRICT const * BW_RESTRICT  voices) {
+	BW_ASSERT(opts != BW_NULL);
+	BW_ASSERT(opts->priority == bw_voice_alloc_priority_low || opts->priority == bw_voice_alloc_priority_high);
+	BW_ASSERT(opts->note_on != BW_NULL);
+	BW_ASSERT(opts->note_off != BW_NULL);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+	BW_ASSERT(queue != BW_NULL);
+	BW_ASSERT_DEEP(bw_note_queue_is_valid(queue));
+	BW_ASSERT(voices != BW_NULL);
+
+	if (queue->n_events == 0)
+		return;
+
+	uint64_t pressed[2];
+	bw_voice_alloc_do_get_pressed(queue, pressed);
+	for (unsigned char i = 0; i < queue->n_events; i++) {
+		const bw_note_queue_event *ev = queue->events + i;
+		const bw_note_queue_status *st = queue->status + ev->note;
+		char note_off, note_on;
+		const size_t k = bw_voice_alloc_do_event(state, opts->priority, pressed, ev, st, &note_off, &note_on);
+		if (k == state->n_voices)
+			continue;
+		if (note_off)
+			opts->note_off(voices[k], st->velocity);
+		if (note_on)
+			opts->note_on(voices[k], ev->note, st->velocity);
+	}
+
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+}
+
+static inline void bw_voice_alloc_set_voice_free(
+		bw_voice_alloc_state * BW_RESTRICT state,
+		size_t                             voice) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+	BW_ASSERT(voice < state->n_voices);
+
+	const size_t w = voice >> 6;
+	const uint64_t b = (uint64_t)1 << (voice & 63);
+	if (!(state->free[w] & b)) {
+		const unsigned char note = state->voice_note[voice];
+		state->free[w] |= b;
+		state->busy_notes[note >> 6] &= ~((uint64_t)1 << (note & 63));
+	}
+
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+}
+
+static inline char bw_voice_alloc_is_voice_free(
+		const bw_voice_alloc_state * BW_RESTRICT state,
+		size_t                                   voice) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+	BW_ASSERT(voice < state->n_voices);
+
+	return (state->free[voice >> 6] >> (voice & 63)) & 1;
+}
+
+static inline unsigned char bw_voice_alloc_get_voice_note(
+		const bw_voice_alloc_state * BW_RESTRICT state,
+		size_t                                   voice) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+	BW_ASSERT(voice < state->n_voices);
+
+	return state->voice_note[voice];
+}
+
+static inline size_t bw_voice_alloc_get_active_voices(
+		const bw_voice_alloc_state * BW_RESTRICT state,
+		size_t * BW_RESTRICT                     active) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(state));
+	BW_ASSERT(active != BW_NULL);
+
+	size_t n = 0;
+	for (size_t i = 0; i < BW_VOICE_ALLOC_N_WORDS && (i << 6) < state->n_voices; i++) {
+		const size_t m = state->n_voices - (i << 6);
+		uint64_t busy = ~state->free[i];
+		if (m < 64)
+			busy &= ((uint64_t)1 << m) - 1;
+		for (; busy; busy &= busy - 1) {
+			active[n] = (i << 6) + bw_voice_alloc_lsb(busy);
+			n++;
+		}
+	}
+	return n;
+}
+
+static inline char bw_voice_alloc_state_is_valid(
+		const bw_voice_alloc_state * BW_RESTRICT state) {
+	BW_ASSERT(state != BW_NULL);
+
+#ifdef BW_DEBUG_DEEP
+	if (state->hash != bw_hash_sdbm("bw_voice_alloc_state"))
+		return 0;
+#endif
+
+	if (state->n_voices < 1 || state->n_voices > BW_VOICE_ALLOC_MAX_VOICES)
+		return 0;
+
+	// free bits only for existing voices
+	for (size_t i = 0; i < BW_VOICE_ALLOC_N_WORDS; i++) {
+		const size_t n = i << 6;
+		if (state->n_voices <= n ? state->free[i] != 0 : state->n_voices - n < 64 && (state->free[i] >> (state->n_voices - n)) != 0)
+			return 0;
+	}
+
+	size_t n_busy = 0;
+	for (size_t i = 0; i < state->n_voices; i++) {
+		if (state->voice_note[i] >= 128)
+			return 0;
+		if (!((state->free[i >> 6] >> (i & 63)) & 1)) {
+			const unsigned char note = state->voice_note[i];
+			if (!((state->busy_notes[note >> 6] >> (note & 63)) & 1) || state->note_voice[note] != i)
+				return 0;
+			n_busy++;
+		}
+	}
+
+	size_t n_notes = 0;
+	for (size_t i = 0; i < 128; i++)
+		if ((state->busy_notes[i >> 6] >> (i & 63)) & 1) {
+			if (state->note_voice[i] >= state->n_voices)
+				return 0;
+			n_notes++;
+		}
+
+	return n_busy == n_notes;
+}
+
 #ifdef __cplusplus
+}
+
+/*** Public C++ API ***/
+
+namespace Brickworks {
+
+/*! api_cpp {{{
+ *    ##### Brickworks::VoiceAlloc
+ *  ```>>> */
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY = bw_voice_alloc_priority_low>
+class VoiceAlloc {
+public:
+	VoiceAlloc();
+
+	void reset();
+
+	template<typename T>
+	void process(
+		const NoteQueue & queue,
+		T * BW_RESTRICT   voices);
+
+	void setVoiceFree(
+		size_t voice);
+
+	bool isVoiceFree(
+		size_t voice) const;
+
+	unsigned char getVoiceNote(
+		size_t voice) const;
+
+	size_t getActiveVoices(
+		size_t * BW_RESTRICT active) const;
+/*! <<<...
+ *  }
+ *  ```
+ *
+ *    `N_VOICES` must be in [`1`, `BW_VOICE_ALLOC_MAX_VOICES`], which is
+ *    checked at compile time.
+ *
+ *    `process()` implements the same policy as `bw_voice_alloc_process()`
+ *    with note priority given by `PRIORITY`. `voices` must point to
+ *    `N_VOICES` objects of type `T`, which must have the
+ *    `void noteOn(unsigned char note, float velocity)` and
+ *    `void noteOff(float velocity)` member functions. These are called
+ *    directly, hence they can be inlined.
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+private:
+	static_assert(N_VOICES >= 1 && N_VOICES <= BW_VOICE_ALLOC_MAX_VOICES, "N_VOICES must be in [1, BW_VOICE_ALLOC_MAX_VOICES]");
+
+	bw_voice_alloc_state	state;
+};
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+inline VoiceAlloc<N_VOICES, PRIORITY>::VoiceAlloc() {
+	bw_voice_alloc_reset_state(&state, N_VOICES);
+}
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+inline void VoiceAlloc<N_VOICES, PRIORITY>::reset() {
+	bw_voice_alloc_reset_state(&state, N_VOICES);
+}
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+template<typename T>
+inline void VoiceAlloc<N_VOICES, PRIORITY>::process(
+		const NoteQueue & queue,
+		T * BW_RESTRICT   voices) {
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(&state));
+	BW_ASSERT_DEEP(bw_note_queue_is_valid(&queue.queue));
+	BW_ASSERT(voices != BW_NULL);
+
+	if (queue.queue.n_events == 0)
+		return;
+
+	uint64_t pressed[2];
+	bw_voice_alloc_do_get_pressed(&queue.queue, pressed);
+	for (unsigned char i = 0; i < queue.queue.n_events; i++) {
+		const bw_note_queue_event *ev = queue.queue.events + i;
+		const bw_note_queue_status *st = queue.queue.status + ev->note;
+		char noteOff, noteOn;
+		const size_t k = bw_voice_alloc_do_event(&state, PRIORITY, pressed, ev, st, &noteOff, &noteOn);
+		if (k == N_VOICES)
+			continue;
+		if (noteOff)
+			voices[k].noteOff(st->velocity);
+		if (noteOn)
+			voices[k].noteOn(ev->note, st->velocity);
+	}
+
+	BW_ASSERT_DEEP(bw_voice_alloc_state_is_valid(&state));
+}
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+inline void VoiceAlloc<N_VOICES, PRIORITY>::setVoiceFree(
+		size_t voice) {
+	bw_voice_alloc_set_voice_free(&state, voice);
+}
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+inline bool VoiceAlloc<N_VOICES, PRIORITY>::isVoiceFree(
+		size_t voice) const {
+	return bw_voice_alloc_is_voice_free(&state, voice);
+}
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+inline unsigned char VoiceAlloc<N_VOICES, PRIORITY>::getVoiceNote(
+		size_t voice) const {
+	return bw_voice_alloc_get_voice_note(&state, voice);
+}
+
+template<size_t N_VOICES, bw_voice_alloc_priority PRIORITY>
+inline size_t VoiceAlloc<N_VOICES, PRIORITY>::getActiveVoices(
+		size_t * BW_RESTRICT active) const {
+	return bw_voice_alloc_get_active_voices(&state, active);
+}
+
 }
 #endif
 
@@ -0,0 +1,1214 @@
+/*
+ * Brickworks
+ *
+ * Copyright (C) 2024 Orastron Srl unipersonale
+ *
+ * Brickworks is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3 of the License.
+ *
+ * Brickworks is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Brickworks.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * File author: agent
+ */
+
+/*!
+ *  module_type {{{ dsp }}}
+ *  version {{{ 1.1.0 }}}
+ *  requires {{{ bw_common bw_math }}}
+ *  description {{{
+ *    Bank of subtractive synthesizer voices processed together.
+ *
+ *    Each voice is made of an antialiased sawtooth oscillator (same algorithm
+ *    as [bw_osc_saw](bw_osc_saw)), a second-order lowpass filter with its own
+ *    cutoff frequency (same topology as [bw_svf](bw_svf)), and a linear ADSR
+ *    envelope generator (similar to [bw_env_gen](bw_env_gen)) driving the
+ *    output amplitude. The output is the sum of all voices.
+ *
+ *    Voices are stored in groups of `BW_VOICE_BANK_LANES`, each group holding
+ *    one array per field, and each sample is computed for a whole group at
+ *    once by branchless loops that compilers can turn into SIMD
+ *    instructions. Shared parameters (filter Q and envelope times) live in
+ *    `bw_voice_bank_coeffs`, while per-voice parameters (frequency, cutoff,
+ *    and gate) live in `bw_voice_bank_state`, so that, contrary to
+ *    `*_process_multi()` functions, each voice can have different
+ *    coefficients.
+ *  }}}
+ *  changelog {{{
+ *    <ul>
+ *      <li>Version <strong>1.1.0</strong>:
+ *        <ul>
+ *          <li>First release.</li>
+ *        </ul>
+ *      </li>
+ *    </ul>
+ *  }}}
+ */
+
+#ifndef BW_VOICE_BANK_H
+#define BW_VOICE_BANK_H
+
+#include <bw_common.h>
+
+/*! ...
+ *
+ *    #### BW_VOICE_BANK_LANES
+ *
+ *    `BW_VOICE_BANK_LANES` is the number of voices that are processed
+ *    together.
+ *
+ *    If it is not defined already, then it gets defined as `8`, which suits
+ *    both 128-bit and 256-bit SIMD instruction sets. The number of voices is
+ *    rounded up to a multiple of this value (extra voices are silent), hence
+ *    it also affects the size of the memory returned by
+ *    `bw_voice_bank_mem_req()`.
+ *
+ *  >>> */
+#ifndef BW_VOICE_BANK_LANES
+# define BW_VOICE_BANK_LANES 8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! api {{{
+ *    #### bw_voice_bank_coeffs
+ *  ```>>> */
+typedef struct bw_voice_bank_coeffs bw_voice_bank_coeffs;
+/*! <<<```
+ *    Coefficients and related.
+ *
+ *    #### bw_voice_bank_state
+ *  ```>>> */
+typedef struct bw_voice_bank_state bw_voice_bank_state;
+/*! <<<```
+ *    Internal state and related, including per-voice parameters.
+ *
+ *    #### bw_voice_bank_init()
+ *  ```>>> */
+static inline void bw_voice_bank_init(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	size_t                             n_voices);
+/*! <<<```
+ *    Initializes input parameter values in `coeffs` for a bank of `n_voices`
+ *    voices.
+ *
+ *    `n_voices` must be positive.
+ *
+ *    #### bw_voice_bank_set_sample_rate()
+ *  ```>>> */
+static inline void bw_voice_bank_set_sample_rate(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	float                              sample_rate);
+/*! <<<```
+ *    Sets the `sample_rate` (Hz) value in `coeffs`.
+ *
+ *    #### bw_voice_bank_mem_req()
+ *  ```>>> */
+static inline size_t bw_voice_bank_mem_req(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Returns the size, in bytes, of contiguous memory to be supplied to
+ *    `bw_voice_bank_mem_set()` using `coeffs`.
+ *
+ *    It only depends on the number of voices, hence it can be called any time
+ *    after `bw_voice_bank_init()`.
+ *
+ *    #### bw_voice_bank_mem_set()
+ *  ```>>> */
+static inline void bw_voice_bank_mem_set(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	bw_voice_bank_state * BW_RESTRICT        state,
+	void * BW_RESTRICT                       mem);
+/*! <<<```
+ *    Associates the contiguous memory block `mem` to the given `state` using
+ *    `coeffs` and sets all per-voice parameters to their default values.
+ *
+ *    `mem` must be suitably aligned for `float`. Aligning it to the size of
+ *    SIMD registers or more (e.g., 32 bytes) is recommended.
+ *
+ *    It can be called any time after `bw_voice_bank_init()`.
+ *
+ *    #### bw_voice_bank_reset_coeffs()
+ *  ```>>> */
+static inline void bw_voice_bank_reset_coeffs(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Resets coefficients in `coeffs` to assume their target values.
+ *
+ *    #### bw_voice_bank_reset_state()
+ *  ```>>> */
+static inline void bw_voice_bank_reset_state(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	bw_voice_bank_state * BW_RESTRICT        state);
+/*! <<<```
+ *    Resets the given `state` to its initial values using the given `coeffs`.
+ *
+ *    All voices are turned off (gate off and silent envelope), oscillator
+ *    phases and filter states are set to `0.f`, and filter coefficients
+ *    immediately assume the values corresponding to per-voice cutoff
+ *    frequencies. Per-voice frequency and cutoff values are kept.
+ *
+ *    #### bw_voice_bank_update_coeffs_ctrl()
+ *  ```>>> */
+static inline void bw_voice_bank_update_coeffs_ctrl(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Triggers control-rate update of coefficients in `coeffs`.
+ *
+ *    #### bw_voice_bank_process_ctrl()
+ *  ```>>> */
+static inline void bw_voice_bank_process_ctrl(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	bw_voice_bank_state * BW_RESTRICT        state,
+	size_t                                   n_samples);
+/*! <<<```
+ *    Triggers control-rate update of per-voice coefficients in `state` using
+ *    `coeffs`.
+ *
+ *    Oscillator frequencies change immediately, while filter coefficients
+ *    linearly move towards the values corresponding to per-voice cutoff
+ *    frequencies over the following `n_samples` calls to
+ *    `bw_voice_bank_process1()`.
+ *
+ *    `n_samples` must be positive.
+ *
+ *    #### bw_voice_bank_process1()
+ *  ```>>> */
+static inline float bw_voice_bank_process1(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	bw_voice_bank_state * BW_RESTRICT        state);
+/*! <<<```
+ *    Generates one sample of all voices using `coeffs`, while using and
+ *    updating `state` (audio rate only), and returns their sum.
+ *
+ *    #### bw_voice_bank_process()
+ *  ```>>> */
+static inline void bw_voice_bank_process(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	bw_voice_bank_state * BW_RESTRICT  state,
+	float * BW_RESTRICT                y,
+	size_t                             n_samples);
+/*! <<<```
+ *    Generates and fills the first `n_samples` of the output buffer `y` with
+ *    the sum of all voices, while using and updating both `coeffs` and
+ *    `state` (control and audio rate).
+ *
+ *    #### bw_voice_bank_set_Q()
+ *  ```>>> */
+static inline void bw_voice_bank_set_Q(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	float                              value);
+/*! <<<```
+ *    Sets the quality factor of all filters to the given `value` in `coeffs`.
+ *
+ *    Valid range: [`1e-6f`, `1e6f`].
+ *
+ *    Default value: `0.5f`.
+ *
+ *    #### bw_voice_bank_set_attack()
+ *  ```>>> */
+static inline void bw_voice_bank_set_attack(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	float                              value);
+/*! <<<```
+ *    Sets the attack time of all envelopes to `value` (s) in `coeffs`.
+ *
+ *    Valid range: [`0.f`, `60.f`].
+ *
+ *    Default value: `0.f`.
+ *
+ *    #### bw_voice_bank_set_decay()
+ *  ```>>> */
+static inline void bw_voice_bank_set_decay(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	float                              value);
+/*! <<<```
+ *    Sets the decay time of all envelopes to `value` (s) in `coeffs`.
+ *
+ *    Valid range: [`0.f`, `60.f`].
+ *
+ *    Default value: `0.f`.
+ *
+ *    #### bw_voice_bank_set_sustain()
+ *  ```>>> */
+static inline void bw_voice_bank_set_sustain(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	float                              value);
+/*! <<<```
+ *    Sets the sustain level of all envelopes to `value` in `coeffs`.
+ *
+ *    Contrary to [bw_env_gen](bw_env_gen), changes are not smoothed.
+ *
+ *    Valid range: [`0.f`, `1.f`].
+ *
+ *    Default value: `1.f`.
+ *
+ *    #### bw_voice_bank_set_release()
+ *  ```>>> */
+static inline void bw_voice_bank_set_release(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	float                              value);
+/*! <<<```
+ *    Sets the release time of all envelopes to `value` (s) in `coeffs`.
+ *
+ *    Valid range: [`0.f`, `60.f`].
+ *
+ *    Default value: `0.f`.
+ *
+ *    #### bw_voice_bank_set_voice_frequency()
+ *  ```>>> */
+static inline void bw_voice_bank_set_voice_frequency(
+	bw_voice_bank_state * BW_RESTRICT state,
+	size_t                            voice,
+	float                             value);
+/*! <<<```
+ *    Sets the oscillator frequency of the given `voice` to `value` (Hz) in
+ *    `state`.
+ *
+ *    It is internally limited to half the sample rate.
+ *
+ *    `voice` must be less than the number of voices.
+ *
+ *    Valid range: [`0.f`, `1e12f`].
+ *
+ *    Default value: `1.f`.
+ *
+ *    #### bw_voice_bank_set_voice_cutoff()
+ *  ```>>> */
+static inline void bw_voice_bank_set_voice_cutoff(
+	bw_voice_bank_state * BW_RESTRICT state,
+	size_t                            voice,
+	float                             value);
+/*! <<<```
+ *    Sets the filter cutoff frequency of the given `voice` to `value` (Hz) in
+ *    `state`.
+ *
+ *    It is internally limited to avoid instability.
+ *
+ *    `voice` must be less than the number of voices.
+ *
+ *    Valid range: [`1e-6f`, `1e12f`].
+ *
+ *    Default value: `1e3f`.
+ *
+ *    #### bw_voice_bank_set_voice_gate()
+ *  ```>>> */
+static inline void bw_voice_bank_set_voice_gate(
+	bw_voice_bank_state * BW_RESTRICT state,
+	size_t                            voice,
+	char                              value);
+/*! <<<```
+ *    Sets the envelope gate of the given `voice` to `value` (`0` for off,
+ *    non-`0` for on) in `state`.
+ *
+ *    Turning the gate on restarts the attack phase from the current envelope
+ *    level, turning it off starts the release phase.
+ *
+ *    `voice` must be less than the number of voices.
+ *
+ *    Default value: `0` (off).
+ *
+ *    #### bw_voice_bank_get_voice_env()
+ *  ```>>> */
+static inline float bw_voice_bank_get_voice_env(
+	const bw_voice_bank_state * BW_RESTRICT state,
+	size_t                                  voice);
+/*! <<<```
+ *    Returns the last envelope value of the given `voice` as stored in
+ *    `state`. Voices whose gate is off and whose envelope value is `0.f` are
+ *    silent.
+ *
+ *    `voice` must be less than the number of voices.
+ *
+ *    #### bw_voice_bank_set_profile_stats()
+ *  ```>>> */
+static inline void bw_voice_bank_set_profile_stats(
+	bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *                 stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_voice_bank_process()` updates when
+ *    using `coeffs` if `BW_PROFILE` is defined (see [bw_common](bw_common)).
+ *    If `stats` is `BW_NULL`, no profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
+ *    #### bw_voice_bank_coeffs_is_valid()
+ *  ```>>> */
+static inline char bw_voice_bank_coeffs_is_valid(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs);
+/*! <<<```
+ *    Tries to determine whether `coeffs` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    `coeffs` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_voice_bank_coeffs`.
+ *
+ *    #### bw_voice_bank_state_is_valid()
+ *  ```>>> */
+static inline char bw_voice_bank_state_is_valid(
+	const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+	const bw_voice_bank_state * BW_RESTRICT  state);
+/*! <<<```
+ *    Tries to determine whether `state` is valid and returns non-`0` if it
+ *    seems to be the case and `0` if it is certainly not. False positives are
+ *    possible, false negatives are not.
+ *
+ *    If `coeffs` is not `BW_NULL` extra cross-checks might be performed
+ *    (`state` is supposed to be associated to `coeffs`).
+ *
+ *    `state` must at least point to a readable memory block of size greater
+ *    than or equal to that of `bw_voice_bank_state`.
+ *  }}} */
+
+#ifdef __cplusplus
+}
+#endif
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+#include <bw_math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef BW_DEBUG_DEEP
+enum bw_voice_bank_coeffs_state {
+	bw_voice_bank_coeffs_state_invalid,
+	bw_voice_bank_coeffs_state_init,
+	bw_voice_bank_coeffs_state_set_sample_rate,
+	bw_voice_bank_coeffs_state_reset_coeffs
+};
+#endif
+
+#ifdef BW_DEBUG_DEEP
+enum bw_voice_bank_state_state {
+	bw_voice_bank_state_state_invalid,
+	bw_voice_bank_state_state_mem_set,
+	bw_voice_bank_state_state_reset_state
+};
+#endif
+
+// Data of BW_VOICE_BANK_LANES voices, one array per field. Memory is an array
+// of these, so that all fields of a group of voices are accessed at constant
+// offsets from one pointer and compilers can tell that they do not overlap
+// (also in C++, where restrict is not available).
+typedef struct {
+	// Parameters
+	float	frequency[BW_VOICE_BANK_LANES];
+	float	cutoff[BW_VOICE_BANK_LANES];
+	float	gate[BW_VOICE_BANK_LANES];
+
+	// Coefficients
+	float	phase_inc[BW_VOICE_BANK_LANES];
+	float	phase_inc_rcp[BW_VOICE_BANK_LANES];
+	float	g[BW_VOICE_BANK_LANES];
+	float	g_inc[BW_VOICE_BANK_LANES];
+
+	// States
+	float	phase[BW_VOICE_BANK_LANES];
+	float	s1[BW_VOICE_BANK_LANES];
+	float	s2[BW_VOICE_BANK_LANES];
+	float	env[BW_VOICE_BANK_LANES];
+	float	attack[BW_VOICE_BANK_LANES];
+} bw_voice_bank_lanes;
+
+#define BW_VOICE_BANK_N_LANES(n_voices)	(((n_voices) + BW_VOICE_BANK_LANES - 1) / BW_VOICE_BANK_LANES)
+
+struct bw_voice_bank_coeffs {
+#ifdef BW_DEBUG_DEEP
+	uint32_t			hash;
+	enum bw_voice_bank_coeffs_state	state;
+	uint32_t			reset_id;
+#endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
+
+	// Coefficients
+	float				T;
+	float				t_k;
+	float				cutoff_max;
+
+	float				k;
+	float				attack_inc;
+	float				decay_dec;
+	float				release_dec;
+
+	// Parameters
+	size_t				n_voices;
+	float				Q;
+	float				attack;
+	float				decay;
+	float				sustain;
+	float				release;
+};
+
+struct bw_voice_bank_state {
+#ifdef BW_DEBUG_DEEP
+	uint32_t			hash;
+	enum bw_voice_bank_state_state	state;
+	uint32_t			coeffs_reset_id;
+#endif
+
+	bw_voice_bank_lanes *		lanes;
+	size_t				n_voices;
+	size_t				n_lanes;
+};
+
+static inline void bw_voice_bank_init(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		size_t                             n_voices) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT(n_voices > 0);
+
+	coeffs->n_voices = n_voices;
+	coeffs->Q = 0.5f;
+	coeffs->attack = 0.f;
+	coeffs->decay = 0.f;
+	coeffs->sustain = 1.f;
+	coeffs->release = 0.f;
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
+#ifdef BW_DEBUG_DEEP
+	coeffs->hash = bw_hash_sdbm("bw_voice_bank_coeffs");
+	coeffs->state = bw_voice_bank_coeffs_state_init;
+	coeffs->reset_id = coeffs->hash + 1;
+#endif
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state == bw_voice_bank_coeffs_state_init);
+}
+
+static inline void bw_voice_bank_set_sample_rate(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		float                              sample_rate) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(sample_rate) && sample_rate > 0.f);
+
+	coeffs->T = 1.f / sample_rate;
+	coeffs->t_k = 3.141592653589793f / sample_rate;
+	coeffs->cutoff_max = 0.499f * sample_rate;
+
+#ifdef BW_DEBUG_DEEP
+	coeffs->state = bw_voice_bank_coeffs_state_set_sample_rate;
+#endif
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state == bw_voice_bank_coeffs_state_set_sample_rate);
+}
+
+static inline size_t bw_voice_bank_mem_req(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+
+	return BW_VOICE_BANK_N_LANES(coeffs->n_voices) * sizeof(bw_voice_bank_lanes);
+}
+
+static inline void bw_voice_bank_mem_set(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_state * BW_RESTRICT        state,
+		void * BW_RESTRICT                       mem) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT(mem != BW_NULL);
+
+	state->lanes = (bw_voice_bank_lanes *)mem;
+	state->n_voices = coeffs->n_voices;
+	state->n_lanes = BW_VOICE_BANK_N_LANES(coeffs->n_voices);
+
+	// padding voices also get valid values, they are processed but silent
+	for (size_t i = 0; i < state->n_lanes; i++) {
+		bw_voice_bank_lanes *l = state->lanes + i;
+		for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++) {
+			l->frequency[j] = 1.f;
+			l->cutoff[j] = 1e3f;
+			l->gate[j] = 0.f;
+		}
+	}
+
+#ifdef BW_DEBUG_DEEP
+	state->hash = bw_hash_sdbm("bw_voice_bank_state");
+	state->state = bw_voice_bank_state_state_mem_set;
+#endif
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state == bw_voice_bank_state_state_mem_set);
+}
+
+static inline void bw_voice_bank_do_update_coeffs(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs) {
+	// 1 ns considered instantaneous, like in bw_env_gen
+	coeffs->k = bw_rcpf(coeffs->Q);
+	coeffs->attack_inc = coeffs->attack > 1e-9f ? coeffs->T * bw_rcpf(coeffs->attack) : 1.f;
+	coeffs->decay_dec = coeffs->decay > 1e-9f ? (1.f - coeffs->sustain) * (coeffs->T * bw_rcpf(coeffs->decay)) : 1.f;
+	coeffs->release_dec = coeffs->release > 1e-9f && coeffs->sustain > 0.f ? coeffs->sustain * (coeffs->T * bw_rcpf(coeffs->release)) : 1.f;
+}
+
+// computes phase increments and puts filter coefficient targets into g_inc
+static inline void bw_voice_bank_do_update_lanes(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_lanes * BW_RESTRICT        l) {
+	for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++) {
+		const float inc = bw_minf(coeffs->T * l->frequency[j], 0.5f);
+		l->phase_inc[j] = inc;
+		l->phase_inc_rcp[j] = inc > 1e-6f ? bw_rcpf(inc) : 0.f;
+		l->g_inc[j] = coeffs->t_k * bw_minf(l->cutoff[j], coeffs->cutoff_max);
+	}
+	bw_tanf_buf(l->g_inc, l->g_inc, BW_VOICE_BANK_LANES);
+}
+
+static inline void bw_voice_bank_reset_coeffs(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_set_sample_rate);
+
+	bw_voice_bank_do_update_coeffs(coeffs);
+
+#ifdef BW_DEBUG_DEEP
+	coeffs->state = bw_voice_bank_coeffs_state_reset_coeffs;
+	coeffs->reset_id++;
+#endif
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state == bw_voice_bank_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_voice_bank_reset_state(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_state * BW_RESTRICT        state) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_mem_set);
+
+	for (size_t i = 0; i < state->n_lanes; i++) {
+		bw_voice_bank_lanes *l = state->lanes + i;
+		bw_voice_bank_do_update_lanes(coeffs, l);
+		for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++) {
+			l->gate[j] = 0.f;
+			l->g[j] = l->g_inc[j];
+			l->g_inc[j] = 0.f;
+			l->phase[j] = 0.f;
+			l->s1[j] = 0.f;
+			l->s2[j] = 0.f;
+			l->env[j] = 0.f;
+			l->attack[j] = 0.f;
+		}
+	}
+
+#ifdef BW_DEBUG_DEEP
+	state->state = bw_voice_bank_state_state_reset_state;
+	state->coeffs_reset_id = coeffs->reset_id;
+#endif
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state == bw_voice_bank_state_state_reset_state);
+}
+
+static inline void bw_voice_bank_update_coeffs_ctrl(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+
+	bw_voice_bank_do_update_coeffs(coeffs);
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+}
+
+static inline void bw_voice_bank_process_ctrl(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_state * BW_RESTRICT        state,
+		size_t                                   n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+	BW_ASSERT(n_samples > 0);
+
+	const float k = 1.f / (float)n_samples;
+	for (size_t i = 0; i < state->n_lanes; i++) {
+		bw_voice_bank_lanes *l = state->lanes + i;
+		bw_voice_bank_do_update_lanes(coeffs, l);
+		for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++)
+			l->g_inc[j] = k * (l->g_inc[j] - l->g[j]);
+	}
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+}
+
+static inline float bw_voice_bank_blep_diff(
+		float x) {
+	// same as bw_osc_saw_blep_diff(), but with x clipped to [0.f, 2.f] and
+	// without branches: both polynomial pieces are -1/12 at x = 1.f and x is
+	// non-negative, so that it is clipped by comparing bit patterns as
+	// integers, which compilers do not turn into branches
+	union { float f; int32_t i; } v, x_1, x_2;
+	v.f = x;
+	x_1.f = 1.f;
+	x_2.f = 2.f;
+	x_2.i = v.i < x_2.i ? v.i : x_2.i;
+	x_2.i = x_2.i > x_1.i ? x_2.i : x_1.i;
+	x_1.i = v.i < x_1.i ? v.i : x_1.i;
+	const float y_1 = x_1.f * ((0.25f * x_1.f - 0.6666666666666666f) * x_1.f * x_1.f + 1.333333333333333f) - 1.f;
+	const float y_2 = x_2.f * (x_2.f * ((0.6666666666666666f - 0.08333333333333333f * x_2.f) * x_2.f - 2.f) + 2.666666666666667f) - 1.333333333333333f;
+	return y_1 + y_2 + 0.08333333333333333f;
+}
+
+static inline void bw_voice_bank_do_process_lanes(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_lanes * BW_RESTRICT        l,
+		float * BW_RESTRICT                      y) {
+	const float k = coeffs->k;
+	const float attack_inc = coeffs->attack_inc;
+	const float decay_dec = coeffs->decay_dec;
+	const float sustain = coeffs->sustain;
+	const float release_dec = coeffs->release_dec;
+
+	// written so that compilers can use one SIMD instruction per step for all
+	// lanes: no branches (only selects) and no trapping operations in them
+	for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++) {
+		// oscillator (see bw_phase_gen and bw_osc_saw), as q is in [1.f, 2.5f)
+		// truncation is the same as bw_floorf() and blep_diff(2.f) = 0.f
+		const float q = l->phase[j] + (l->phase_inc[j] + 1.f);
+		const float p = q - (float)(int32_t)q;
+		l->phase[j] = p;
+		const float o = p + p - 1.f
+			+ bw_voice_bank_blep_diff((1.f - p) * l->phase_inc_rcp[j])
+			- bw_voice_bank_blep_diff(p * l->phase_inc_rcp[j]);
+
+		// lowpass filter (see bw_svf)
+		const float g = l->g[j] + l->g_inc[j];
+		l->g[j] = g;
+		const float hp_hb = k + g;
+		const float hp = (o - hp_hb * l->s1[j] - l->s2[j]) * bw_rcpf(1.f + g * hp_hb);
+		const float bp_v = g * hp;
+		const float bp = bp_v + l->s1[j];
+		l->s1[j] = bp + bp_v;
+		const float lp_v = g * bp;
+		const float lp = lp_v + l->s2[j];
+		l->s2[j] = lp + lp_v;
+
+		// envelope generator (see bw_env_gen), attack and gate are 0.f or 1.f
+		const float e = l->env[j];
+		const float e_attack = bw_minf(e + attack_inc, 1.f);
+		const float e_decay = bw_maxf(e - decay_dec, sustain);
+		const float e_release = bw_maxf(e - release_dec, 0.f);
+		const float e_on = bw_maxf(l->attack[j] * e_attack, (1.f - l->attack[j]) * e_decay);
+		l->attack[j] = e_on < 1.f ? l->attack[j] : 0.f;
+		const float e_out = bw_maxf(l->gate[j] * e_on, (1.f - l->gate[j]) * e_release);
+		l->env[j] = e_out;
+
+		y[j] += e_out * lp;
+	}
+}
+
+static inline float bw_voice_bank_process1(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_state * BW_RESTRICT        state) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+
+	// one partial sum per lane
+	float acc[BW_VOICE_BANK_LANES];
+	for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++)
+		acc[j] = 0.f;
+	for (size_t i = 0; i < state->n_lanes; i++)
+		bw_voice_bank_do_process_lanes(coeffs, state->lanes + i, acc);
+	float y = 0.f;
+	for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++)
+		y += acc[j];
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+	BW_ASSERT(bw_is_finite(y));
+
+	return y;
+}
+
+static inline void bw_voice_bank_process(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_voice_bank_state * BW_RESTRICT  state,
+		float * BW_RESTRICT                y,
+		size_t                             n_samples) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+	BW_ASSERT(y != BW_NULL);
+
+	if (n_samples == 0)
+		return;
+
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
+	bw_voice_bank_update_coeffs_ctrl(coeffs);
+	bw_voice_bank_process_ctrl(coeffs, state, n_samples);
+	for (size_t i = 0; i < n_samples; i++)
+		y[i] = bw_voice_bank_process1(coeffs, state);
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(coeffs, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+	BW_ASSERT_DEEP(bw_has_only_finite(y, n_samples));
+}
+
+static inline void bw_voice_bank_set_Q(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		float                              value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 1e-6f && value <= 1e6f);
+
+	coeffs->Q = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+}
+
+static inline void bw_voice_bank_set_attack(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		float                              value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 0.f && value <= 60.f);
+
+	coeffs->attack = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+}
+
+static inline void bw_voice_bank_set_decay(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		float                              value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 0.f && value <= 60.f);
+
+	coeffs->decay = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+}
+
+static inline void bw_voice_bank_set_sustain(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		float                              value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 0.f && value <= 1.f);
+
+	coeffs->sustain = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+}
+
+static inline void bw_voice_bank_set_release(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		float                              value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 0.f && value <= 60.f);
+
+	coeffs->release = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+}
+
+static inline void bw_voice_bank_set_voice_frequency(
+		bw_voice_bank_state * BW_RESTRICT state,
+		size_t                            voice,
+		float                             value) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+	BW_ASSERT(voice < state->n_voices);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 0.f && value <= 1e12f);
+
+	state->lanes[voice / BW_VOICE_BANK_LANES].frequency[voice % BW_VOICE_BANK_LANES] = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+}
+
+static inline void bw_voice_bank_set_voice_cutoff(
+		bw_voice_bank_state * BW_RESTRICT state,
+		size_t                            voice,
+		float                             value) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+	BW_ASSERT(voice < state->n_voices);
+	BW_ASSERT(bw_is_finite(value));
+	BW_ASSERT(value >= 1e-6f && value <= 1e12f);
+
+	state->lanes[voice / BW_VOICE_BANK_LANES].cutoff[voice % BW_VOICE_BANK_LANES] = value;
+
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+}
+
+static inline void bw_voice_bank_set_voice_gate(
+		bw_voice_bank_state * BW_RESTRICT state,
+		size_t                            voice,
+		char                              value) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+	BW_ASSERT(voice < state->n_voices);
+
+	bw_voice_bank_lanes *l = state->lanes + voice / BW_VOICE_BANK_LANES;
+	const size_t j = voice % BW_VOICE_BANK_LANES;
+	if (value && l->gate[j] == 0.f)
+		l->attack[j] = 1.f;
+	l->gate[j] = value ? 1.f : 0.f;
+
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+}
+
+static inline float bw_voice_bank_get_voice_env(
+		const bw_voice_bank_state * BW_RESTRICT state,
+		size_t                                  voice) {
+	BW_ASSERT(state != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_state_is_valid(BW_NULL, state));
+	BW_ASSERT_DEEP(state->state >= bw_voice_bank_state_state_reset_state);
+	BW_ASSERT(voice < state->n_voices);
+
+	return state->lanes[voice / BW_VOICE_BANK_LANES].env[voice % BW_VOICE_BANK_LANES];
+}
+
+static inline void bw_voice_bank_set_profile_stats(
+		bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *                 stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_voice_bank_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_voice_bank_coeffs_state_init);
+}
+
+static inline char bw_voice_bank_coeffs_is_valid(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs) {
+	BW_ASSERT(coeffs != BW_NULL);
+
+#ifdef BW_DEBUG_DEEP
+	if (coeffs->hash != bw_hash_sdbm("bw_voice_bank_coeffs"))
+		return 0;
+	if (coeffs->state < bw_voice_bank_coeffs_state_init || coeffs->state > bw_voice_bank_coeffs_state_reset_coeffs)
+		return 0;
+#endif
+
+	if (coeffs->n_voices < 1)
+		return 0;
+	if (!bw_is_finite(coeffs->Q) || coeffs->Q < 1e-6f || coeffs->Q > 1e6f)
+		return 0;
+	if (!bw_is_finite(coeffs->attack) || coeffs->attack < 0.f || coeffs->attack > 60.f)
+		return 0;
+	if (!bw_is_finite(coeffs->decay) || coeffs->decay < 0.f || coeffs->decay > 60.f)
+		return 0;
+	if (!bw_is_finite(coeffs->sustain) || coeffs->sustain < 0.f || coeffs->sustain > 1.f)
+		return 0;
+	if (!bw_is_finite(coeffs->release) || coeffs->release < 0.f || coeffs->release > 60.f)
+		return 0;
+
+#ifdef BW_DEBUG_DEEP
+	if (coeffs->state >= bw_voice_bank_coeffs_state_set_sample_rate) {
+		if (!bw_is_finite(coeffs->T) || coeffs->T <= 0.f)
+			return 0;
+		if (!bw_is_finite(coeffs->t_k) || coeffs->t_k <= 0.f)
+			return 0;
+		if (!bw_is_finite(coeffs->cutoff_max) || coeffs->cutoff_max <= 0.f)
+			return 0;
+	}
+
+	if (coeffs->state >= bw_voice_bank_coeffs_state_reset_coeffs) {
+		if (!bw_is_finite(coeffs->k) || coeffs->k <= 0.f)
+			return 0;
+		if (!bw_is_finite(coeffs->attack_inc) || coeffs->attack_inc <= 0.f)
+			return 0;
+		if (!bw_is_finite(coeffs->decay_dec) || coeffs->decay_dec < 0.f)
+			return 0;
+		if (!bw_is_finite(coeffs->release_dec) || coeffs->release_dec <= 0.f)
+			return 0;
+	}
+#endif
+
+	return 1;
+}
+
+static inline char bw_voice_bank_state_is_valid(
+		const bw_voice_bank_coeffs * BW_RESTRICT coeffs,
+		const bw_voice_bank_state * BW_RESTRICT  state) {
+	BW_ASSERT(state != BW_NULL);
+
+#ifdef BW_DEBUG_DEEP
+	if (state->hash != bw_hash_sdbm("bw_voice_bank_state"))
+		return 0;
+	if (state->state < bw_voice_bank_state_state_mem_set || state->state > bw_voice_bank_state_state_reset_state)
+		return 0;
+
+	if (state->state >= bw_voice_bank_state_state_reset_state && coeffs != BW_NULL && coeffs->reset_id != state->coeffs_reset_id)
+		return 0;
+#endif
+
+	if (coeffs != BW_NULL && state->n_voices != coeffs->n_voices)
+		return 0;
+	if (state->lanes == BW_NULL || state->n_lanes != BW_VOICE_BANK_N_LANES(state->n_voices))
+		return 0;
+
+	for (size_t i = 0; i < state->n_lanes; i++) {
+		const bw_voice_bank_lanes *l = state->lanes + i;
+		for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++) {
+			if (!bw_is_finite(l->frequency[j]) || l->frequency[j] < 0.f)
+				return 0;
+			if (!bw_is_finite(l->cutoff[j]) || l->cutoff[j] <= 0.f)
+				return 0;
+			if (l->gate[j] != 0.f && l->gate[j] != 1.f)
+				return 0;
+		}
+	}
+
+#ifdef BW_DEBUG_DEEP
+	if (state->state >= bw_voice_bank_state_state_reset_state)
+		for (size_t i = 0; i < state->n_lanes; i++) {
+			const bw_voice_bank_lanes *l = state->lanes + i;
+			for (size_t j = 0; j < BW_VOICE_BANK_LANES; j++) {
+				if (!(l->phase[j] >= 0.f && l->phase[j] < 1.f))
+					return 0;
+				if (!bw_is_finite(l->g[j]) || !bw_is_finite(l->s1[j]) || !bw_is_finite(l->s2[j]))
+					return 0;
+				if (!(l->env[j] >= 0.f && l->env[j] <= 1.f))
+					return 0;
+			}
+		}
+#endif
+
+	return 1;
+}
+
+#ifdef __cplusplus
+}
+
+namespace Brickworks {
+
+/*** Public C++ API ***/
+
+/*! api_cpp {{{
+ *    ##### Brickworks::VoiceBank
+ *  ```>>> */
+template<size_t N_VOICES>
+class VoiceBank {
+public:
+	VoiceBank();
+
+	VoiceBank(const VoiceBank &) = delete;
+	VoiceBank & operator=(const VoiceBank &) = delete;
+
+	void setSampleRate(
+		float sampleRate);
+
+	void reset();
+
+	void process(
+		float * BW_RESTRICT y,
+		size_t              nSamples);
+
+	void setQ(
+		float value);
+
+	void setAttack(
+		float value);
+
+	void setDecay(
+		float value);
+
+	void setSustain(
+		float value);
+
+	void setRelease(
+		float value);
+
+	void setVoiceFrequency(
+		size_t voice,
+		float  value);
+
+	void setVoiceCutoff(
+		size_t voice,
+		float  value);
+
+	void setVoiceGate(
+		size_t voice,
+		bool   value);
+
+	float getVoiceEnv(
+		size_t voice) const;
+
+	void setProfileStats(
+		bw_profile_stats * stats);
+/*! <<<...
+ *  }
+ *  ```
+ *
+ *    The memory holding per-voice data is part of the object, hence no
+ *    allocation ever takes place. For the same reason, objects cannot be
+ *    copied.
+ *  }}} */
+
+/*** Implementation ***/
+
+/* WARNING: This part of the file is not part of the public API. Its content may
+ * change at any time in future versions. Please, do not use it directly. */
+
+private:
+	bw_voice_bank_coeffs	coeffs;
+	bw_voice_bank_state	state;
+	alignas(32) bw_voice_bank_lanes	mem[BW_VOICE_BANK_N_LANES(N_VOICES)];
+};
+
+template<size_t N_VOICES>
+inline VoiceBank<N_VOICES>::VoiceBank() {
+	bw_voice_bank_init(&coeffs, N_VOICES);
+	bw_voice_bank_mem_set(&coeffs, &state, mem);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setSampleRate(
+		float sampleRate) {
+	bw_voice_bank_set_sample_rate(&coeffs, sampleRate);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::reset() {
+	bw_voice_bank_reset_coeffs(&coeffs);
+	bw_voice_bank_reset_state(&coeffs, &state);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::process(
+		float * BW_RESTRICT y,
+		size_t              nSamples) {
+	bw_voice_bank_process(&coeffs, &state, y, nSamples);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setQ(
+		float value) {
+	bw_voice_bank_set_Q(&coeffs, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setAttack(
+		float value) {
+	bw_voice_bank_set_attack(&coeffs, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setDecay(
+		float value) {
+	bw_voice_bank_set_decay(&coeffs, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setSustain(
+		float value) {
+	bw_voice_bank_set_sustain(&coeffs, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setRelease(
+		float value) {
+	bw_voice_bank_set_release(&coeffs, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setVoiceFrequency(
+		size_t voice,
+		float  value) {
+	bw_voice_bank_set_voice_frequency(&state, voice, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setVoiceCutoff(
+		size_t voice,
+		float  value) {
+	bw_voice_bank_set_voice_cutoff(&state, voice, value);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setVoiceGate(
+		size_t voice,
+		bool   value) {
+	bw_voice_bank_set_voice_gate(&state, voice, value);
+}
+
+template<size_t N_VOICES>
+inline float VoiceBank<N_VOICES>::getVoiceEnv(
+		size_t voice) const {
+	return bw_voice_bank_get_voice_env(&state, voice);
+}
+
+template<size_t N_VOICES>
+inline void VoiceBank<N_VOICES>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_voice_bank_set_profile_stats(&coeffs, stats);
+}
+
+}
+#endif
+
+#endif
@@ -20,7 +20,7 @@
 
 /*!
  *  module_type {{{ dsp }}}
- *  version {{{ 1.0.1 }}}
+ *  version {{{ 1.1.0 }}}
  *  requires {{{ bw_common bw_math bw_one_pole bw_svf }}}
  *  description {{{
  *    Wah effect.
@@ -29,8 +29,13 @@
  *  }}}
  *  changelog {{{
  *    <ul>
- *      <li>Version <strong>1.0.1</strong>:
+ *      <li>Version <strong>1.1.0</strong>:
  *        <ul>
+ *          <li>Added <code>bw_wah_set_profile_stats()</code> and support for
+ *              <code>BW_PROFILE</code>, and updated C++ API in this
+ *              regard.</li>
+ *          <li>Added <code>bw_wah_set_interp_period()</code> and
+ *              <code>setInterpPeriod()</code>.</li>
  *          <li>Now using <code>BW_NULL</code>.</li>
  *        </ul>
  *      </li>
@@ -227,6 +232,34 @@ static inline void bw_wah_set_wah(
  *
  *    Default value: `0.5f`.
  *
+ *    #### bw_wah_set_interp_period()
+ *  ```>>> */
+static inline void bw_wah_set_interp_period(
+	bw_wah_coeffs * BW_RESTRICT coeffs,
+	size_t                      value);
+/*! <<<```
+ *    Sets the coefficient interpolation period to the given `value` (samples)
+ *    in `coeffs`.
+ *
+ *    See `bw_svf_set_interp_period()` for details.
+ *
+ *    Valid range: [`1`, `SIZE_MAX`].
+ *
+ *    Default value: `1`.
+ *
+ *    #### bw_wah_set_profile_stats()
+ *  ```>>> */
+static inline void bw_wah_set_profile_stats(
+	bw_wah_coeffs * BW_RESTRICT coeffs,
+	bw_profile_stats *          stats);
+/*! <<<```
+ *    Sets the `stats` structure that `bw_wah_process()` and
+ *    `bw_wah_process_multi()` update when using `coeffs` if `BW_PROFILE` is
+ *    defined (see [bw_common](bw_common)). If `stats` is `BW_NULL`, no
+ *    profiling takes place.
+ *
+ *    Default value: `BW_NULL`.
+ *
  *    #### bw_wah_coeffs_is_valid()
  *  ```>>> */
 static inline char bw_wah_coeffs_is_valid(
@@ -286,6 +319,9 @@ struct bw_wah_coeffs {
 	enum bw_wah_coeffs_state	state;
 	uint32_t			reset_id;
 #endif
+#ifdef BW_PROFILE
+	bw_profile_stats *		profile_stats;
+#endif
 
 	// Sub-components
 	bw_svf_coeffs			svf_coeffs;
@@ -309,6 +345,9 @@ static inline void bw_wah_init(
 	bw_svf_set_cutoff(&coeffs->svf_coeffs, 600.f);
 	bw_svf_set_Q(&coeffs->svf_coeffs, 9.f);
 
+#ifdef BW_PROFILE
+	coeffs->profile_stats = BW_NULL;
+#endif
 #ifdef BW_DEBUG_DEEP
 	coeffs->hash = bw_hash_sdbm("bw_wah_coeffs");
 	coeffs->state = bw_wah_coeffs_state_init;
@@ -466,11 +505,13 @@ static inline void bw_wah_process(
 	BW_ASSERT_DEEP(bw_has_only_finite(x, n_samples));
 	BW_ASSERT(y != BW_NULL);
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_wah_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_wah_update_coeffs_audio(coeffs);
 		y[i] = bw_wah_process1(coeffs, state, x[i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_samples);
 
 	BW_ASSERT_DEEP(bw_wah_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_reset_coeffs);
@@ -502,12 +543,14 @@ static inline void bw_wah_process_multi(
 			BW_ASSERT(y[i] != y[j]);
 #endif
 
+	BW_PROFILE_BEGIN(coeffs->profile_stats);
 	bw_wah_update_coeffs_ctrl(coeffs);
 	for (size_t i = 0; i < n_samples; i++) {
 		bw_wah_update_coeffs_audio(coeffs);
 		for (size_t j = 0; j < n_channels; j++)
 			y[j][i] = bw_wah_process1(coeffs, state[j], x[j][i]);
 	}
+	BW_PROFILE_END(coeffs->profile_stats, n_channels * n_samples);
 
 	BW_ASSERT_DEEP(bw_wah_coeffs_is_valid(coeffs));
 	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_reset_coeffs);
@@ -528,6 +571,38 @@ static inline void bw_wah_set_wah(
 	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_init);
 }
 
+static inline void bw_wah_set_interp_period(
+		bw_wah_coeffs * BW_RESTRICT coeffs,
+		size_t                      value) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_wah_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_init);
+	BW_ASSERT(value >= 1);
+
+	bw_svf_set_interp_period(&coeffs->svf_coeffs, value);
+
+	BW_ASSERT_DEEP(bw_wah_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_init);
+}
+
+static inline void bw_wah_set_profile_stats(
+		bw_wah_coeffs * BW_RESTRICT coeffs,
+		bw_profile_stats *          stats) {
+	BW_ASSERT(coeffs != BW_NULL);
+	BW_ASSERT_DEEP(bw_wah_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_init);
+
+#ifdef BW_PROFILE
+	coeffs->profile_stats = stats;
+#else
+	(void)coeffs;
+	(void)stats;
+#endif
+
+	BW_ASSERT_DEEP(bw_wah_coeffs_is_valid(coeffs));
+	BW_ASSERT_DEEP(coeffs->state >= bw_wah_coeffs_state_init);
+}
+
 static inline char bw_wah_coeffs_is_valid(
 		const bw_wah_coeffs * BW_RESTRICT coeffs) {
 	BW_ASSERT(coeffs != BW_NULL);
@@ -606,6 +681,12 @@ public:
 
 	void setWah(
 		float value);
+
+	void setInterpPeriod(
+		size_t value);
+
+	void setProfileStats(
+		bw_profile_stats * stats);
 /*! <<<...
  *  }
  *  ```
@@ -692,6 +773,18 @@ inline void Wah<N_CHANNELS>::setWah(
 	bw_wah_set_wah(&coeffs, value);
 }
 
+template<size_t N_CHANNELS>
+inline void Wah<N_CHANNELS>::setInterpPeriod(
+		size_t value) {
+	bw_wah_set_interp_period(&coeffs, value);
+}
+
+template<size_t N_CHANNELS>
+inline void Wah<N_CHANNELS>::setProfileStats(
+		bw_profile_stats * stats) {
+	bw_wah_set_profile_stats(&coeffs, stats);
+}
+
 }
 #endif
 
@@ -0,0 +1,130 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <bw_delay.h>
+#include <bw_comb.h>
+#include <bw_chorus.h>
+#include <bw_reverb.h>
+#include <bw_ensemble.h>
+
+#include <vector>
+
+using namespace Brickworks;
+
+int n_ok = 0;
+int n_ko = 0;
+
+#define TEST(expr) \
+{ \
+	if (expr) { \
+		printf("✔ %s\n", #expr); \
+		n_ok++; \
+	} else { \
+		printf("✘ %s - line %d\n", #expr, __LINE__); \
+		n_ko++; \
+	} \
+}
+
+#define N_SAMPLES	4096
+
+static float x[N_SAMPLES];
+static float y_a[N_SAMPLES];
+static float y_b[N_SAMPLES];
+
+static void setup(Delay<1> &d) {
+	d.setDelay(0.01f);
+}
+
+static void setup(Comb<1> &c) {
+	c.setDelayFF(0.01f);
+	c.setDelayFB(0.005f);
+	c.setCoeffFB(0.5f);
+}
+
+template<class T>
+static void setup(T &) {
+}
+
+static void process(Reverb<1> &r, float *y) {
+	const float *xp[1] = { x };
+	float *yLp[1] = { y };
+	float yR[N_SAMPLES];
+	float *yRp[1] = { yR };
+	r.process(xp, xp, yLp, yRp, N_SAMPLES);
+}
+
+template<class T>
+static void process(T &o, float *y) {
+	const float *xp[1] = { x };
+	float *yp[1] = { y };
+	o.process(xp, yp, N_SAMPLES);
+}
+
+static char same_output(void) {
+	for (size_t i = 0; i < N_SAMPLES; i++)
+		if (y_a[i] != y_b[i])
+			return 0;
+	return 1;
+}
+
+// a and b process the same input and must give the same output, whatever
+// memory b is given
+template<class T>
+static void test_memory(const char *name) {
+	printf("\n%s\n\n", name);
+
+	T *a = new T();
+	T *b = new T();
+	setup(*a);
+	setup(*b);
+	TEST(a->setSampleRate(48000.f));
+	TEST(b->setSampleRate(48000.f));
+
+	// memory too small: b keeps using its owned block
+	static char small[16];
+	b->setMemory(small, sizeof(small));
+	TEST(!b->setSampleRate(48000.f));
+	a->reset();
+	b->reset();
+	process(*a, y_a);
+	process(*b, y_b);
+	TEST(same_output());
+
+	// memory large enough, only used after setSampleRate()
+	std::vector<char> mem(b->getMemReq(96000.f));
+	b->setMemory(mem.data(), mem.size());
+	a->reset();
+	b->reset();
+	process(*a, y_a);
+	process(*b, y_b);
+	TEST(same_output());
+
+	TEST(a->setSampleRate(96000.f));
+	TEST(b->setSampleRate(96000.f));
+	a->reset();
+	b->reset();
+	process(*a, y_a);
+	process(*b, y_b);
+	TEST(same_output());
+
+	delete a;
+	delete b;
+}
+
+int main() {
+	printf("\nC++ API memory unit tests\n");
+	printf("-------------------------\n");
+
+	for (size_t i = 0; i < N_SAMPLES; i++)
+		x[i] = (float)rand() / (float)RAND_MAX - 0.5f;
+
+	test_memory<Delay<1>>("Delay");
+	test_memory<Comb<1>>("Comb");
+	test_memory<Chorus<1>>("Chorus");
+	test_memory<Reverb<1>>("Reverb");
+	test_memory<Ensemble<1>>("Ensemble");
+
+	printf("\nsuceeded: %d, failed: %d\n\n", n_ok, n_ko);
+
+	return n_ko ? EXIT_FAILURE : EXIT_SUCCESS;
+}
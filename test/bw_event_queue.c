@@ -0,0 +1,126 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <bw_event_queue.h>
+
+int n_ok = 0;
+int n_ko = 0;
+
+#define TEST(expr, expected) \
+{ \
+	const size_t v_expr = expr; \
+	const size_t v_expected = expected; \
+	if (v_expr == v_expected) { \
+		printf("✔ %s = %zu\n", #expr, v_expected); \
+		n_ok++; \
+	} else { \
+		printf("✘ %s = %zu (expected %zu) - line %d\n", #expr, v_expr, v_expected, __LINE__); \
+		n_ko++; \
+	} \
+}
+
+// expected: {offset, n_samples, n_events} for each slice
+static void test_slices(
+		const bw_event_queue * queue,
+		size_t                 n_samples,
+		size_t                 min_slice,
+		const size_t           expected[][3],
+		size_t                 n_expected,
+		int                    line) {
+	bw_event_queue_slice s;
+	bw_event_queue_slice_reset(&s);
+	size_t n = 0;
+	char ok = 1;
+	while (bw_event_queue_next_slice(queue, n_samples, min_slice, &s)) {
+		if (n >= n_expected || s.offset != expected[n][0] || s.n_samples != expected[n][1] || s.n_events != expected[n][2]) {
+			printf("✘ slice %zu (n_samples %zu, min_slice %zu) = {%zu, %zu, %zu} - line %d\n", n, n_samples, min_slice, s.offset, s.n_samples, s.n_events, line);
+			ok = 0;
+		}
+		n++;
+	}
+	if (n != n_expected) {
+		printf("✘ %zu slices (n_samples %zu, min_slice %zu), expected %zu - line %d\n", n, n_samples, min_slice, n_expected, line);
+		ok = 0;
+	}
+	if (ok) {
+		printf("✔ %zu slices (n_samples %zu, min_slice %zu) as expected - line %d\n", n, n_samples, min_slice, line);
+		n_ok++;
+	} else
+		n_ko++;
+}
+
+#define TEST_SLICES(queue, n_samples, min_slice, expected, n_expected) \
+	test_slices(queue, n_samples, min_slice, expected, n_expected, __LINE__)
+
+int main() {
+	printf("\nbw_event_queue unit tests\n");
+	printf("-------------------------\n\n");
+
+	bw_event_queue q;
+	bw_event_queue_reset(&q);
+	TEST(q.n_events, 0);
+
+	// sorting
+	bw_event_queue_add(&q, 20, bw_event_queue_type_note_on, 60, 1.f);
+	bw_event_queue_add(&q, 10, bw_event_queue_type_note_on, 61, 1.f);
+	bw_event_queue_add(&q, 20, bw_event_queue_type_note_off, 60, 0.f);
+	TEST(q.n_events, 3);
+	TEST(q.events[0].offset, 10);
+	TEST(q.events[1].offset, 20);
+	TEST(q.events[1].type, bw_event_queue_type_note_on);
+	TEST(q.events[2].offset, 20);
+	TEST(q.events[2].type, bw_event_queue_type_note_off);
+
+	// empty queue
+	bw_event_queue_clear(&q);
+	{
+		const size_t e[][3] = { { 0, 256, 0 } };
+		TEST_SLICES(&q, 256, 16, e, 1);
+	}
+
+	// isolated event not on a multiple of min_slice
+	bw_event_queue_add(&q, 100, bw_event_queue_type_note_on, 60, 1.f);
+	{
+		const size_t e[][3] = { { 0, 100, 0 }, { 100, 156, 1 } };
+		TEST_SLICES(&q, 256, 16, e, 2);
+	}
+	{
+		const size_t e[][3] = { { 0, 100, 0 }, { 100, 156, 1 } };
+		TEST_SLICES(&q, 256, 1, e, 2);
+	}
+
+	// events closer than min_slice are merged, farther ones are not
+	bw_event_queue_add(&q, 115, bw_event_queue_type_parameter, 0, 0.5f);
+	bw_event_queue_add(&q, 131, bw_event_queue_type_parameter, 0, 0.25f);
+	{
+		const size_t e[][3] = { { 0, 100, 0 }, { 100, 31, 2 }, { 131, 125, 1 } };
+		TEST_SLICES(&q, 256, 16, e, 3);
+	}
+	{
+		const size_t e[][3] = { { 0, 100, 0 }, { 100, 15, 1 }, { 115, 16, 1 }, { 131, 125, 1 } };
+		TEST_SLICES(&q, 256, 1, e, 4);
+	}
+
+	// events at the beginning of the block and past its end
+	bw_event_queue_clear(&q);
+	bw_event_queue_add(&q, 5, bw_event_queue_type_note_on, 60, 1.f);
+	bw_event_queue_add(&q, 300, bw_event_queue_type_note_off, 60, 0.f);
+	{
+		const size_t e[][3] = { { 0, 255, 1 }, { 255, 1, 1 } };
+		TEST_SLICES(&q, 256, 16, e, 2);
+	}
+	{
+		const size_t e[][3] = { { 0, 5, 0 }, { 5, 250, 1 }, { 255, 1, 1 } };
+		TEST_SLICES(&q, 256, 1, e, 3);
+	}
+
+	// empty block
+	{
+		const size_t e[][3] = { { 0, 0, 2 } };
+		TEST_SLICES(&q, 0, 16, e, 1);
+	}
+
+	printf("\nsuceeded: %d, failed: %d\n\n", n_ok, n_ko);
+
+	return n_ko ? EXIT_FAILURE : EXIT_SUCCESS;
+}
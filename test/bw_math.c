@@ -68,6 +68,27 @@ int n_ko = 0;
 	} \
 }
 
+#define TEST_BUF(func, func_buf, src, n) \
+{ \
+	float dest[n]; \
+	func_buf(src, dest, n); \
+	size_t i; \
+	for (i = 0; i < n; i++) { \
+		union { float f; uint32_t u; } v_res, v_expected; \
+		v_res.f = dest[i]; \
+		v_expected.f = func(src[i]); \
+		if (v_res.u != v_expected.u) { \
+			printf("✘ %s(%g) = %g [0x%x] (expected %g [0x%x]) - line %d\n", #func_buf, src[i], v_res.f, v_res.u, v_expected.f, v_expected.u, __LINE__); \
+			n_ko++; \
+			break; \
+		} \
+	} \
+	if (i == n) { \
+		printf("✔ %s() = %s() on %d values\n", #func_buf, #func, (int)n); \
+		n_ok++; \
+	} \
+}
+
 int main() {
 	printf("\nbw_math unit tests\n");
 	printf("------------------\n\n");
@@ -1270,6 +1291,43 @@ int main() {
 	TEST_ABS_REL(bw_acoshf(1e30f), acoshf(1e30f), 0.004f, 0.008f);
 	TEST_ABS_REL(bw_acoshf(1e37f), acoshf(1e37f), 0.004f, 0.008f);
 
+	float buf_any[1024], buf_trig[1024], buf_tan2pi[1024], buf_tan[1024], buf_log[1024], buf_pow2[1024], buf_exp[1024], buf_pow10[1024], buf_dB[1024], buf_tanh[1024];
+	for (int i = 0; i < 1024; i++) {
+		const float r = (float)i / 1023.f;
+		buf_any[i] = 1e-6f + 1e3f * r * r;
+		buf_any[i] = i & 1 ? -buf_any[i] : buf_any[i];
+		buf_trig[i] = i < 16 ? 0.125f * (float)(i - 8) : (i & 1 ? -1.f : 1.f) * (i & 2 ? 8388608.f * r : 100.f * r * r);
+		buf_tan2pi[i] = 0.49f * r - 0.245f + (float)((i % 7) - 3) * 0.5f;
+		buf_tan[i] = 3.1f * r - 1.55f + (float)((i % 7) - 3) * 3.141592653589793f;
+		buf_log[i] = 1.175494350822287e-38f * bw_pow2f(125.f * r) * bw_pow2f(125.f * r);
+		buf_pow2[i] = i < 16 ? -126.f - 0.25f * (float)(i - 8) : 380.f * r - 253.f;
+		buf_exp[i] = 195.f * r - 107.f;
+		buf_pow10[i] = 100.f * r - 61.5f;
+		buf_dB[i] = 1990.f * r - 1220.f;
+		buf_tanh[i] = i < 16 ? 2.115287308554551f + 1e-6f * (float)(i - 8) : 20.f * r - 10.f;
+	}
+	buf_trig[16] = -0.f;
+	buf_any[0] = 1.237940039e27f;
+	buf_any[1] = -8.077935669e-28f;
+	buf_tanh[16] = -2.115287308554551f;
+
+	TEST_BUF(bw_rcpf, bw_rcpf_buf, buf_any, 1024);
+	TEST_BUF(bw_sin2pif, bw_sin2pif_buf, buf_trig, 1024);
+	TEST_BUF(bw_sinf, bw_sinf_buf, buf_trig, 1024);
+	TEST_BUF(bw_cos2pif, bw_cos2pif_buf, buf_trig, 1024);
+	TEST_BUF(bw_cosf, bw_cosf_buf, buf_trig, 1024);
+	TEST_BUF(bw_tan2pif, bw_tan2pif_buf, buf_tan2pi, 1024);
+	TEST_BUF(bw_tanf, bw_tanf_buf, buf_tan, 1024);
+	TEST_BUF(bw_log2f, bw_log2f_buf, buf_log, 1024);
+	TEST_BUF(bw_logf, bw_logf_buf, buf_log, 1024);
+	TEST_BUF(bw_log10f, bw_log10f_buf, buf_log, 1024);
+	TEST_BUF(bw_pow2f, bw_pow2f_buf, buf_pow2, 1024);
+	TEST_BUF(bw_expf, bw_expf_buf, buf_exp, 1024);
+	TEST_BUF(bw_pow10f, bw_pow10f_buf, buf_pow10, 1024);
+	TEST_BUF(bw_dB2linf, bw_dB2linf_buf, buf_dB, 1024);
+	TEST_BUF(bw_lin2dBf, bw_lin2dBf_buf, buf_log, 1024);
+	TEST_BUF(bw_tanhf, bw_tanhf_buf, buf_tanh, 1024);
+
 	printf("\nsuceeded: %d, failed: %d\n\n", n_ok, n_ko);
 	
 	return n_ko ? EXIT_FAILURE : EXIT_SUCCESS;
@@ -0,0 +1,162 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+// more than 64 voices, so that multiple words are used
+#define BW_VOICE_ALLOC_MAX_VOICES	100
+
+#include <bw_voice_alloc.h>
+
+int n_ok = 0;
+int n_ko = 0;
+
+#define N_BLOCKS	2000
+#define MAX_CALLS	1024
+
+// log of callback invocations, shared by all voices of one allocator
+typedef struct {
+	size_t		voice[MAX_CALLS];
+	unsigned char	note[MAX_CALLS];	// 128 = note off
+	size_t		n;
+} call_log;
+
+typedef struct {
+	size_t		index;
+	call_log *	log;
+	unsigned char	note;
+	char		gate;
+	char		free;
+} voice;
+
+static void log_call(voice *v, unsigned char note) {
+	if (v->log->n < MAX_CALLS) {
+		v->log->voice[v->log->n] = v->index;
+		v->log->note[v->log->n] = note;
+	}
+	v->log->n++;
+}
+
+static void note_on(void *voice_, unsigned char note, float velocity) {
+	(void)velocity;
+	voice *v = (voice *)voice_;
+	v->note = note;
+	v->gate = 1;
+	v->free = 0;
+	log_call(v, note);
+}
+
+static void note_off(void *voice_, float velocity) {
+	(void)velocity;
+	voice *v = (voice *)voice_;
+	v->gate = 0;
+	log_call(v, 128);
+}
+
+static unsigned char get_note(const void *voice_) {
+	return ((const voice *)voice_)->note;
+}
+
+static char is_free(const void *voice_) {
+	return ((const voice *)voice_)->free;
+}
+
+static char same_logs(const call_log *a, const call_log *b) {
+	if (a->n != b->n)
+		return 0;
+	for (size_t i = 0; i < a->n && i < MAX_CALLS; i++)
+		if (a->voice[i] != b->voice[i] || a->note[i] != b->note[i])
+			return 0;
+	return 1;
+}
+
+// random note on/off sequence fed to both bw_voice_alloc(), with voice status
+// taken from the voices, and bw_voice_alloc_process(), with voice status kept
+// in its state: they must call the same callbacks on the same voices
+static void test_random(size_t n_voices, bw_voice_alloc_priority priority, unsigned int seed) {
+	static voice voices_a[BW_VOICE_ALLOC_MAX_VOICES];
+	static voice voices_b[BW_VOICE_ALLOC_MAX_VOICES];
+	static void *pv_a[BW_VOICE_ALLOC_MAX_VOICES];
+	static void *pv_b[BW_VOICE_ALLOC_MAX_VOICES];
+	static size_t active_a[BW_VOICE_ALLOC_MAX_VOICES];
+	static size_t active_b[BW_VOICE_ALLOC_MAX_VOICES];
+	call_log log_a, log_b;
+
+	for (size_t i = 0; i < n_voices; i++) {
+		voices_a[i] = (voice){ .index = i, .log = &log_a, .note = 0, .gate = 0, .free = 1 };
+		voices_b[i] = (voice){ .index = i, .log = &log_b, .note = 0, .gate = 0, .free = 1 };
+		pv_a[i] = voices_a + i;
+		pv_b[i] = voices_b + i;
+	}
+
+	const bw_voice_alloc_opts opts = { priority, note_on, note_off, get_note, is_free };
+	bw_voice_alloc_state state;
+	bw_voice_alloc_reset_state(&state, n_voices);
+	bw_note_queue queue;
+	bw_note_queue_reset(&queue);
+	srand(seed);
+
+	size_t block = 0;
+	for (; block < N_BLOCKS; block++) {
+		// a few events per block, on a narrow note range with few voices so
+		// that voices get stolen often, on the full range otherwise so that
+		// many voices get busy
+		bw_note_queue_clear(&queue);
+		const int n_events = rand() % 8;
+		for (int i = 0; i < n_events; i++) {
+			const unsigned char note = (unsigned char)(n_voices <= 16 ? 48 + rand() % 24 : rand() % 128);
+			bw_note_queue_add(&queue, note, rand() % 3 != 0, (float)(rand() % 128) / 127.f, rand() % 8 == 0);
+		}
+
+		log_a.n = 0;
+		log_b.n = 0;
+		bw_voice_alloc(&opts, &queue, pv_a, n_voices);
+		bw_voice_alloc_process(&opts, &state, &queue, pv_b);
+		if (log_a.n > MAX_CALLS || !same_logs(&log_a, &log_b))
+			break;
+
+		// released voices become free at random times, as if their
+		// envelopes were done
+		size_t i = 0;
+		for (; i < n_voices; i++) {
+			if (!voices_a[i].gate && rand() % 4 == 0) {
+				voices_a[i].free = 1;
+				bw_voice_alloc_set_voice_free(&state, i);
+			}
+			if (voices_a[i].free != bw_voice_alloc_is_voice_free(&state, i)
+			    || (!voices_a[i].free && voices_a[i].note != bw_voice_alloc_get_voice_note(&state, i)))
+				break;
+		}
+		if (i != n_voices || !bw_voice_alloc_state_is_valid(&state))
+			break;
+
+		const size_t n_active = bw_voice_alloc_get_active(&opts, pv_a, n_voices, active_a);
+		if (n_active != bw_voice_alloc_get_active_voices(&state, active_b))
+			break;
+		for (i = 0; i < n_active && active_a[i] == active_b[i]; i++) ;
+		if (i != n_active)
+			break;
+	}
+
+	if (block == N_BLOCKS) {
+		printf("✔ %zu voices, %s priority, seed %u\n", n_voices, priority == bw_voice_alloc_priority_low ? "low" : "high", seed);
+		n_ok++;
+	} else {
+		printf("✘ %zu voices, %s priority, seed %u - mismatch at block %zu\n", n_voices, priority == bw_voice_alloc_priority_low ? "low" : "high", seed, block);
+		n_ko++;
+	}
+}
+
+int main() {
+	printf("\nbw_voice_alloc unit tests\n");
+	printf("-------------------------\n\n");
+
+	const size_t n_voices[] = { 1, 2, 3, 8, 16, 64, 65, 100 };
+	for (size_t i = 0; i < sizeof(n_voices) / sizeof(n_voices[0]); i++)
+		for (unsigned int seed = 1; seed <= 4; seed++) {
+			test_random(n_voices[i], bw_voice_alloc_priority_low, seed);
+			test_random(n_voices[i], bw_voice_alloc_priority_high, seed);
+		}
+
+	printf("\nsuceeded: %d, failed: %d\n\n", n_ok, n_ko);
+
+	return n_ko ? EXIT_FAILURE : EXIT_SUCCESS;
+}